@@ -0,0 +1,179 @@
+/**
+ * @file batch_runner.cpp
+ * @brief Batch driver: many independent leagues sharded across pinned worker threads.
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "batch_runner.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory_resource>
+#include <string>
+#include <thread>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+#include "buffered_writer.h"
+#include "instrumentation.h"
+#include "league_scheduler_2.h"
+#include "schedule_exporter.h"
+
+namespace LeagueSchedulerNS {
+
+namespace {
+
+// Pins the calling thread to `cpu`. Returns false where unsupported or refused.
+bool pinCurrentThread(unsigned cpu) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+} // namespace
+
+BatchResult BatchRunner::run(const std::vector<LeagueDefinition>& leagues) const {
+    const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    unsigned workers = options_.workers == 0 ? cores : options_.workers;
+    workers = static_cast<unsigned>(std::max<std::size_t>(1, std::min<std::size_t>(workers, leagues.size())));
+
+    BatchResult result;
+    result.shards.resize(workers);
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    threads.reserve(workers);
+    for (unsigned w = 0; w < workers; ++w) {
+        BatchShardResult& shard = result.shards[w];
+        shard.worker = w;
+        shard.path = options_.output_prefix + "." + std::to_string(w) + ".jsonl";
+        threads.emplace_back([&, w, cores] {
+            if (options_.pin_workers && pinCurrentThread(w % cores)) {
+                result.shards[w].cpu = static_cast<int>(w % cores);
+            }
+            runShard(leagues, workers, result.shards[w]);
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (const BatchShardResult& shard : result.shards) {
+        result.leagues += shard.leagues;
+        result.games += shard.games;
+        result.ok = result.ok && shard.ok;
+    }
+    return result;
+}
+
+void BatchRunner::runShard(const std::vector<LeagueDefinition>& leagues, unsigned workers,
+                           BatchShardResult& shard) const {
+    APMW_TRACE_SCOPE("batch.shard");
+    const auto start = std::chrono::steady_clock::now();
+    BufferedWriter out;
+    if (!out.open(shard.path)) {
+        const std::size_t dropped =
+            shard.worker < leagues.size() ? (leagues.size() - shard.worker + workers - 1) / workers : 0;
+        // One write, so shards failing at once do not interleave their messages.
+        std::cerr << ("Error: failed to write batch shard " + shard.path + " (cannot open it; its " +
+                      std::to_string(dropped) + " league(s) are left out of the totals)\n")
+                  << std::flush;
+        shard.ok = false;
+        return;
+    }
+
+    SeasonEngineConfig engine = options_.engine;
+    engine.restart_threads = 1;
+    LeagueScheduler2 scheduler(engine, options_.seed);
+    scheduler.setReportProgress(false);
+    std::pmr::monotonic_buffer_resource arena;
+
+    for (std::size_t i = shard.worker; i < leagues.size(); i += workers) {
+        APMW_TRACE_SCOPE("batch.league");
+        const auto league_start = std::chrono::steady_clock::now();
+        const LeagueDefinition& league = leagues[i];
+        const std::uint64_t seed = league.has_seed ? league.seed : options_.seed + i;
+        const TeamRegistry teams = buildRegistry(league);
+        scheduler.setSeed(seed);
+
+        std::size_t games = 0;
+        std::size_t blocks = 0;
+        {
+            const SeasonSchedule season = scheduler.generateSeasonSchedule(teams, league.games_per_team, &arena);
+            blocks = season.size();
+            for (const ResidencyBlock& block : season) {
+                games += block.games.size();
+            }
+        }
+        arena.release();
+
+        const SeasonPlan& plan = scheduler.lastPlan();
+        int min_games = 0;
+        int max_games = 0;
+        if (!plan.games_per_team.empty()) {
+            const auto range = std::minmax_element(plan.games_per_team.begin(), plan.games_per_team.end());
+            min_games = *range.first;
+            max_games = *range.second;
+        }
+        const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - league_start).count();
+
+        out.write("{\"league\":");
+        out.writeInt(i);
+        out.write(",\"name\":");
+        out.write(jsonString(league.name));
+        out.write(",\"seed\":");
+        out.writeInt(seed);
+        out.write(",\"teams\":");
+        out.writeInt(teams.size());
+        out.write(",\"blocks\":");
+        out.writeInt(blocks);
+        out.write(",\"games\":");
+        out.writeInt(games);
+        out.write(",\"rounds\":");
+        out.writeInt(plan.rounds);
+        out.write(",\"min_games\":");
+        out.writeInt(min_games);
+        out.write(",\"max_games\":");
+        out.writeInt(max_games);
+        out.write(",\"plan_cost\":");
+        out.writeInt(static_cast<long long>(plan.cost));
+        out.write(",\"us\":");
+        out.writeInt(static_cast<long long>(micros));
+        out.write("}\n");
+
+        ++shard.leagues;
+        shard.games += games;
+    }
+
+    if (!out.close()) {
+        std::cerr << "Error: failed to write batch shard " << shard.path << std::endl;
+        shard.ok = false;
+    }
+    shard.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace LeagueSchedulerNS
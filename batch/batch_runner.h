@@ -0,0 +1,70 @@
+#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../league/league_definition.h"
+#include "../scheduling/season_engine.h"
+
+namespace LeagueSchedulerNS {
+
+struct BatchOptions {
+    unsigned workers = 0;                // 0 = one per hardware thread
+    bool pin_workers = true;             // Pin worker w to CPU w mod cores (Linux; ignored elsewhere)
+    std::string output_prefix = "batch"; // Worker w writes <prefix>.<w>.jsonl
+    std::uint64_t seed = 0x41504D57u;    // Leagues without their own seed get seed + league index
+    SeasonEngineConfig engine;           // Per-league engine settings; restarts run on the worker's own thread
+};
+
+struct BatchShardResult {
+    unsigned worker = 0;
+    int cpu = -1;                        // CPU the worker was pinned to, or -1
+    std::string path;
+    std::size_t leagues = 0;
+    std::size_t games = 0;
+    double seconds = 0.0;
+    bool ok = true;                      // false if the shard file could not be written
+};
+
+struct BatchResult {
+    std::vector<BatchShardResult> shards;
+    std::size_t leagues = 0;
+    std::size_t games = 0;
+    double seconds = 0.0;                // Wall time for the whole batch
+    bool ok = true;
+
+    double leaguesPerSecond() const { return seconds > 0.0 ? static_cast<double>(leagues) / seconds : 0.0; }
+};
+
+// Schedules many independent leagues across a fixed set of worker threads.
+//
+// League i goes to worker i mod workers (a static split, so the shards and
+// their files are the same on every run). Each worker owns everything it
+// touches: its LeagueScheduler2, a monotonic arena that holds the current
+// season and is released between leagues, and its own shard file, so the hot
+// path shares no mutable state and takes no locks. Engine restarts run on the
+// worker's thread instead of spawning more.
+//
+// Every shard file is JSON lines, one summary per league in input order:
+//   {"league":3,"name":"APMW-3","seed":42,"teams":18,"blocks":90,"games":990,
+//    "rounds":15,"min_games":110,"max_games":110,"plan_cost":0,"us":5123}
+class BatchRunner {
+public:
+    explicit BatchRunner(const BatchOptions& options = BatchOptions()) : options_(options) {}
+
+    const BatchOptions& options() const { return options_; }
+
+    // Reports failures (unwritable shard files) to std::cerr and in the result.
+    BatchResult run(const std::vector<LeagueDefinition>& leagues) const;
+
+private:
+    void runShard(const std::vector<LeagueDefinition>& leagues, unsigned workers, BatchShardResult& shard) const;
+
+    BatchOptions options_;
+};
+
+} // namespace LeagueSchedulerNS
+
+#endif // BATCH_RUNNER_H
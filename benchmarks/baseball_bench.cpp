@@ -0,0 +1,325 @@
+/**
+ * @file baseball_bench.cpp
+ * @brief Scheduling hot-path benchmark: ns, allocations and peak RSS per game across league sizes.
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory_resource>
+#include <new>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include "game_data.h"
+#include "league_scheduler_2.h"
+#include "schedule_index.h"
+#include "season_engine.h"
+#include "team_registry.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+using namespace LeagueSchedulerNS;
+
+// Heap accounting for this process. The season engine allocates on worker
+// threads, so the counters are atomic.
+static std::atomic<std::size_t> g_alloc_bytes{0};
+static std::atomic<std::size_t> g_alloc_count{0};
+
+void* operator new(std::size_t size) {
+    g_alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+    g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+// Over-aligned requests (std::pmr's new_delete_resource uses these).
+void* operator new(std::size_t size, std::align_val_t align) {
+    g_alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+    g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+    const std::size_t alignment = static_cast<std::size_t>(align);
+    if (void* p = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+namespace {
+
+// Peak resident set size. On Linux the high-water mark is reset before each
+// case (clear_refs "5"), so every case reports its own peak; elsewhere the
+// value is the process-wide peak so far.
+void resetPeakRss() {
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    if (clear_refs) {
+        clear_refs << "5";
+    }
+}
+
+long peakRssKb() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) {
+            return std::strtol(line.c_str() + 6, nullptr, 10);
+        }
+    }
+#if defined(__unix__) || defined(__APPLE__)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(__APPLE__)
+        return static_cast<long>(usage.ru_maxrss / 1024); // bytes on macOS
+#else
+        return static_cast<long>(usage.ru_maxrss);
+#endif
+    }
+#endif
+    return 0;
+}
+
+// Swallows the scheduler's progress and quota lines while a case runs.
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+struct Result {
+    std::size_t teams = 0;
+    int roster = 0;
+    std::string phase;
+    std::size_t games = 0;
+    double ns_per_game = 0.0;
+    double allocs_per_game = 0.0;
+    double bytes_per_game = 0.0;
+    long peak_rss_kb = 0;
+};
+
+// Counts games without keeping anything: the pure cost of producing blocks.
+class CountingSink : public ScheduleSink {
+public:
+    void onBlock(ResidencyBlock&& block) override { games += block.games.size(); }
+    std::size_t games = 0;
+};
+
+TeamRegistry buildLeague(std::size_t team_count, int roster) {
+    TeamRegistry teams;
+    teams.reserve(team_count);
+    int player_id = 1;
+    for (std::size_t i = 0; i < team_count; ++i) {
+        const TeamId id = teams.emplace(static_cast<int>(i + 1), "City_" + std::to_string(i), "Theme",
+                                        i % 2 == 0 ? UnionType::ATLANTIC : UnionType::PACIFIC, RegionType::UNKNOWN);
+        for (int p = 0; p < roster; ++p) {
+            const int player = player_id++;
+            teams[id].players.emplace_back(player, "Player_" + std::to_string(player), 60.0 + p % 35,
+                                           1000000 + p * 10000, 2000000, p == 0);
+        }
+    }
+    return teams;
+}
+
+// Runs `fn` (which returns the number of games it produced) `reps` times.
+template <typename Fn>
+Result measure(const std::string& phase, std::size_t teams, int roster, int reps, Fn fn) {
+    Result r;
+    r.teams = teams;
+    r.roster = roster;
+    r.phase = phase;
+    resetPeakRss();
+    const std::size_t bytes_before = g_alloc_bytes.load();
+    const std::size_t count_before = g_alloc_count.load();
+    const auto start = std::chrono::steady_clock::now();
+    std::size_t games = 0;
+    for (int i = 0; i < reps; ++i) {
+        games += fn();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    r.peak_rss_kb = peakRssKb();
+    const double total_games = games > 0 ? static_cast<double>(games) : 1.0;
+    r.games = games / static_cast<std::size_t>(reps);
+    r.ns_per_game = std::chrono::duration<double, std::nano>(elapsed).count() / total_games;
+    r.allocs_per_game = static_cast<double>(g_alloc_count.load() - count_before) / total_games;
+    r.bytes_per_game = static_cast<double>(g_alloc_bytes.load() - bytes_before) / total_games;
+    return r;
+}
+
+std::vector<long> parseList(const char* text) {
+    std::vector<long> values;
+    std::stringstream in(text);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        values.push_back(std::strtol(item.c_str(), nullptr, 10));
+    }
+    return values;
+}
+
+void writeJson(const std::string& path, const std::vector<Result>& results) {
+    std::FILE* out = path == "-" ? stdout : std::fopen(path.c_str(), "w");
+    if (out == nullptr) {
+        std::cerr << "Error: cannot create " << path << std::endl;
+        return;
+    }
+    std::fprintf(out, "[\n");
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::fprintf(out,
+                     "  {\"bench\":\"baseball_bench\",\"phase\":\"%s\",\"teams\":%zu,\"roster\":%d,\"games\":%zu,"
+                     "\"ns_per_game\":%.2f,\"allocs_per_game\":%.4f,\"bytes_per_game\":%.1f,\"peak_rss_kb\":%ld}%s\n",
+                     r.phase.c_str(), r.teams, r.roster, r.games, r.ns_per_game, r.allocs_per_game, r.bytes_per_game,
+                     r.peak_rss_kb, i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(out, "]\n");
+    if (out != stdout) {
+        std::fclose(out);
+    }
+}
+
+} // namespace
+
+// Usage: baseball_bench [--teams 18,100,1000,10000] [--rosters 4,26,60] [--json PATH]
+//                       [--max-iterations N]
+//
+// Phases per (teams, roster) case:
+//   engine_plan      SeasonEngine::plan only (the constraint search)
+//   stream_season    LeagueScheduler2::streamSeasonSchedule into a counting sink
+//                    (plan + block/crossroads game materialization, nothing kept)
+//   generate_vector  LeagueScheduler2::generateSeasonSchedule (the full vector)
+//   generate_arena   the same, built into one std::pmr::monotonic_buffer_resource
+//   build_index      ScheduleIndex over an already generated season
+// Block materialization cost is stream_season minus engine_plan.
+//
+// The engine's annealing budget grows with league size; --max-iterations caps
+// it per restart (default 2,000,000, 0 = uncapped) so the 10,000-team cases
+// finish in seconds. Leagues up to ~450 teams are unaffected by the default cap.
+int main(int argc, char** argv) {
+    std::vector<long> team_counts = {18, 100, 1000, 10000};
+    std::vector<long> roster_sizes = {4, 26, 60};
+    std::string json_path;
+    long long max_iterations = 2000000;
+    const int games_per_team = 110;
+    const std::uint64_t seed = 20250725;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--teams" && i + 1 < argc) {
+            team_counts = parseList(argv[++i]);
+        } else if (arg == "--rosters" && i + 1 < argc) {
+            roster_sizes = parseList(argv[++i]);
+        } else if (arg == "--json" && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (arg == "--max-iterations" && i + 1 < argc) {
+            max_iterations = std::strtoll(argv[++i], nullptr, 10);
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    SeasonEngineConfig config;
+    config.games_per_team = games_per_team;
+    config.seed = seed;
+    config.max_iterations_per_restart = max_iterations;
+
+    std::vector<Result> results;
+    NullBuffer null_buffer;
+    std::printf("%6s %6s %-16s %9s %12s %12s %12s %12s\n", "teams", "roster", "phase", "games", "ns/game",
+                "allocs/game", "bytes/game", "peak RSS KB");
+    for (long team_count : team_counts) {
+        for (long roster : roster_sizes) {
+            if (team_count < 3 || team_count >= kInvalidTeamId || roster < 0) {
+                continue;
+            }
+            const std::size_t n = static_cast<std::size_t>(team_count);
+            const int reps = n <= 100 ? 5 : 1;
+            TeamRegistry teams = buildLeague(n, static_cast<int>(roster));
+
+            std::streambuf* saved_out = std::cout.rdbuf(&null_buffer);
+            std::streambuf* saved_err = std::cerr.rdbuf(&null_buffer);
+            std::vector<Result> case_results;
+            case_results.push_back(measure("engine_plan", n, static_cast<int>(roster), reps, [&] {
+                SeasonPlan plan = SeasonEngine(config).plan(n);
+                std::size_t games = 0;
+                for (const PlannedBlock& block : plan.blocks) {
+                    games += static_cast<std::size_t>(block.totalGames());
+                }
+                return games;
+            }));
+            case_results.push_back(measure("stream_season", n, static_cast<int>(roster), reps, [&] {
+                LeagueScheduler2 scheduler(config, seed);
+                CountingSink sink;
+                scheduler.streamSeasonSchedule(teams, games_per_team, sink);
+                return sink.games;
+            }));
+            case_results.push_back(measure("generate_vector", n, static_cast<int>(roster), reps, [&] {
+                LeagueScheduler2 scheduler(config, seed);
+                SeasonSchedule season = scheduler.generateSeasonSchedule(teams, games_per_team);
+                std::size_t games = 0;
+                for (const ResidencyBlock& block : season) {
+                    games += block.games.size();
+                }
+                return games;
+            }));
+            case_results.push_back(measure("generate_arena", n, static_cast<int>(roster), reps, [&] {
+                std::pmr::monotonic_buffer_resource arena;
+                LeagueScheduler2 scheduler(config, seed);
+                SeasonSchedule season = scheduler.generateSeasonSchedule(teams, games_per_team, &arena);
+                std::size_t games = 0;
+                for (const ResidencyBlock& block : season) {
+                    games += block.games.size();
+                }
+                return games;
+            }));
+            {
+                LeagueScheduler2 scheduler(config, seed);
+                const SeasonSchedule season = scheduler.generateSeasonSchedule(teams, games_per_team);
+                case_results.push_back(measure("build_index", n, static_cast<int>(roster), reps, [&] {
+                    ScheduleIndex index(season, teams.size());
+                    return index.gameCount();
+                }));
+            }
+            std::cout.rdbuf(saved_out);
+            std::cerr.rdbuf(saved_err);
+
+            for (const Result& r : case_results) {
+                std::printf("%6zu %6d %-16s %9zu %12.1f %12.3f %12.1f %12ld\n", r.teams, r.roster, r.phase.c_str(),
+                            r.games, r.ns_per_game, r.allocs_per_game, r.bytes_per_game, r.peak_rss_kb);
+                results.push_back(r);
+            }
+            std::fflush(stdout);
+        }
+    }
+
+    if (!json_path.empty()) {
+        writeJson(json_path, results);
+    }
+    return 0;
+}
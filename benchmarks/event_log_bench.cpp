@@ -0,0 +1,155 @@
+/**
+ * @file event_log_bench.cpp
+ * @brief Play-by-play event log: append and simulation throughput, compression and query speed.
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "event_log.h"
+#include "league_definition.h"
+#include "league_scheduler_2.h"
+#include "play_by_play.h"
+
+using namespace LeagueSchedulerNS;
+
+namespace {
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+// Usage: event_log_bench [seasons=200] [directory=system temp]
+//
+// Simulates the 18-team league's schedule `seasons` times into one log, then
+// times the compressed-column queries against the same scans over a plain
+// vector of PlayEventRecord rows.
+int main(int argc, char** argv) {
+    const int seasons = (argc > 1) ? std::atoi(argv[1]) : 200;
+    const std::filesystem::path directory = (argc > 2) ? std::filesystem::path(argv[2])
+                                                       : std::filesystem::temp_directory_path();
+    if (seasons < 1) {
+        std::fprintf(stderr, "need at least one season\n");
+        return 1;
+    }
+
+    TeamRegistry teams = buildRegistry(defaultLeagueDefinition());
+    LeagueScheduler2 scheduler(11);
+    scheduler.setReportProgress(false);
+    const SeasonSchedule season = scheduler.generateSeasonSchedule(teams, 110);
+    const PlayByPlaySimulator simulator(teams, season);
+
+    EventLog log;
+    auto start = std::chrono::steady_clock::now();
+    std::uint64_t events = 0;
+    for (int s = 0; s < seasons; ++s) {
+        events += simulator.record(log, 1000 + static_cast<std::uint64_t>(s));
+    }
+    log.seal();
+    const double simulate_s = secondsSince(start);
+
+    // Bare append rate, replaying the same events.
+    std::vector<PlayEventRecord> rows;
+    rows.reserve(static_cast<std::size_t>(events));
+    log.forEach(EventQuery(), [&](const PlayEventRecord& record) { rows.push_back(record); });
+    EventLog copy;
+    for (std::size_t g = 0; g < log.gameCount(); ++g) {
+        copy.addGame(log.game(static_cast<std::uint32_t>(g)));
+    }
+    start = std::chrono::steady_clock::now();
+    for (const PlayEventRecord& row : rows) {
+        copy.append(row);
+    }
+    copy.seal();
+    const double append_s = secondsSince(start);
+
+    // Query 1: every rostered player's batting average, one query each.
+    std::vector<std::int32_t> player_ids(teams.players().ids(), teams.players().ids() + teams.players().size());
+    double column_sum = 0.0;
+    start = std::chrono::steady_clock::now();
+    for (std::int32_t id : player_ids) {
+        EventQuery query;
+        query.player = id;
+        column_sum += log.counts(query).battingAverage();
+    }
+    const double player_column_us = secondsSince(start) * 1e6 / player_ids.size();
+    double row_sum = 0.0;
+    start = std::chrono::steady_clock::now();
+    for (std::int32_t id : player_ids) {
+        std::uint64_t at_bats = 0;
+        std::uint64_t hits = 0;
+        for (const PlayEventRecord& row : rows) {
+            if (row.player == id) {
+                at_bats += (kAtBatEvents >> static_cast<unsigned>(row.event)) & 1u;
+                hits += (kHitEvents >> static_cast<unsigned>(row.event)) & 1u;
+            }
+        }
+        row_sum += at_bats == 0 ? 0.0 : static_cast<double>(hits) / at_bats;
+    }
+    const double player_row_us = secondsSince(start) * 1e6 / player_ids.size();
+
+    // Query 2: all crossroads-game home runs.
+    EventQuery crossroads_home_runs;
+    crossroads_home_runs.events = eventBit(PlayEvent::HOME_RUN);
+    crossroads_home_runs.game_types = gameTypeBit(GameType::CROSSROADS_GAME);
+    start = std::chrono::steady_clock::now();
+    const std::uint64_t column_home_runs = log.count(crossroads_home_runs);
+    const double home_runs_column_ms = secondsSince(start) * 1e3;
+    start = std::chrono::steady_clock::now();
+    std::uint64_t row_home_runs = 0;
+    for (const PlayEventRecord& row : rows) {
+        row_home_runs += row.event == PlayEvent::HOME_RUN && log.game(row.game).game_type == GameType::CROSSROADS_GAME;
+    }
+    const double home_runs_row_ms = secondsSince(start) * 1e3;
+
+    // Persistence.
+    const std::string path = (directory / "event_log_bench.apmwevents").string();
+    start = std::chrono::steady_clock::now();
+    if (!log.save(path)) {
+        return 1;
+    }
+    const double save_ms = secondsSince(start) * 1e3;
+    EventLog loaded;
+    start = std::chrono::steady_clock::now();
+    if (!loaded.load(path)) {
+        return 1;
+    }
+    const double load_ms = secondsSince(start) * 1e3;
+    const bool identical = loaded.size() == log.size() && loaded.count(crossroads_home_runs) == column_home_runs;
+    std::error_code error;
+    std::filesystem::remove(path, error);
+
+    const bool consistent = column_home_runs == row_home_runs && std::abs(column_sum - row_sum) < 1e-9 && identical;
+    std::printf("%d seasons, %llu events in %zu blocks\n", seasons, static_cast<unsigned long long>(events), log.blockCount());
+    std::printf("%-34s %12.2f\n", "simulate + append (M events/s)", events / simulate_s / 1e6);
+    std::printf("%-34s %12.2f\n", "append only (M events/s)", events / append_s / 1e6);
+    std::printf("%-34s %12.2f\n", "bytes per event (rows)", static_cast<double>(sizeof(PlayEventRecord)));
+    std::printf("%-34s %12.2f\n", "bytes per event (compressed)", static_cast<double>(log.compressedBytes()) / events);
+    std::printf("%-34s %12.2f %10.2f\n", "player batting avg (us) col/row", player_column_us, player_row_us);
+    std::printf("%-34s %12.3f %10.3f\n", "crossroads home runs (ms) col/row", home_runs_column_ms, home_runs_row_ms);
+    std::printf("%-34s %12.2f %10.2f\n", "save / load (ms)", save_ms, load_ms);
+    std::printf("%-34s %12s\n", "results", consistent ? "identical" : "MISMATCH");
+    return consistent ? 0 : 1;
+}
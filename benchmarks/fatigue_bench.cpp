@@ -0,0 +1,96 @@
+/**
+ * @file fatigue_bench.cpp
+ * @brief FatigueModel: microseconds to step a full season of player fatigue.
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "fatigue_model.h"
+#include "league_scheduler_2.h"
+#include "team_registry.h"
+
+using namespace LeagueSchedulerNS;
+
+// Usage: fatigue_bench [teams=18] [roster=26] [iterations=2000]
+int main(int argc, char** argv) {
+    const std::size_t team_count = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 18;
+    const int roster = (argc > 2) ? std::atoi(argv[2]) : 26;
+    const int iterations = (argc > 3) ? std::atoi(argv[3]) : 2000;
+    if (team_count < 3 || team_count >= kInvalidTeamId || roster < 1 || iterations < 1) {
+        std::fprintf(stderr, "need 3..65534 teams, a roster and at least one iteration\n");
+        return 1;
+    }
+
+    TeamRegistry teams;
+    int player_id = 1;
+    for (std::size_t t = 0; t < team_count; ++t) {
+        const TeamId id = teams.emplace(static_cast<int>(t + 1), "City_" + std::to_string(t), "Theme",
+                                        t % 2 == 0 ? UnionType::ATLANTIC : UnionType::PACIFIC, RegionType::KEYSTONE);
+        for (int p = 0; p < roster; ++p, ++player_id) {
+            teams[id].players.emplace_back(player_id, "P" + std::to_string(player_id), 70.0, 1000000, 2000000, false);
+        }
+    }
+
+    // The scheduler reports progress on stdout; keep the benchmark output clean.
+    std::ostringstream quiet;
+    std::streambuf* saved = std::cout.rdbuf(quiet.rdbuf());
+    LeagueScheduler2 scheduler(11);
+    const SeasonSchedule season = scheduler.generateSeasonSchedule(teams, 110);
+    std::cout.rdbuf(saved);
+
+    const auto build_start = std::chrono::steady_clock::now();
+    FatigueModel model(teams, season);
+    const double build_us =
+        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - build_start).count();
+
+    PlayerTable& table = teams.players();
+    std::vector<double> fatigue(table.size());
+    std::vector<int> games(table.size());
+    double checksum = 0.0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        std::fill(fatigue.begin(), fatigue.end(), 0.0);
+        std::fill(games.begin(), games.end(), 0);
+        model.applyDays(0, model.dayCount(), fatigue.data(), games.data());
+        checksum += fatigue[static_cast<std::size_t>(i) % fatigue.size()];
+    }
+    const double season_us =
+        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+    model.applySeason(table);
+    std::vector<PlayerRow> available;
+    std::size_t fit = 0;
+    for (TeamId t = 0; t < teams.size(); ++t) {
+        fit += model.availablePlayers(table, t, available);
+    }
+
+    std::printf("%zu teams x %d players, %d season days\n", team_count, roster, model.dayCount());
+    std::printf("%-26s %12.2f\n", "build model (us)", build_us);
+    std::printf("%-26s %12.2f\n", "apply season (us)", season_us);
+    std::printf("%-26s %12.2f\n", "ns per player-day", season_us * 1000.0 / (static_cast<double>(table.size()) * model.dayCount()));
+    std::printf("%-26s %12zu / %zu\n", "available at season end", fit, table.size());
+    std::printf("(checksum: %.3f)\n", checksum);
+    return 0;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file league_load_bench.cpp
+ * @brief League loading: text parse vs. binary startup cache for large leagues.
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include "league_file.h"
+
+using namespace LeagueSchedulerNS;
+
+namespace {
+
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+long long salaryChecksum(const LoadedLeague& league) {
+    return sumSalaries(league.teams.players()) + static_cast<long long>(league.teams.size());
+}
+
+} // namespace
+
+// Usage: league_load_bench [teams=10000] [roster=60] [directory=system temp]
+int main(int argc, char** argv) {
+    const std::size_t team_count = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 10000;
+    const int roster = (argc > 2) ? std::atoi(argv[2]) : 60;
+    const std::filesystem::path directory = (argc > 3) ? std::filesystem::path(argv[3])
+                                                       : std::filesystem::temp_directory_path();
+    if (team_count < 1 || team_count >= kInvalidTeamId || roster < 1) {
+        std::fprintf(stderr, "need 1..65534 teams and a roster\n");
+        return 1;
+    }
+    const std::string text_path = (directory / "league_load_bench.apmwleague").string();
+    const std::string cache_path = (directory / "league_load_bench.apmwleaguecache").string();
+
+    LoadedLeague league;
+    league.name = "Bench";
+    league.teams.players().reserve(team_count * static_cast<std::size_t>(roster));
+    int player_id = 1;
+    for (std::size_t t = 0; t < team_count; ++t) {
+        const TeamId id = league.teams.emplace(static_cast<int>(t + 1), "City_" + std::to_string(t), "Theme " + std::to_string(t % 97),
+                                               t % 2 == 0 ? UnionType::ATLANTIC : UnionType::PACIFIC,
+                                               static_cast<RegionType>(t % 7));
+        for (int p = 0; p < roster; ++p, ++player_id) {
+            Player player(player_id, "Player_" + std::to_string(player_id), 50.0 + (player_id % 4999) / 100.0,
+                          500000 + (player_id % 97) * 25000, 1000000 + (player_id % 89) * 50000, player_id % 50 == 0);
+            player.age = 20 + player_id % 18;
+            league.teams[id].players.push_back(player);
+        }
+    }
+    if (!writeLeagueFile(text_path, league)) {
+        return 1;
+    }
+    std::error_code error;
+    std::filesystem::remove(cache_path, error);
+    const long long expected = salaryChecksum(league);
+
+    LoadedLeague loaded;
+    auto start = std::chrono::steady_clock::now();
+    if (!readLeagueFile(text_path, loaded)) {
+        return 1;
+    }
+    const double text_ms = millisecondsSince(start);
+    const bool text_ok = salaryChecksum(loaded) == expected;
+
+    start = std::chrono::steady_clock::now();
+    if (!writeLeagueCache(cache_path, loaded, text_path)) {
+        return 1;
+    }
+    const double write_ms = millisecondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    if (!readLeagueCache(cache_path, loaded)) {
+        return 1;
+    }
+    const double cache_ms = millisecondsSince(start);
+    const bool cache_ok = salaryChecksum(loaded) == expected;
+
+    // What a program start with --league PATH --league-cache PATH costs once the cache exists.
+    start = std::chrono::steady_clock::now();
+    if (!loadLeague(text_path, loaded, cache_path)) {
+        return 1;
+    }
+    const double startup_ms = millisecondsSince(start);
+
+    std::printf("%zu teams x %d players (%.1f MB text, %.1f MB cache)\n", team_count, roster,
+                std::filesystem::file_size(text_path) / 1e6, std::filesystem::file_size(cache_path) / 1e6);
+    std::printf("%-26s %12.2f\n", "parse text (ms)", text_ms);
+    std::printf("%-26s %12.2f\n", "write cache (ms)", write_ms);
+    std::printf("%-26s %12.2f\n", "load cache (ms)", cache_ms);
+    std::printf("%-26s %12.2f\n", "startup, cached (ms)", startup_ms);
+    std::printf("%-26s %12s\n", "round trip", text_ok && cache_ok ? "identical" : "MISMATCH");
+
+    std::filesystem::remove(text_path, error);
+    std::filesystem::remove(cache_path, error);
+    return text_ok && cache_ok ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file payroll_bench.cpp
+ * @brief PayrollEngine throughput: projection ns/player and what-if scenarios per second.
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "payroll_engine.h"
+#include "team_registry.h"
+
+using namespace LeagueSchedulerNS;
+
+namespace {
+
+TeamRegistry buildLeague(std::size_t team_count, int roster, int league) {
+    TeamRegistry teams;
+    teams.reserve(team_count);
+    int player_id = league * 1000000 + 1;
+    for (std::size_t t = 0; t < team_count; ++t) {
+        const TeamId id = teams.emplace(static_cast<int>(t + 1), "City_" + std::to_string(t), "Theme",
+                                        UnionType::ATLANTIC, RegionType::KEYSTONE);
+        for (int p = 0; p < roster; ++p, ++player_id) {
+            auto row = teams[id].players.emplace_back(player_id, "P" + std::to_string(player_id),
+                                                      55.0 + (player_id % 40), 500000 + (player_id % 97) * 20000,
+                                                      1000000 + (player_id % 89) * 50000, player_id % 37 == 0);
+            row.age = 20 + player_id % 18;
+        }
+    }
+    return teams;
+}
+
+template <typename Fn>
+double seconds(Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+// Usage: payroll_bench [leagues=50] [teams_per_league=30] [roster=26] [scenarios=10000] [threads=0]
+int main(int argc, char** argv) {
+    const int league_count = (argc > 1) ? std::atoi(argv[1]) : 50;
+    const std::size_t team_count = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 30;
+    const int roster = (argc > 3) ? std::atoi(argv[3]) : 26;
+    const std::size_t scenario_count = (argc > 4) ? std::strtoul(argv[4], nullptr, 10) : 10000;
+    const unsigned threads = (argc > 5) ? static_cast<unsigned>(std::strtoul(argv[5], nullptr, 10)) : 0;
+    if (league_count < 1 || team_count < 2 || roster < 1) {
+        std::fprintf(stderr, "need at least one league, two teams and one player per roster\n");
+        return 1;
+    }
+
+    std::vector<TeamRegistry> leagues;
+    leagues.reserve(static_cast<std::size_t>(league_count));
+    for (int l = 0; l < league_count; ++l) {
+        leagues.push_back(buildLeague(team_count, roster, l));
+    }
+    PayrollEngine engine;
+    for (const TeamRegistry& league : leagues) {
+        engine.addLeague(league);
+    }
+    const std::size_t players = static_cast<std::size_t>(league_count) * team_count * static_cast<std::size_t>(roster);
+
+    const int iterations = 20;
+    const double evaluate_s = seconds([&] {
+        for (int i = 0; i < iterations; ++i) {
+            engine.evaluate();
+        }
+    });
+
+    // Each scenario re-signs one player and trades two others.
+    std::vector<Scenario> scenarios(scenario_count);
+    for (std::size_t s = 0; s < scenario_count; ++s) {
+        const std::uint32_t league = static_cast<std::uint32_t>(s % static_cast<std::size_t>(league_count));
+        const PlayerRow rows = static_cast<PlayerRow>(team_count * static_cast<std::size_t>(roster));
+        scenarios[s].push_back(ScenarioEdit::contract({league, static_cast<PlayerRow>(s % rows)}, 9000000));
+        scenarios[s].push_back(ScenarioEdit::trade({league, static_cast<PlayerRow>((s * 7 + 3) % rows)},
+                                                   static_cast<TeamId>(s % team_count)));
+        scenarios[s].push_back(ScenarioEdit::trade({league, static_cast<PlayerRow>((s * 13 + 5) % rows)},
+                                                   static_cast<TeamId>((s + 1) % team_count)));
+    }
+    long long tax_delta = 0;
+    const double scenarios_s = seconds([&] {
+        std::vector<ScenarioResult> results = engine.evaluateScenarios(scenarios, threads);
+        for (const ScenarioResult& result : results) {
+            tax_delta += result.luxury_tax_delta;
+        }
+    });
+
+    std::printf("%d leagues x %zu teams x %d players = %zu players, %d projection years\n", league_count, team_count,
+                roster, players, engine.model().projection_years);
+    std::printf("%-28s %14.2f\n", "evaluate ns/player", evaluate_s * 1e9 / (static_cast<double>(players) * iterations));
+    std::printf("%-28s %14.0f\n", "scenarios/s", static_cast<double>(scenario_count) / scenarios_s);
+    std::printf("(total luxury tax delta: %lld)\n", tax_delta);
+    return 0;
+}
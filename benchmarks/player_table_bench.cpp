@@ -0,0 +1,157 @@
+/**
+ * @file player_table_bench.cpp
+ * @brief Columnar PlayerTable kernels vs. equivalent scans over an array of Player structs.
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+#include "metric_registry.h"
+#include "player_table.h"
+
+namespace {
+
+template <typename Fn>
+double nsPerPlayer(Fn fn, std::size_t players, int iterations) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        fn();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / (static_cast<double>(players) * iterations);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t player_count = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 600000;
+    const int iterations = 20;
+
+    std::vector<Player> aos;
+    PlayerTable soa;
+    aos.reserve(player_count);
+    soa.reserve(player_count);
+    for (std::size_t i = 0; i < player_count; ++i) {
+        Player p(static_cast<int>(i + 1), "Player_" + std::to_string(i), 50.0 + static_cast<double>(i % 50),
+                 1000000 + static_cast<long long>(i % 97) * 10000, 2000000, (i % 41) == 0);
+        p.fatigue_level = 0.5;
+        aos.push_back(p);
+        soa.append(p);
+    }
+
+    long long payroll_sink = 0;
+    std::size_t filter_sink = 0;
+    std::vector<PlayerRow> rows;
+    std::vector<std::uint8_t> mask;
+    std::vector<std::size_t> aos_rows;
+    std::vector<std::uint8_t> aos_mask;
+
+    std::printf("%-16s %12s %12s %8s\n", "kernel", "AoS ns/plr", "SoA ns/plr", "speedup");
+
+    double aos_ns = nsPerPlayer([&] {
+        long long total = 0;
+        for (const Player& p : aos) {
+            total += p.salary;
+        }
+        payroll_sink += total;
+    }, player_count, iterations);
+    double soa_ns = nsPerPlayer([&] { payroll_sink += sumSalaries(soa); }, player_count, iterations);
+    std::printf("%-16s %12.3f %12.3f %8.1f\n", "payroll sum", aos_ns, soa_ns, aos_ns / soa_ns);
+
+    aos_ns = nsPerPlayer([&] {
+        for (Player& p : aos) {
+            p.fatigue_level *= 0.97;
+        }
+    }, player_count, iterations);
+    soa_ns = nsPerPlayer([&] { decayFatigue(soa, 0.97); }, player_count, iterations);
+    std::printf("%-16s %12.3f %12.3f %8.1f\n", "fatigue decay", aos_ns, soa_ns, aos_ns / soa_ns);
+
+    aos_ns = nsPerPlayer([&] {
+        aos_rows.clear();
+        for (std::size_t i = 0; i < aos.size(); ++i) {
+            if (aos[i].skill_rating >= 90.0) {
+                aos_rows.push_back(i);
+            }
+        }
+        filter_sink += aos_rows.size();
+    }, player_count, iterations);
+    soa_ns = nsPerPlayer([&] { filter_sink += filterBySkill(soa, 90.0, rows); }, player_count, iterations);
+    std::printf("%-16s %12.3f %12.3f %8.1f\n", "skill filter", aos_ns, soa_ns, aos_ns / soa_ns);
+
+    aos_ns = nsPerPlayer([&] {
+        aos_mask.resize(aos.size());
+        for (std::size_t i = 0; i < aos.size(); ++i) {
+            aos_mask[i] = (aos[i].is_star_player || aos[i].skill_rating >= 95.0) ? 1 : 0;
+        }
+        filter_sink += aos_mask[0];
+    }, player_count, iterations);
+    soa_ns = nsPerPlayer([&] {
+        starPlayerMask(soa, 95.0, mask);
+        filter_sink += mask[0];
+    }, player_count, iterations);
+    std::printf("%-16s %12.3f %12.3f %8.1f\n", "star mask", aos_ns, soa_ns, aos_ns / soa_ns);
+
+    // Performance metrics: per-player std::map<std::string, double> (the old
+    // Player::performance_metrics) vs. the interned dense MetricStore column.
+    std::vector<std::map<std::string, double>> metric_maps(player_count);
+    for (std::size_t i = 0; i < player_count; ++i) {
+        const double avg = 0.200 + static_cast<double>(i % 113) / 1000.0;
+        metric_maps[i]["batting_average"] = avg;
+        metric_maps[i]["era"] = 3.0;
+        soa.metrics().set(static_cast<PlayerRow>(i), Metrics::BATTING_AVERAGE, avg);
+        soa.metrics().set(static_cast<PlayerRow>(i), Metrics::ERA, 3.0);
+    }
+    double metric_sink = 0.0;
+    aos_ns = nsPerPlayer([&] {
+        for (auto& metrics : metric_maps) {
+            metrics["batting_average"] += 0.001;
+        }
+    }, player_count, iterations);
+    soa_ns = nsPerPlayer([&] {
+        MetricStore& store = soa.metrics();
+        for (PlayerRow r = 0; r < player_count; ++r) {
+            store.ref(r, Metrics::BATTING_AVERAGE) += 0.001;
+        }
+    }, player_count, iterations);
+    std::printf("%-16s %12.3f %12.3f %8.1f\n", "metric update", aos_ns, soa_ns, aos_ns / soa_ns);
+
+    aos_ns = nsPerPlayer([&] {
+        std::size_t best = 0;
+        for (std::size_t i = 1; i < metric_maps.size(); ++i) {
+            if (metric_maps[i].at("batting_average") > metric_maps[best].at("batting_average")) {
+                best = i;
+            }
+        }
+        metric_sink += metric_maps[best].at("batting_average");
+    }, player_count, iterations);
+    soa_ns = nsPerPlayer([&] {
+        soa.metrics().leaderboard(Metrics::BATTING_AVERAGE, 10, rows);
+        metric_sink += soa.metrics().get(rows[0], Metrics::BATTING_AVERAGE);
+    }, player_count, iterations);
+    std::printf("%-16s %12.3f %12.3f %8.1f\n", "leaderboard", aos_ns, soa_ns, aos_ns / soa_ns);
+
+    std::printf("(checksums: %lld %zu %.3f)\n", payroll_sink, filter_sink, metric_sink);
+    return 0;
+}
@@ -0,0 +1,127 @@
+/**
+ * @file quality_bench.cpp
+ * @brief Schedule quality scoring: full parallel evaluation vs. incremental move deltas.
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include "league_definition.h"
+#include "league_scheduler_2.h"
+#include "schedule_quality.h"
+
+using namespace LeagueSchedulerNS;
+
+namespace {
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void moveBlock(ResidencyBlock& block, CalendarDate start) {
+    const int length = block.end_date - block.start_date;
+    block.start_date = start;
+    block.end_date = start + length;
+}
+
+} // namespace
+
+// Usage: quality_bench [teams=180] [candidate moves=2000000] [threads=0]
+//
+// Teams reuse the lore league's cities, unions and regions in turn. The greedy
+// pass prices random date swaps and shifts with the incremental scorer, keeps
+// the improving ones, and checks the running cost against a full evaluation
+// of the moved season.
+int main(int argc, char** argv) {
+    const std::size_t team_count = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 180;
+    const long long candidates = (argc > 2) ? std::atoll(argv[2]) : 2000000;
+    const unsigned threads = (argc > 3) ? static_cast<unsigned>(std::atoi(argv[3])) : 0;
+    if (team_count < 3 || team_count >= kInvalidTeamId || candidates < 1) {
+        std::fprintf(stderr, "need 3..65534 teams and at least one candidate move\n");
+        return 1;
+    }
+
+    const LeagueDefinition lore = defaultLeagueDefinition();
+    TeamRegistry teams;
+    for (std::size_t t = 0; t < team_count; ++t) {
+        const TeamDefinition& like = lore.teams[t % lore.teams.size()];
+        teams.emplace(static_cast<int>(t + 1), like.city, like.mascot_theme, like.union_type, like.region_type);
+    }
+    LeagueScheduler2 scheduler(11);
+    scheduler.setReportProgress(false);
+    SeasonSchedule season = scheduler.generateSeasonSchedule(teams, lore.games_per_team);
+
+    ScheduleScorer scorer(teams, DistanceMatrix(teams));
+    auto start = std::chrono::steady_clock::now();
+    const QualityReport initial = scorer.evaluate(season, threads);
+    const double evaluate_ms = secondsSince(start) * 1e3;
+
+    start = std::chrono::steady_clock::now();
+    scorer.load(season);
+    const double load_ms = secondsSince(start) * 1e3;
+
+    std::mt19937_64 rng(7);
+    const std::size_t blocks = scorer.blockCount();
+    long long accepted = 0;
+    double sink = 0.0;
+    start = std::chrono::steady_clock::now();
+    for (long long i = 0; i < candidates; ++i) {
+        const std::size_t a = rng() % blocks;
+        if (i & 1) {
+            const std::size_t b = rng() % blocks;
+            const double delta = scorer.deltaSwap(a, b);
+            sink += delta;
+            if (delta < -1e-9) {
+                const CalendarDate start_a = season[a].start_date;
+                scorer.applySwap(a, b);
+                moveBlock(season[a], season[b].start_date);
+                moveBlock(season[b], start_a);
+                ++accepted;
+            }
+        } else {
+            const CalendarDate moved = scorer.blockStart(a) + static_cast<int>(rng() % 7) - 3;
+            const double delta = scorer.deltaMove(a, moved);
+            sink += delta;
+            if (delta < -1e-9) {
+                scorer.applyMove(a, moved);
+                moveBlock(season[a], moved);
+                ++accepted;
+            }
+        }
+    }
+    const double search_s = secondsSince(start);
+
+    const QualityReport final_report = scorer.evaluate(season, threads);
+    const bool consistent = std::fabs(final_report.total() - scorer.cost()) < 1e-6 * (1.0 + std::fabs(scorer.cost()));
+
+    std::printf("%zu teams, %zu blocks, %zu cities\n", team_count, blocks, DistanceMatrix(teams).cityCount());
+    std::printf("%-30s %14.3f\n", "full evaluation (ms)", evaluate_ms);
+    std::printf("%-30s %14.3f\n", "load for incremental (ms)", load_ms);
+    std::printf("%-30s %14.0f\n", "candidate moves / s", candidates / search_s);
+    std::printf("%-30s %14lld\n", "accepted moves", accepted);
+    std::printf("%-30s %14.2f -> %.2f\n", "cost", initial.total(), scorer.cost());
+    std::printf("%-30s %14.0f -> %.0f\n", "travel miles", initial.travel_miles, final_report.travel_miles);
+    std::printf("%-30s %14d -> %d\n", "short rests", initial.short_rests, final_report.short_rests);
+    std::printf("%-30s %14d -> %d\n", "overlapping blocks", initial.overlaps, final_report.overlaps);
+    std::printf("%-30s %14s\n", "running cost", consistent ? "consistent" : "MISMATCH");
+    return consistent && sink == sink ? 0 : 1;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file season_file_bench.cpp
+ * @brief Season archive write, mmap open/scan, and full copy-out timings.
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "game_data.h"
+#include "season_file.h"
+#include "team_registry.h"
+
+using namespace LeagueSchedulerNS;
+
+namespace {
+
+// A synthetic season: every team hosts `rounds` blocks of 11 games.
+SeasonSchedule buildSeason(std::size_t team_count, int rounds) {
+    SeasonSchedule season;
+    const CalendarDate opening = CalendarDate::fromCivil(2025, 3, 27);
+    for (int round = 0; round < rounds; ++round) {
+        for (std::size_t h = 0; h < team_count; ++h) {
+            const TeamId host = static_cast<TeamId>(h);
+            const TeamId v1 = static_cast<TeamId>((h + 1 + round) % team_count);
+            const TeamId v2 = static_cast<TeamId>((h + 2 + round) % team_count);
+            ResidencyBlock block;
+            block.host_team = host;
+            block.visiting_residents = {v1, v2};
+            block.start_date = opening + round * 12;
+            block.end_date = block.start_date + 10;
+            for (int g = 0; g < 11; ++g) {
+                const TeamId away = (g % 3 == 2) ? v1 : (g % 2 == 0 ? v1 : v2);
+                const TeamId home = (g % 3 == 2) ? v2 : host;
+                block.games.push_back({away, home, home, host, block.start_date + g,
+                                       g % 3 == 2 ? GameType::CROSSROADS_GAME : GameType::REGULAR_SEASON});
+            }
+            season.push_back(std::move(block));
+        }
+    }
+    return season;
+}
+
+template <typename Fn>
+double microseconds(Fn fn, int iterations) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        fn();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::micro>(elapsed).count() / iterations;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t team_count = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 180;
+    const std::string path = (argc > 2) ? argv[2] : "season_file_bench.apmwseason";
+    const int rounds = 5;
+    const int iterations = 50;
+
+    TeamRegistry teams;
+    for (std::size_t i = 0; i < team_count; ++i) {
+        teams.emplace(static_cast<int>(i + 1), "City_" + std::to_string(i), "Theme_" + std::to_string(i),
+                      UnionType::ATLANTIC, RegionType::KEYSTONE);
+    }
+    const SeasonSchedule season = buildSeason(team_count, rounds);
+    std::size_t game_count = 0;
+    for (const ResidencyBlock& block : season) {
+        game_count += block.games.size();
+    }
+    SeasonFileInfo info;
+    info.seed = 42;
+    info.season_start = season.front().start_date;
+
+    const double write_us = microseconds([&] { SeasonFileWriter::write(path, teams, season, info); }, iterations);
+
+    long long checksum = 0;
+    const double open_us = microseconds([&] {
+        SeasonFileReader reader;
+        checksum += reader.open(path) ? static_cast<long long>(reader.gameCount()) : -1;
+    }, iterations);
+    const double scan_us = microseconds([&] {
+        SeasonFileReader reader;
+        reader.open(path);
+        for (SeasonBlockView block : reader) {
+            for (const Game& game : block.games()) {
+                checksum += game.team1 + game.date.dayNumber();
+            }
+        }
+    }, iterations);
+    const double copy_us = microseconds([&] {
+        SeasonFileReader reader;
+        reader.open(path);
+        checksum += static_cast<long long>(reader.toSchedule().size());
+    }, iterations);
+
+    std::printf("%zu teams, %zu blocks, %zu games\n", team_count, season.size(), game_count);
+    std::printf("%-22s %12s\n", "operation", "us");
+    std::printf("%-22s %12.1f\n", "write", write_us);
+    std::printf("%-22s %12.1f\n", "open (map+validate)", open_us);
+    std::printf("%-22s %12.1f\n", "open + scan games", scan_us);
+    std::printf("%-22s %12.1f\n", "open + copy out", copy_us);
+    std::printf("(checksum: %lld)\n", checksum);
+    std::remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file standings_bench.cpp
+ * @brief Standings throughput: result updates per second with concurrent snapshot readers.
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+#include "counter_rng.h"
+#include "standings.h"
+#include "team_registry.h"
+
+using namespace LeagueSchedulerNS;
+
+// Usage: standings_bench [teams=18] [writers=4] [results_per_writer=5000000] [publish_every=4096]
+//
+// Writer threads stream random results into their own StandingsService::Writer
+// while one reader thread takes snapshots in a loop and checks each one is
+// consistent (total wins == total losses == results applied).
+int main(int argc, char** argv) {
+    const std::size_t team_count = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 18;
+    const unsigned writers = (argc > 2) ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10)) : 4;
+    const std::size_t per_writer = (argc > 3) ? std::strtoull(argv[3], nullptr, 10) : 5000000;
+    const std::size_t publish_every =
+        (argc > 4) ? std::strtoul(argv[4], nullptr, 10) : StandingsService::kDefaultPublishEvery;
+    if (team_count < 2 || team_count >= kInvalidTeamId || writers == 0) {
+        std::fprintf(stderr, "need 2..65534 teams and at least one writer\n");
+        return 1;
+    }
+
+    TeamRegistry teams;
+    for (std::size_t i = 0; i < team_count; ++i) {
+        teams.emplace(static_cast<int>(i + 1), "City_" + std::to_string(i), "Theme_" + std::to_string(i),
+                      i % 2 == 0 ? UnionType::ATLANTIC : UnionType::PACIFIC, static_cast<RegionType>(i % 7));
+    }
+    StandingsService standings(teams);
+
+    std::atomic<bool> done{false};
+    std::uint64_t snapshots = 0;
+    std::uint64_t inconsistent = 0;
+    std::thread reader([&] {
+        while (!done.load(std::memory_order_acquire)) {
+            std::shared_ptr<const StandingsSnapshot> view = standings.snapshot();
+            std::uint64_t wins = 0;
+            std::uint64_t losses = 0;
+            for (TeamId t = 0; t < view->teamCount(); ++t) {
+                wins += view->record(t).wins;
+                losses += view->record(t).losses;
+            }
+            inconsistent += (wins != losses || wins != view->results()) ? 1 : 0;
+            ++snapshots;
+        }
+    });
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (unsigned w = 0; w < writers; ++w) {
+        threads.emplace_back([&, w] {
+            StandingsService::Writer writer = standings.writer(publish_every);
+            CounterRng rng = CounterRng::forStream(7, {w});
+            const std::uint32_t n = static_cast<std::uint32_t>(team_count);
+            for (std::size_t i = 0; i < per_writer; ++i) {
+                const TeamId a = static_cast<TeamId>(rng.bounded(n));
+                const TeamId b = static_cast<TeamId>((a + 1 + rng.bounded(n - 1)) % n);
+                writer.record(a, b);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    done.store(true, std::memory_order_release);
+    reader.join();
+
+    const auto final_view = standings.snapshot();
+    const std::uint64_t total = static_cast<std::uint64_t>(writers) * per_writer;
+    std::printf("%zu teams, %u writers, publish every %zu results\n", team_count, writers, publish_every);
+    std::printf("%-26s %14.0f\n", "results/s", total / seconds);
+    std::printf("%-26s %14llu\n", "publications", static_cast<unsigned long long>(final_view->version()));
+    std::printf("%-26s %14llu\n", "snapshots read", static_cast<unsigned long long>(snapshots));
+    std::printf("%-26s %14llu\n", "inconsistent snapshots", static_cast<unsigned long long>(inconsistent));
+    std::printf("%-26s %14s\n", "final results match",
+                final_view->results() == total ? "yes" : "NO");
+    return (inconsistent == 0 && final_view->results() == total) ? 0 : 1;
+}
@@ -0,0 +1,250 @@
+/**
+ * @file team_layout_bench.cpp
+ * @brief Memory/throughput comparison of by-value Team copies vs. TeamId handles in schedules.
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+#include "game_data.h"
+#include "team_registry.h"
+
+using namespace LeagueSchedulerNS;
+
+// Heap accounting for this process: every allocation goes through here.
+static std::size_t g_alloc_bytes = 0;
+static std::size_t g_alloc_count = 0;
+
+void* operator new(std::size_t size) {
+    g_alloc_bytes += size;
+    ++g_alloc_count;
+    if (void* p = std::malloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+// Every replaced operator delete frees here. GCC cannot see that the matching
+// operator new above is malloc-based and flags std::free as mismatched.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+static void freeAllocation(void* p) noexcept { std::free(p); }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+void operator delete(void* p) noexcept { freeAllocation(p); }
+void operator delete(void* p, std::size_t) noexcept { freeAllocation(p); }
+// Over-aligned requests (std::pmr's new_delete_resource uses these).
+void* operator new(std::size_t size, std::align_val_t align) {
+    g_alloc_bytes += size;
+    ++g_alloc_count;
+    const std::size_t alignment = static_cast<std::size_t>(align);
+    if (void* p = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void* p, std::align_val_t) noexcept { freeAllocation(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { freeAllocation(p); }
+
+namespace {
+
+// The pre-handle layout: every game and block carries full Team copies,
+// and each Team owns its roster as a vector of Player records.
+struct ByValueTeam {
+    int id;
+    std::string city;
+    std::string mascot_theme;
+    UnionType union_type;
+    RegionType region_type;
+    int wins;
+    int losses;
+    std::vector<Player> players;
+};
+
+struct ByValueGame {
+    ByValueTeam team1;
+    ByValueTeam team2;
+    ByValueTeam designated_home_team_for_batting;
+    ByValueTeam actual_host_stadium;
+    std::string date;
+    GameType game_type;
+};
+
+struct ByValueBlock {
+    ByValueTeam host_team;
+    std::vector<ByValueTeam> visiting_residents;
+    std::vector<ByValueGame> games;
+    std::string start_date;
+    std::string end_date;
+    bool is_apex_residency = false;
+};
+
+TeamRegistry buildLeague(int team_count, int roster_size) {
+    TeamRegistry teams;
+    teams.reserve(team_count);
+    int player_id = 1;
+    for (int t = 0; t < team_count; ++t) {
+        TeamId id = teams.emplace(t + 1, "City_" + std::to_string(t), "Theme_" + std::to_string(t),
+                                  UnionType::ATLANTIC, RegionType::KEYSTONE);
+        Team& team = teams[id];
+        for (int p = 0; p < roster_size; ++p) {
+            team.players.emplace_back(player_id++, "Player_" + std::to_string(p) + "_" + team.city,
+                                      70.0 + p % 25, 1000000, 2000000, false);
+            team.players.back().performance_metrics["batting_average"] = 0.250;
+            team.players.back().performance_metrics["era"] = 3.50;
+            team.players.back().performance_metrics["wins_above_replacement"] = 1.0;
+        }
+    }
+    return teams;
+}
+
+std::vector<ByValueTeam> toByValueTeams(const TeamRegistry& teams) {
+    std::vector<ByValueTeam> out;
+    for (const Team& team : teams) {
+        ByValueTeam t{team.id, team.city, team.mascot_theme, team.union_type, team.region_type,
+                      team.wins, team.losses, {}};
+        for (const auto& player : team.players) {
+            t.players.push_back(player.toPlayer());
+        }
+        out.push_back(std::move(t));
+    }
+    return out;
+}
+
+// Same block pattern for both layouts: host i, visitors i+1 and i+2,
+// two host-vs-visitor games and a five-game crossroads series.
+std::vector<ByValueBlock> buildByValue(const std::vector<ByValueTeam>& teams) {
+    std::vector<ByValueBlock> season;
+    const std::size_t n = teams.size();
+    for (std::size_t h = 0; h < n; ++h) {
+        const ByValueTeam& host = teams[h];
+        const ByValueTeam& v1 = teams[(h + 1) % n];
+        const ByValueTeam& v2 = teams[(h + 2) % n];
+        ByValueBlock block;
+        block.host_team = host;
+        block.visiting_residents = {v1, v2};
+        block.start_date = "2025-07-25";
+        block.end_date = "2025-07-31";
+        for (const ByValueTeam* v : {&v1, &v2}) {
+            block.games.push_back({*v, host, host, host, block.start_date, GameType::REGULAR_SEASON});
+        }
+        for (int i = 0; i < 5; ++i) {
+            const ByValueTeam& first = (i % 2 == 0) ? v1 : v2;
+            const ByValueTeam& second = (i % 2 == 0) ? v2 : v1;
+            block.games.push_back({first, second, second, host, "Crossroads Game " + std::to_string(i + 1),
+                                   GameType::CROSSROADS_GAME});
+        }
+        season.push_back(std::move(block));
+    }
+    return season;
+}
+
+SeasonSchedule buildByHandle(const TeamRegistry& teams) {
+    SeasonSchedule season;
+    const std::size_t n = teams.size();
+    for (std::size_t h = 0; h < n; ++h) {
+        const TeamId host = static_cast<TeamId>(h);
+        const TeamId v1 = static_cast<TeamId>((h + 1) % n);
+        const TeamId v2 = static_cast<TeamId>((h + 2) % n);
+        ResidencyBlock block;
+        block.host_team = host;
+        block.visiting_residents = {v1, v2};
+        block.start_date = CalendarDate::fromCivil(2025, 7, 25);
+        block.end_date = block.start_date + 6;
+        for (TeamId v : {v1, v2}) {
+            block.games.push_back({v, host, host, host, block.start_date, GameType::REGULAR_SEASON});
+        }
+        for (int i = 0; i < 5; ++i) {
+            const TeamId first = (i % 2 == 0) ? v1 : v2;
+            const TeamId second = (i % 2 == 0) ? v2 : v1;
+            block.games.push_back({first, second, second, host, block.start_date + (i + 2),
+                                   GameType::CROSSROADS_GAME});
+        }
+        season.push_back(std::move(block));
+    }
+    return season;
+}
+
+struct Measurement {
+    double ns_per_season;
+    std::size_t bytes;
+    std::size_t allocations;
+};
+
+template <typename BuildFn>
+Measurement measure(BuildFn build, int iterations) {
+    // One instrumented build for memory, then a timed loop for throughput.
+    Measurement m{};
+    std::size_t bytes_before = g_alloc_bytes;
+    std::size_t count_before = g_alloc_count;
+    {
+        auto season = build();
+        m.bytes = g_alloc_bytes - bytes_before;
+        m.allocations = g_alloc_count - count_before;
+    }
+    auto start = std::chrono::steady_clock::now();
+    std::size_t sink = 0;
+    for (int i = 0; i < iterations; ++i) {
+        auto season = build();
+        sink += season.size();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    m.ns_per_season = std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+    if (sink == 0) {
+        std::printf("(empty season)\n");
+    }
+    return m;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int iterations = (argc > 1) ? std::atoi(argv[1]) : 50;
+    if (iterations < 1) {
+        iterations = 1;
+    }
+
+    std::printf("%6s %7s | %14s %12s %10s | %14s %12s %10s | %8s %8s\n",
+                "teams", "roster", "value ns", "value bytes", "value allocs",
+                "handle ns", "handle bytes", "hdl allocs", "mem x", "speed x");
+    const int team_counts[] = {18, 100, 500};
+    const int roster_sizes[] = {4, 26, 60};
+    for (int team_count : team_counts) {
+        for (int roster : roster_sizes) {
+            TeamRegistry teams = buildLeague(team_count, roster);
+            std::vector<ByValueTeam> legacy_teams = toByValueTeams(teams);
+            Measurement by_value = measure([&] { return buildByValue(legacy_teams); }, iterations);
+            Measurement by_handle = measure([&] { return buildByHandle(teams); }, iterations);
+            std::printf("%6d %7d | %14.0f %12zu %10zu | %14.0f %12zu %10zu | %8.1f %8.1f\n",
+                        team_count, roster,
+                        by_value.ns_per_season, by_value.bytes, by_value.allocations,
+                        by_handle.ns_per_season, by_handle.bytes, by_handle.allocations,
+                        static_cast<double>(by_value.bytes) / by_handle.bytes,
+                        by_value.ns_per_season / by_handle.ns_per_season);
+        }
+    }
+    return 0;
+}
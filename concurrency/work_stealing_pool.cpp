@@ -0,0 +1,131 @@
+/**
+ * @file work_stealing_pool.cpp
+ * @brief Work-stealing thread pool used by the parallel simulation and batch engines.
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "work_stealing_pool.h"
+#include <algorithm>
+
+namespace LeagueSchedulerNS {
+
+WorkStealingPool::WorkStealingPool(unsigned threads) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    queues_.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+    workers_.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i) {
+        workers_.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stopping_ = true;
+    }
+    work_available_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void WorkStealingPool::submit(Task task) {
+    const unsigned target = next_queue_++ % size();
+    ++pending_;
+    // Counted before it is published: a worker that pops the task decrements
+    // queued_, which must not run ahead of this increment and wrap around.
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        ++queued_;
+    }
+    {
+        std::lock_guard<std::mutex> lock(queues_[target]->mutex);
+        queues_[target]->tasks.push_back(std::move(task));
+    }
+    work_available_.notify_one();
+}
+
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    all_done_.wait(lock, [this] { return pending_.load() == 0; });
+}
+
+void WorkStealingPool::parallelFor(std::size_t count, std::size_t grain,
+                                   const std::function<void(std::size_t, std::size_t, unsigned)>& fn) {
+    grain = std::max<std::size_t>(1, grain);
+    for (std::size_t begin = 0; begin < count; begin += grain) {
+        const std::size_t end = std::min(count, begin + grain);
+        submit([&fn, begin, end](unsigned worker) { fn(begin, end, worker); });
+    }
+    wait();
+}
+
+bool WorkStealingPool::popOwn(unsigned index, Task& task) {
+    Queue& queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(unsigned thief, Task& task) {
+    const unsigned n = size();
+    for (unsigned offset = 1; offset < n; ++offset) {
+        Queue& victim = *queues_[(thief + offset) % n];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(unsigned index) {
+    Task task;
+    for (;;) {
+        if (popOwn(index, task) || steal(index, task)) {
+            --queued_;
+            task(index);
+            task = nullptr;
+            if (--pending_ == 0) {
+                std::lock_guard<std::mutex> lock(sleep_mutex_);
+                all_done_.notify_all();
+            }
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        work_available_.wait(lock, [this] { return stopping_.load() || queued_.load() > 0; });
+        if (stopping_ && queued_.load() == 0) {
+            return;
+        }
+    }
+}
+
+} // namespace LeagueSchedulerNS
@@ -0,0 +1,69 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace LeagueSchedulerNS {
+
+// A fixed-size thread pool with one task deque per worker.
+// Workers pop their own newest task first and steal the oldest task from
+// another worker when they run dry, so uneven chunks balance out without a
+// shared queue on the hot path. Tasks receive the index of the worker that
+// runs them, which callers use to address per-worker scratch state.
+class WorkStealingPool {
+public:
+    using Task = std::function<void(unsigned worker)>;
+
+    // `threads == 0` means one worker per hardware thread.
+    explicit WorkStealingPool(unsigned threads = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(workers_.size()); }
+
+    // Queues a task; tasks are spread round-robin over the worker deques.
+    void submit(Task task);
+
+    // Blocks until every submitted task has finished.
+    void wait();
+
+    // Splits [0, count) into chunks of `grain` and runs fn(begin, end, worker)
+    // for each chunk, returning once all chunks are done.
+    void parallelFor(std::size_t count, std::size_t grain,
+                     const std::function<void(std::size_t, std::size_t, unsigned)>& fn);
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void workerLoop(unsigned index);
+    bool popOwn(unsigned index, Task& task);
+    bool steal(unsigned thief, Task& task);
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<unsigned> next_queue_{0};
+    std::atomic<std::size_t> pending_{0};   // Submitted but not yet finished
+    std::atomic<std::size_t> queued_{0};    // Sitting in a deque
+    std::atomic<bool> stopping_{false};
+
+    std::mutex sleep_mutex_;
+    std::condition_variable work_available_;
+    std::condition_variable all_done_;
+};
+
+} // namespace LeagueSchedulerNS
+
+#endif // WORK_STEALING_POOL_H
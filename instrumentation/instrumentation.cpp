@@ -0,0 +1,267 @@
+/**
+ * @file instrumentation.cpp
+ * @brief Per-thread counters, scoped trace timers and Chrome trace-event export.
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "instrumentation.h"
+#include <iostream>
+
+#if APMW_INSTRUMENTATION
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+#endif
+
+namespace LeagueSchedulerNS {
+
+const char* instrumentCounterName(InstrumentCounter counter) {
+    static const char* const kNames[kInstrumentCounterCount] = {
+        "blocks_built", "games_built", "team_copies", "heap_allocations", "heap_bytes"};
+    const std::size_t index = static_cast<std::size_t>(counter);
+    return index < kInstrumentCounterCount ? kNames[index] : "unknown";
+}
+
+#if APMW_INSTRUMENTATION
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct TraceEvent {
+    const char* name;
+    std::int64_t start_ns;
+    std::int64_t duration_ns;
+    std::uint32_t tid;
+};
+
+// Owned by one thread. Counters are atomics only so that counterTotals() can
+// read them from another thread; the owner updates them with plain relaxed
+// load/store pairs, which compile to ordinary moves.
+struct ThreadState {
+    std::uint32_t tid = 0;
+    std::array<std::atomic<std::uint64_t>, kInstrumentCounterCount> counters{};
+    std::vector<TraceEvent> events;
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<ThreadState*> live;
+    CounterTotals retired{};                 // Folded in from threads that have exited
+    std::vector<TraceEvent> retired_events;
+    std::uint32_t next_tid = 1;
+    std::atomic<bool> tracing{false};
+    Clock::time_point epoch = Clock::now();
+};
+
+// Counts that arrive from threads that are not registered (e.g., allocations
+// made while registering a thread, or before the registry exists). Constant
+// initialized, so the allocation hook can use it at any point.
+std::atomic<std::uint64_t> g_unregistered[kInstrumentCounterCount] = {};
+
+// Intentionally leaked: threads may still retire while static destructors run.
+Registry& registry() {
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+std::int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - registry().epoch).count();
+}
+
+void retireThread(ThreadState* state) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (std::size_t i = 0; i < kInstrumentCounterCount; ++i) {
+        reg.retired[i] += state->counters[i].load(std::memory_order_relaxed);
+    }
+    reg.retired_events.insert(reg.retired_events.end(), state->events.begin(), state->events.end());
+    reg.live.erase(std::remove(reg.live.begin(), reg.live.end(), state), reg.live.end());
+    delete state;
+}
+
+// Trivially initialized, so the allocation hook can read it without running
+// any thread_local constructor.
+thread_local ThreadState* t_state = nullptr;
+
+// Retires the thread's state when the thread exits.
+struct ThreadHandle {
+    ~ThreadHandle() {
+        if (t_state != nullptr) {
+            ThreadState* state = t_state;
+            t_state = nullptr;
+            retireThread(state);
+        }
+    }
+};
+thread_local ThreadHandle t_handle;
+
+ThreadState* currentThread() {
+    if (t_state != nullptr) {
+        return t_state;
+    }
+    (void)&t_handle; // Instantiates the handle so the state is retired at thread exit
+    auto* state = new ThreadState();
+    state->events.reserve(1024);
+    Registry& reg = registry();
+    {
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        state->tid = reg.next_tid++;
+        reg.live.push_back(state);
+    }
+    t_state = state;
+    return state;
+}
+
+void bump(std::atomic<std::uint64_t>& slot, std::uint64_t amount) {
+    slot.store(slot.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+void writeEscaped(std::FILE* out, const char* text) {
+    for (; *text != '\0'; ++text) {
+        if (*text == '"' || *text == '\\') {
+            std::fputc('\\', out);
+        }
+        std::fputc(*text, out);
+    }
+}
+
+} // namespace
+
+void countEvent(InstrumentCounter counter, std::uint64_t amount) {
+    bump(currentThread()->counters[static_cast<std::size_t>(counter)], amount);
+}
+
+void countHeapAllocation(std::size_t bytes) noexcept {
+    constexpr std::size_t kCount = static_cast<std::size_t>(InstrumentCounter::HEAP_ALLOCATIONS);
+    constexpr std::size_t kBytes = static_cast<std::size_t>(InstrumentCounter::HEAP_BYTES);
+    if (ThreadState* state = t_state) {
+        bump(state->counters[kCount], 1);
+        bump(state->counters[kBytes], bytes);
+    } else {
+        g_unregistered[kCount].fetch_add(1, std::memory_order_relaxed);
+        g_unregistered[kBytes].fetch_add(bytes, std::memory_order_relaxed);
+    }
+}
+
+CounterTotals counterTotals() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    CounterTotals totals = reg.retired;
+    for (std::size_t i = 0; i < kInstrumentCounterCount; ++i) {
+        totals[i] += g_unregistered[i].load(std::memory_order_relaxed);
+        for (const ThreadState* state : reg.live) {
+            totals[i] += state->counters[i].load(std::memory_order_relaxed);
+        }
+    }
+    return totals;
+}
+
+void resetCounters() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.retired.fill(0);
+    for (std::size_t i = 0; i < kInstrumentCounterCount; ++i) {
+        g_unregistered[i].store(0, std::memory_order_relaxed);
+        for (ThreadState* state : reg.live) {
+            state->counters[i].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+void startTrace() { registry().tracing.store(true, std::memory_order_relaxed); }
+void stopTrace() { registry().tracing.store(false, std::memory_order_relaxed); }
+bool traceActive() { return registry().tracing.load(std::memory_order_relaxed); }
+
+ScopedTraceTimer::ScopedTraceTimer(const char* name) : name_(name), start_ns_(traceActive() ? nowNs() : -1) {}
+
+ScopedTraceTimer::~ScopedTraceTimer() {
+    if (start_ns_ >= 0) {
+        ThreadState* state = currentThread();
+        state->events.push_back({name_, start_ns_, nowNs() - start_ns_, state->tid});
+    }
+}
+
+bool writeChromeTrace(const std::string& path) {
+    std::vector<TraceEvent> events;
+    std::vector<std::uint32_t> tids;
+    Registry& reg = registry();
+    {
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        events = reg.retired_events;
+        for (const ThreadState* state : reg.live) {
+            events.insert(events.end(), state->events.begin(), state->events.end());
+        }
+    }
+    std::sort(events.begin(), events.end(),
+              [](const TraceEvent& a, const TraceEvent& b) { return a.start_ns < b.start_ns; });
+    for (const TraceEvent& event : events) {
+        if (std::find(tids.begin(), tids.end(), event.tid) == tids.end()) {
+            tids.push_back(event.tid);
+        }
+    }
+    const CounterTotals totals = counterTotals();
+
+    std::FILE* out = std::fopen(path.c_str(), "w");
+    if (out == nullptr) {
+        std::cerr << "Error: cannot create trace file " << path << std::endl;
+        return false;
+    }
+    std::fprintf(out, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    for (std::uint32_t tid : tids) {
+        std::fprintf(out, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s %u\"}},\n",
+                     tid, tid == 1 ? "main" : "worker", tid);
+    }
+    std::int64_t end_ns = 0;
+    for (const TraceEvent& event : events) {
+        std::fprintf(out, "{\"name\":\"");
+        writeEscaped(out, event.name);
+        std::fprintf(out, "\",\"cat\":\"apmw\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f},\n",
+                     event.tid, event.start_ns / 1000.0, event.duration_ns / 1000.0);
+        end_ns = std::max(end_ns, event.start_ns + event.duration_ns);
+    }
+    // Counter totals as a single counter sample at the end of the trace.
+    std::fprintf(out, "{\"name\":\"counters\",\"ph\":\"C\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"args\":{", end_ns / 1000.0);
+    for (std::size_t i = 0; i < kInstrumentCounterCount; ++i) {
+        std::fprintf(out, "%s\"%s\":%llu", i == 0 ? "" : ",", instrumentCounterName(static_cast<InstrumentCounter>(i)),
+                     static_cast<unsigned long long>(totals[i]));
+    }
+    std::fprintf(out, "}}\n]}\n");
+    const bool ok = std::ferror(out) == 0;
+    if (std::fclose(out) != 0 || !ok) {
+        std::cerr << "Error: failed to write trace file " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+#else // !APMW_INSTRUMENTATION
+
+bool writeChromeTrace(const std::string& path) {
+    std::cerr << "Error: cannot write " << path
+              << ": instrumentation is compiled out (configure with -DAPMW_INSTRUMENTATION=ON)" << std::endl;
+    return false;
+}
+
+#endif // APMW_INSTRUMENTATION
+
+} // namespace LeagueSchedulerNS
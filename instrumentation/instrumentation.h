@@ -0,0 +1,93 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Build switch (CMake option APMW_INSTRUMENTATION). When 0, every macro below
+// expands to nothing and the functions are inline no-ops, so instrumented code
+// compiles to exactly what it was before.
+#ifndef APMW_INSTRUMENTATION
+#define APMW_INSTRUMENTATION 0
+#endif
+
+namespace LeagueSchedulerNS {
+
+// Per-thread event counters. Each thread bumps its own slots (no shared cache
+// lines, no locked instructions); counterTotals() sums all threads.
+enum class InstrumentCounter : std::size_t {
+    BLOCKS_BUILT,
+    GAMES_BUILT,
+    TEAM_COPIES,
+    HEAP_ALLOCATIONS,   // Only counted when the operator new hook is linked in
+    HEAP_BYTES,
+    COUNT
+};
+constexpr std::size_t kInstrumentCounterCount = static_cast<std::size_t>(InstrumentCounter::COUNT);
+using CounterTotals = std::array<std::uint64_t, kInstrumentCounterCount>;
+
+const char* instrumentCounterName(InstrumentCounter counter);
+
+#if APMW_INSTRUMENTATION
+
+void countEvent(InstrumentCounter counter, std::uint64_t amount = 1);
+CounterTotals counterTotals();
+void resetCounters();
+
+// Trace recording is off until startTrace(); while off, scoped timers cost one
+// relaxed atomic load.
+void startTrace();
+void stopTrace();
+bool traceActive();
+
+// Writes every recorded scope as Chrome trace-event JSON (chrome://tracing,
+// Perfetto), plus the counter totals. Call it once the traced threads are idle.
+// Returns false (and reports to std::cerr) if the file cannot be written.
+bool writeChromeTrace(const std::string& path);
+
+// Called by the replaceable global operator new (allocation_hook.cpp).
+// Never allocates.
+void countHeapAllocation(std::size_t bytes) noexcept;
+
+// Times its own lifetime as a complete ("X") trace event on the current thread.
+// `name` must be a string literal (or otherwise outlive the trace).
+class ScopedTraceTimer {
+public:
+    explicit ScopedTraceTimer(const char* name);
+    ~ScopedTraceTimer();
+
+    ScopedTraceTimer(const ScopedTraceTimer&) = delete;
+    ScopedTraceTimer& operator=(const ScopedTraceTimer&) = delete;
+
+private:
+    const char* name_;
+    std::int64_t start_ns_;  // -1 when tracing was off at construction
+};
+
+#define APMW_INSTRUMENT_CONCAT_INNER(a, b) a##b
+#define APMW_INSTRUMENT_CONCAT(a, b) APMW_INSTRUMENT_CONCAT_INNER(a, b)
+#define APMW_TRACE_SCOPE(name) \
+    ::LeagueSchedulerNS::ScopedTraceTimer APMW_INSTRUMENT_CONCAT(apmw_trace_scope_, __LINE__)(name)
+#define APMW_COUNT(counter, amount) \
+    ::LeagueSchedulerNS::countEvent(::LeagueSchedulerNS::InstrumentCounter::counter, (amount))
+
+#else // !APMW_INSTRUMENTATION
+
+inline void countEvent(InstrumentCounter, std::uint64_t = 1) {}
+inline CounterTotals counterTotals() { return CounterTotals{}; }
+inline void resetCounters() {}
+inline void startTrace() {}
+inline void stopTrace() {}
+inline bool traceActive() { return false; }
+bool writeChromeTrace(const std::string& path); // Reports that instrumentation is compiled out
+
+#define APMW_TRACE_SCOPE(name) ((void)0)
+#define APMW_COUNT(counter, amount) ((void)0)
+
+#endif // APMW_INSTRUMENTATION
+
+} // namespace LeagueSchedulerNS
+
+#endif // INSTRUMENTATION_H
@@ -0,0 +1,105 @@
+/**
+ * @file league_definition.cpp
+ * @brief League set-up data: teams, rosters and season settings.
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "league_definition.h"
+#include <utility>
+
+namespace LeagueSchedulerNS {
+
+LeagueDefinition defaultLeagueDefinition() {
+    LeagueDefinition league;
+    league.name = "APMW";
+    league.games_per_team = 110;
+
+    // Initialize the 18 teams with cities and mascot/fan theme placeholders
+    struct TeamRow {
+        const char* city;
+        const char* mascot;
+        UnionType union_type;
+        RegionType region_type;
+    };
+    static const TeamRow kTeams[] = {
+        // Atlantic Union (9 teams)
+        {"Maine", "Lumberjack Spirit", UnionType::ATLANTIC, RegionType::KEYSTONE},
+        {"New York", "Metropolitan Spirit", UnionType::ATLANTIC, RegionType::KEYSTONE},
+        {"Philadelphia", "Founder Spirit", UnionType::ATLANTIC, RegionType::KEYSTONE},
+        {"Pittsburgh", "Iron Spirit", UnionType::ATLANTIC, RegionType::KEYSTONE},
+        {"Atlanta", "Peach Blossom", UnionType::ATLANTIC, RegionType::TIDEWATER},
+        {"Miami", "Manatee Calm", UnionType::ATLANTIC, RegionType::TIDEWATER},
+        {"Charlotte", "Aviator Grit", UnionType::ATLANTIC, RegionType::TIDEWATER},
+        {"Cleveland", "Guardian Resolve", UnionType::ATLANTIC, RegionType::THE_CONFLUENCE},
+        {"Detroit", "Automaker Drive", UnionType::ATLANTIC, RegionType::THE_CONFLUENCE},
+        // Pacific Union (9 teams)
+        {"Los Angeles", "Star Radiance", UnionType::PACIFIC, RegionType::GOLDEN_PENNANT},
+        {"San Diego", "Surf Vibe", UnionType::PACIFIC, RegionType::GOLDEN_PENNANT},
+        {"San Francisco", "Seal Endurance", UnionType::PACIFIC, RegionType::GOLDEN_PENNANT},
+        {"Seattle", "Rainier Force", UnionType::PACIFIC, RegionType::CASCADE_TERRITORY},
+        {"Austin", "Armadillo Resilience", UnionType::PACIFIC, RegionType::THE_SUNSTONE_DIVISION},
+        {"Dallas", "Lonestar Pride", UnionType::PACIFIC, RegionType::THE_SUNSTONE_DIVISION},
+        {"Denver", "Summit Peak", UnionType::PACIFIC, RegionType::THE_SUNSTONE_DIVISION},
+        {"St. Louis", "Archer Aim", UnionType::PACIFIC, RegionType::THE_HEARTLAND_CORE},
+        {"Kansas City", "Monarch Reign", UnionType::PACIFIC, RegionType::THE_HEARTLAND_CORE},
+    };
+
+    // Populate teams with some players, including "star players"
+    int current_team_id = 1;
+    int current_player_id = 1;
+    for (const TeamRow& row : kTeams) {
+        TeamDefinition team;
+        team.id = current_team_id++;
+        team.city = row.city;
+        team.mascot_theme = row.mascot;
+        team.union_type = row.union_type;
+        team.region_type = row.region_type;
+        team.players.emplace_back(current_player_id++, "PlayerA_" + team.city, 85.0, 5000000, 10000000, false);
+        team.players.emplace_back(current_player_id++, "PlayerB_" + team.city, 80.0, 3000000, 5000000, false);
+        team.players.emplace_back(current_player_id++, "PlayerC_" + team.city, 75.0, 2000000, 3000000, false);
+        if (team.city == "Los Angeles" || team.city == "New York" || team.city == "Austin") {
+            team.players.emplace_back(current_player_id++, "StarPlayer_" + team.city, 95.0, 15000000, 25000000, true);
+        } else {
+            team.players.emplace_back(current_player_id++, "PlayerD_" + team.city, 70.0, 1000000, 2000000, false);
+        }
+        league.teams.push_back(std::move(team));
+    }
+    return league;
+}
+
+TeamRegistry buildRegistry(const LeagueDefinition& league) {
+    TeamRegistry registry;
+    registry.reserve(league.teams.size());
+    std::size_t player_count = 0;
+    for (const TeamDefinition& definition : league.teams) {
+        player_count += definition.players.size();
+    }
+    registry.players().reserve(player_count);
+    for (const TeamDefinition& definition : league.teams) {
+        const TeamId id = registry.emplace(definition.id, definition.city, definition.mascot_theme,
+                                           definition.union_type, definition.region_type);
+        Team& team = registry[id];
+        for (const Player& player : definition.players) {
+            team.players.push_back(player);
+        }
+    }
+    return registry;
+}
+
+} // namespace LeagueSchedulerNS
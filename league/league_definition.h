@@ -0,0 +1,41 @@
+#ifndef LEAGUE_DEFINITION_H
+#define LEAGUE_DEFINITION_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../money_and_players/player_data.h"
+#include "../money_and_players/team_data.h"
+#include "../money_and_players/team_registry.h"
+
+namespace LeagueSchedulerNS {
+
+struct TeamDefinition {
+    int id = 0;                        // Team::id
+    std::string city;
+    std::string mascot_theme;
+    UnionType union_type = UnionType::UNKNOWN;
+    RegionType region_type = RegionType::UNKNOWN;
+    std::vector<Player> players;
+};
+
+// Everything needed to set up and schedule one league: its teams and rosters,
+// the season length and (optionally) a fixed seed.
+struct LeagueDefinition {
+    std::string name;
+    bool has_seed = false;             // false = the runner picks the seed
+    std::uint64_t seed = 0;
+    int games_per_team = 110;
+    std::vector<TeamDefinition> teams;
+};
+
+// The 18-team APMW league (two unions of nine teams, four players each, with
+// star players in Los Angeles, New York and Austin).
+LeagueDefinition defaultLeagueDefinition();
+
+// Registers the definition's teams, in order, with their rosters.
+TeamRegistry buildRegistry(const LeagueDefinition& league);
+
+} // namespace LeagueSchedulerNS
+
+#endif // LEAGUE_DEFINITION_H
@@ -0,0 +1,609 @@
+/**
+ * @file league_file.cpp
+ * @brief League definition files: mmap text parser, writer and binary startup cache.
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "league_file.h"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string_view>
+#include <system_error>
+#include "instrumentation.h"
+#include "league_topology.h"
+#include "mapped_file.h"
+
+namespace LeagueSchedulerNS {
+
+namespace {
+
+constexpr int kDefaultAge = 27;
+
+// ---------------------------------------------------------------- text
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r')) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+// Splits `text` on '|' into at most N trimmed fields; returns how many there
+// were (N + 1 means "too many").
+template <std::size_t N>
+std::size_t splitFields(std::string_view text, std::array<std::string_view, N>& fields) {
+    std::size_t count = 0;
+    while (true) {
+        const std::size_t bar = text.find('|');
+        if (count == N) {
+            return N + 1;
+        }
+        fields[count++] = trim(text.substr(0, bar));
+        if (bar == std::string_view::npos) {
+            return count;
+        }
+        text.remove_prefix(bar + 1);
+    }
+}
+
+template <typename T>
+bool parseNumber(std::string_view text, T& value) {
+    const char* end = text.data() + text.size();
+    const std::from_chars_result result = std::from_chars(text.data(), end, value);
+    return !text.empty() && result.ec == std::errc() && result.ptr == end;
+}
+
+template <typename Enum>
+bool parseEnum(std::string_view text, const char* const* names, std::size_t count, Enum& value) {
+    for (std::size_t i = 0; i < count; ++i) {
+        if (text == names[i]) {
+            value = static_cast<Enum>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Text fields may not contain the separator or a line break.
+bool plainField(std::string_view text) {
+    return text.find_first_of("|\r\n") == std::string_view::npos && trim(text) == text;
+}
+
+void appendDouble(std::string& out, double value) {
+    char buffer[32];
+    const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+template <typename Integer>
+void appendInt(std::string& out, Integer value) {
+    char buffer[24];
+    const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+// ---------------------------------------------------------------- cache
+
+constexpr std::uint64_t alignUp8(std::uint64_t value) { return (value + 7) & ~std::uint64_t(7); }
+
+// True if [offset, offset + count * size) lies inside a file of `file_size` bytes.
+bool sectionFits(std::uint64_t offset, std::uint64_t count, std::size_t size, std::size_t align,
+                 std::uint64_t file_size) {
+    if (offset % align != 0 || offset > file_size) {
+        return false;
+    }
+    return count <= (file_size - offset) / size;
+}
+
+bool sourceStamp(const std::string& path, std::uint64_t& size, std::int64_t& modified) {
+    std::error_code error;
+    const std::uintmax_t bytes = std::filesystem::file_size(path, error);
+    if (error) {
+        return false;
+    }
+    const std::filesystem::file_time_type time = std::filesystem::last_write_time(path, error);
+    if (error) {
+        return false;
+    }
+    size = static_cast<std::uint64_t>(bytes);
+    modified = static_cast<std::int64_t>(time.time_since_epoch().count());
+    return true;
+}
+
+class CacheOutput {
+public:
+    explicit CacheOutput(const std::string& path) : path_(path), file_(std::fopen(path.c_str(), "wb")) {
+        if (file_ == nullptr) {
+            std::cerr << "Error: cannot create " << path << std::endl;
+        }
+    }
+    ~CacheOutput() {
+        if (file_ != nullptr) {
+            std::fclose(file_);
+        }
+    }
+    CacheOutput(const CacheOutput&) = delete;
+    CacheOutput& operator=(const CacheOutput&) = delete;
+
+    bool isOpen() const { return file_ != nullptr; }
+    std::uint64_t position() const { return position_; }
+
+    bool write(const void* data, std::size_t size) {
+        if (size != 0 && std::fwrite(data, 1, size, file_) != size) {
+            std::cerr << "Error: write failed for " << path_ << std::endl;
+            return false;
+        }
+        position_ += size;
+        return true;
+    }
+    // Pads to an 8-byte boundary and writes `count` records starting there.
+    template <typename T>
+    bool section(const T* data, std::size_t count, std::uint64_t& offset) {
+        static const char zeros[8] = {};
+        if (!write(zeros, static_cast<std::size_t>(alignUp8(position_) - position_))) {
+            return false;
+        }
+        offset = position_;
+        return write(data, count * sizeof(T));
+    }
+    bool rewriteHeader(const LeagueCacheHeader& header) {
+        if (std::fseek(file_, 0, SEEK_SET) != 0 || std::fwrite(&header, sizeof(header), 1, file_) != 1) {
+            std::cerr << "Error: write failed for " << path_ << std::endl;
+            return false;
+        }
+        return true;
+    }
+    bool close() {
+        const bool ok = std::fclose(file_) == 0;
+        file_ = nullptr;
+        if (!ok) {
+            std::cerr << "Error: write failed for " << path_ << std::endl;
+        }
+        return ok;
+    }
+
+private:
+    std::string path_;
+    std::FILE* file_;
+    std::uint64_t position_ = 0;
+};
+
+// The header of a mapped cache if magic, version and byte order match.
+const LeagueCacheHeader* cacheHeader(const MappedFile& file) {
+    if (file.size() < sizeof(LeagueCacheHeader)) {
+        return nullptr;
+    }
+    const auto* header = reinterpret_cast<const LeagueCacheHeader*>(file.data());
+    if (std::memcmp(header->magic, kLeagueCacheMagic, sizeof(header->magic)) != 0 ||
+        header->version != kLeagueCacheVersion || header->byte_order != kLeagueCacheByteOrder) {
+        return nullptr;
+    }
+    return header;
+}
+
+// Validates a mapped cache and builds `out` from it.
+bool loadCache(const MappedFile& file, const std::string& path, LoadedLeague& out) {
+    const LeagueCacheHeader* header = cacheHeader(file);
+    if (header == nullptr) {
+        std::cerr << "Error: " << path << " is not a league cache of version " << kLeagueCacheVersion
+                  << " for this byte order" << std::endl;
+        return false;
+    }
+    const std::uint64_t size = file.size();
+    const std::uint64_t players = header->player_count;
+    const bool fits = header->team_count < kInvalidTeamId && players < 0xFFFFFFFFu &&
+                      header->name_length <= header->strings_size &&
+                      sectionFits(header->teams_offset, header->team_count, sizeof(LeagueCacheTeam), 8, size) &&
+                      sectionFits(header->strings_offset, header->strings_size, 1, 8, size) &&
+                      sectionFits(header->names_offset, players, sizeof(LeagueCacheName), 8, size) &&
+                      sectionFits(header->ids_offset, players, sizeof(std::int32_t), 8, size) &&
+                      sectionFits(header->ages_offset, players, sizeof(std::int32_t), 8, size) &&
+                      sectionFits(header->skill_offset, players, sizeof(double), 8, size) &&
+                      sectionFits(header->salary_offset, players, sizeof(std::int64_t), 8, size) &&
+                      sectionFits(header->market_value_offset, players, sizeof(std::int64_t), 8, size) &&
+                      sectionFits(header->star_offset, players, 1, 8, size);
+    if (!fits) {
+        std::cerr << "Error: " << path << " is truncated or corrupt" << std::endl;
+        return false;
+    }
+
+    const unsigned char* base = file.data();
+    const auto* teams = reinterpret_cast<const LeagueCacheTeam*>(base + header->teams_offset);
+    const char* strings = reinterpret_cast<const char*>(base + header->strings_offset);
+    const auto* names = reinterpret_cast<const LeagueCacheName*>(base + header->names_offset);
+    auto stringFits = [&](std::uint64_t offset, std::uint64_t length) {
+        return offset <= header->strings_size && length <= header->strings_size - offset;
+    };
+    std::uint64_t rostered = 0;
+    for (std::uint32_t t = 0; t < header->team_count; ++t) {
+        const LeagueCacheTeam& team = teams[t];
+        if (!stringFits(team.city_offset, team.city_length) || !stringFits(team.mascot_offset, team.mascot_length) ||
+            team.union_type >= kUnionCount || team.region_type >= kRegionCount) {
+            std::cerr << "Error: " << path << " has a corrupt team record" << std::endl;
+            return false;
+        }
+        rostered += team.player_count;
+    }
+    if (rostered != players) {
+        std::cerr << "Error: " << path << " rosters do not cover its " << players << " players" << std::endl;
+        return false;
+    }
+    for (std::uint64_t p = 0; p < players; ++p) {
+        if (!stringFits(names[p].offset, names[p].length)) {
+            std::cerr << "Error: " << path << " has a corrupt player name" << std::endl;
+            return false;
+        }
+    }
+
+    out = LoadedLeague();
+    out.name.assign(strings, header->name_length);
+    out.has_seed = header->has_seed != 0;
+    out.seed = header->seed;
+    out.games_per_team = header->games_per_team;
+
+    PlayerTable& table = out.teams.players();
+    table.reserve(static_cast<std::size_t>(players));
+    PlayerColumns columns;
+    columns.count = static_cast<std::size_t>(players);
+    columns.ids = reinterpret_cast<const int*>(base + header->ids_offset);
+    columns.ages = reinterpret_cast<const int*>(base + header->ages_offset);
+    columns.skill_ratings = reinterpret_cast<const double*>(base + header->skill_offset);
+    columns.salaries = reinterpret_cast<const long long*>(base + header->salary_offset);
+    columns.market_values = reinterpret_cast<const long long*>(base + header->market_value_offset);
+    columns.star_flags = base + header->star_offset;
+    table.appendRows(columns);
+    for (PlayerRow row = 0; row < players; ++row) {
+        table.setName(row, std::string_view(strings + names[row].offset, names[row].length));
+    }
+
+    out.teams.reserve(header->team_count);
+    PlayerRow first = 0;
+    for (std::uint32_t t = 0; t < header->team_count; ++t) {
+        const LeagueCacheTeam& team = teams[t];
+        out.teams.emplaceWithRoster(first, static_cast<PlayerRow>(team.player_count), team.team_number,
+                                    std::string(strings + team.city_offset, team.city_length),
+                                    std::string(strings + team.mascot_offset, team.mascot_length),
+                                    static_cast<UnionType>(team.union_type),
+                                    static_cast<RegionType>(team.region_type));
+        first += static_cast<PlayerRow>(team.player_count);
+    }
+    return true;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------- text
+
+bool readLeagueFile(const std::string& path, LoadedLeague& out) {
+    APMW_TRACE_SCOPE("league.read_text");
+    MappedFile file;
+    if (!file.open(path)) {
+        return false;
+    }
+    const char* text = reinterpret_cast<const char*>(file.data());
+    const std::string_view contents(text, file.size());
+
+    out = LoadedLeague();
+    // One row per line at most: a single reservation for the whole table.
+    out.teams.players().reserve(static_cast<std::size_t>(std::count(contents.begin(), contents.end(), '\n')) + 1);
+
+    Player player;  // Reused for every player line; only its fields are copied into the table
+    TeamId team = kInvalidTeamId;
+    std::size_t line_number = 0;
+    auto fail = [&](const char* problem) {
+        std::cerr << path << ":" << line_number << ": " << problem << std::endl;
+        return false;
+    };
+
+    std::size_t position = 0;
+    while (position < contents.size()) {
+        std::size_t end = contents.find('\n', position);
+        if (end == std::string_view::npos) {
+            end = contents.size();
+        }
+        const std::string_view line = trim(contents.substr(position, end - position));
+        position = end + 1;
+        ++line_number;
+        if (line.empty() || line.front() == '#') {
+            continue;
+        }
+
+        const std::size_t space = line.find_first_of(" \t");
+        const std::string_view keyword = line.substr(0, space);
+        const std::string_view rest = space == std::string_view::npos ? std::string_view() : trim(line.substr(space));
+
+        if (keyword == "player") {
+            std::array<std::string_view, 7> fields;
+            const std::size_t count = splitFields(rest, fields);
+            if (count < 6 || count > 7) {
+                return fail("a player line needs id|name|skill|salary|market value|star[|age]");
+            }
+            if (team == kInvalidTeamId) {
+                return fail("player before the first team");
+            }
+            int star = 0;
+            player.age = kDefaultAge;
+            if (!parseNumber(fields[0], player.id) || !parseNumber(fields[2], player.skill_rating) ||
+                !parseNumber(fields[3], player.salary) || !parseNumber(fields[4], player.market_value) ||
+                !parseNumber(fields[5], star) || star < 0 || star > 1 ||
+                (count == 7 && !parseNumber(fields[6], player.age))) {
+                return fail("bad number in player line");
+            }
+            player.name.assign(fields[1].data(), fields[1].size());
+            player.is_star_player = star != 0;
+            out.teams[team].players.push_back(player);
+        } else if (keyword == "team") {
+            std::array<std::string_view, 5> fields;
+            if (splitFields(rest, fields) != 5) {
+                return fail("a team line needs number|city|mascot theme|union|region");
+            }
+            int number = 0;
+            UnionType union_type = UnionType::UNKNOWN;
+            RegionType region_type = RegionType::UNKNOWN;
+            if (!parseNumber(fields[0], number)) {
+                return fail("bad team number");
+            }
+            if (!parseEnum(fields[3], kUnionNames, kUnionCount, union_type)) {
+                return fail("unknown union");
+            }
+            if (!parseEnum(fields[4], kRegionNames, kRegionCount, region_type)) {
+                return fail("unknown region");
+            }
+            if (out.teams.size() + 1 >= kInvalidTeamId) {
+                return fail("too many teams");
+            }
+            team = out.teams.emplace(number, std::string(fields[1]), std::string(fields[2]), union_type, region_type);
+        } else if (keyword == "league") {
+            out.name.assign(rest.data(), rest.size());
+        } else if (keyword == "games_per_team") {
+            if (!parseNumber(rest, out.games_per_team) || out.games_per_team < 0) {
+                return fail("bad games_per_team");
+            }
+        } else if (keyword == "seed") {
+            if (!parseNumber(rest, out.seed)) {
+                return fail("bad seed");
+            }
+            out.has_seed = true;
+        } else {
+            return fail("unknown record (expected league, games_per_team, seed, team or player)");
+        }
+    }
+    return true;
+}
+
+bool writeLeagueFile(const std::string& path, const LoadedLeague& league) {
+    std::string text;
+    text += "# APMW league definition (see league/league_file.h)\nleague ";
+    text += league.name;
+    text += "\ngames_per_team ";
+    appendInt(text, league.games_per_team);
+    text += '\n';
+    if (league.has_seed) {
+        text += "seed ";
+        appendInt(text, league.seed);
+        text += '\n';
+    }
+    for (const Team& team : league.teams) {
+        if (!plainField(team.city) || !plainField(team.mascot_theme)) {
+            std::cerr << "Error: team " << team.id << " has a name that cannot be written to " << path << std::endl;
+            return false;
+        }
+        text += "\nteam ";
+        appendInt(text, team.id);
+        text += '|';
+        text += team.city;
+        text += '|';
+        text += team.mascot_theme;
+        text += '|';
+        text += unionName(team.union_type);
+        text += '|';
+        text += regionName(team.region_type);
+        text += '\n';
+        for (ConstPlayerRef player : team.players) {
+            if (!plainField(player.name)) {
+                std::cerr << "Error: player " << player.id << " has a name that cannot be written to " << path
+                          << std::endl;
+                return false;
+            }
+            text += "player ";
+            appendInt(text, player.id);
+            text += '|';
+            text += player.name;
+            text += '|';
+            appendDouble(text, player.skill_rating);
+            text += '|';
+            appendInt(text, player.salary);
+            text += '|';
+            appendInt(text, player.market_value);
+            text += player.is_star_player ? "|1|" : "|0|";
+            appendInt(text, player.age);
+            text += '\n';
+        }
+    }
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        std::cerr << "Error: cannot create " << path << std::endl;
+        return false;
+    }
+    const bool written = std::fwrite(text.data(), 1, text.size(), file) == text.size();
+    if (std::fclose(file) != 0 || !written) {
+        std::cerr << "Error: write failed for " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------- cache
+
+bool writeLeagueCache(const std::string& path, const LoadedLeague& league, const std::string& source_path) {
+    APMW_TRACE_SCOPE("league.write_cache");
+    const PlayerTable& table = league.teams.players();
+    const std::size_t players = table.size();
+
+    LeagueCacheHeader header{};
+    std::memcpy(header.magic, kLeagueCacheMagic, sizeof(header.magic));
+    header.version = kLeagueCacheVersion;
+    header.byte_order = kLeagueCacheByteOrder;
+    if (!source_path.empty() && !sourceStamp(source_path, header.source_size, header.source_modified)) {
+        std::cerr << "Error: cannot stat " << source_path << std::endl;
+        return false;
+    }
+    header.seed = league.seed;
+    header.has_seed = league.has_seed ? 1 : 0;
+    header.games_per_team = league.games_per_team;
+    header.team_count = static_cast<std::uint32_t>(league.teams.size());
+    header.name_length = static_cast<std::uint32_t>(league.name.size());
+    header.player_count = players;
+
+    std::string strings = league.name;
+    std::vector<LeagueCacheTeam> teams(league.teams.size());
+    PlayerRow next_row = 0;
+    for (std::size_t t = 0; t < teams.size(); ++t) {
+        const Team& team = league.teams[static_cast<TeamId>(t)];
+        if (team.players.firstRow() != next_row) {
+            std::cerr << "Error: rosters are not stored in team order; cannot write " << path << std::endl;
+            return false;
+        }
+        LeagueCacheTeam& record = teams[t];
+        record = LeagueCacheTeam{};
+        record.team_number = team.id;
+        record.city_offset = static_cast<std::uint32_t>(strings.size());
+        record.city_length = static_cast<std::uint16_t>(team.city.size());
+        strings += team.city;
+        record.mascot_offset = static_cast<std::uint32_t>(strings.size());
+        record.mascot_length = static_cast<std::uint16_t>(team.mascot_theme.size());
+        strings += team.mascot_theme;
+        record.union_type = static_cast<std::uint8_t>(team.union_type);
+        record.region_type = static_cast<std::uint8_t>(team.region_type);
+        record.player_count = static_cast<std::uint32_t>(team.players.size());
+        next_row = team.players.endRow();
+    }
+    if (next_row != players) {
+        std::cerr << "Error: " << (players - next_row) << " players are on no roster; cannot write " << path
+                  << std::endl;
+        return false;
+    }
+    std::vector<LeagueCacheName> names(players);
+    for (PlayerRow row = 0; row < players; ++row) {
+        const std::string& name = table.row(row).name;
+        names[row] = LeagueCacheName{static_cast<std::uint32_t>(strings.size()), static_cast<std::uint32_t>(name.size())};
+        strings += name;
+    }
+    header.strings_size = strings.size();
+
+    CacheOutput output(path);
+    if (!output.isOpen()) {
+        return false;
+    }
+    // Placeholder header; rewritten once every offset is known.
+    const bool written = output.write(&header, sizeof(header)) &&
+                         output.section(teams.data(), teams.size(), header.teams_offset) &&
+                         output.section(strings.data(), strings.size(), header.strings_offset) &&
+                         output.section(names.data(), names.size(), header.names_offset) &&
+                         output.section(table.ids(), players, header.ids_offset) &&
+                         output.section(table.ages(), players, header.ages_offset) &&
+                         output.section(table.skillRatings(), players, header.skill_offset) &&
+                         output.section(table.salaries(), players, header.salary_offset) &&
+                         output.section(table.marketValues(), players, header.market_value_offset) &&
+                         output.section(table.starFlags(), players, header.star_offset) &&
+                         output.rewriteHeader(header);
+    return output.close() && written;
+}
+
+bool readLeagueCache(const std::string& path, LoadedLeague& out) {
+    APMW_TRACE_SCOPE("league.read_cache");
+    MappedFile file;
+    if (!file.open(path)) {
+        return false;
+    }
+    return loadCache(file, path, out);
+}
+
+bool loadLeague(const std::string& path, LoadedLeague& out, const std::string& cache_path) {
+    std::uint64_t source_size = 0;
+    std::int64_t source_modified = 0;
+    const bool stamped = !cache_path.empty() && sourceStamp(path, source_size, source_modified);
+    if (stamped) {
+        std::error_code error;
+        if (std::filesystem::exists(cache_path, error)) {
+            MappedFile file;
+            if (file.open(cache_path)) {
+                const LeagueCacheHeader* header = cacheHeader(file);
+                if (header != nullptr && header->source_size == source_size &&
+                    header->source_modified == source_modified && loadCache(file, cache_path, out)) {
+                    return true;
+                }
+            }
+        }
+    }
+
+    if (!readLeagueFile(path, out)) {
+        return false;
+    }
+    if (stamped && !writeLeagueCache(cache_path, out, path)) {
+        std::cerr << "Warning: league loaded, but the cache " << cache_path << " was not written" << std::endl;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------- definitions
+
+LoadedLeague loadDefinition(const LeagueDefinition& league) {
+    LoadedLeague loaded;
+    loaded.name = league.name;
+    loaded.has_seed = league.has_seed;
+    loaded.seed = league.seed;
+    loaded.games_per_team = league.games_per_team;
+    loaded.teams = buildRegistry(league);
+    return loaded;
+}
+
+LeagueDefinition toDefinition(const LoadedLeague& league) {
+    LeagueDefinition definition;
+    definition.name = league.name;
+    definition.has_seed = league.has_seed;
+    definition.seed = league.seed;
+    definition.games_per_team = league.games_per_team;
+    definition.teams.reserve(league.teams.size());
+    for (const Team& team : league.teams) {
+        TeamDefinition entry;
+        entry.id = team.id;
+        entry.city = team.city;
+        entry.mascot_theme = team.mascot_theme;
+        entry.union_type = team.union_type;
+        entry.region_type = team.region_type;
+        entry.players.reserve(team.players.size());
+        for (ConstPlayerRef player : team.players) {
+            entry.players.push_back(player.toPlayer());
+        }
+        definition.teams.push_back(std::move(entry));
+    }
+    return definition;
+}
+
+} // namespace LeagueSchedulerNS
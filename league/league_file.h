@@ -0,0 +1,126 @@
+#ifndef LEAGUE_FILE_H
+#define LEAGUE_FILE_H
+
+#include <cstdint>
+#include <string>
+#include "../money_and_players/team_registry.h"
+#include "league_definition.h"
+
+namespace LeagueSchedulerNS {
+
+// A league loaded from disk: its settings plus the teams and players, already
+// registered (rosters are row ranges of teams.players()).
+struct LoadedLeague {
+    std::string name;
+    bool has_seed = false;
+    std::uint64_t seed = 0;
+    int games_per_team = 110;
+    TeamRegistry teams;
+};
+
+// League definition file (".apmwleague"): UTF-8 text, one record per line.
+// Blank lines and lines starting with '#' are ignored. Fields are separated
+// by '|' and trimmed; players belong to the team line above them.
+//
+//   league APMW
+//   games_per_team 110
+//   seed 42                                   (optional)
+//   team 1|Maine|Lumberjack Spirit|ATLANTIC|KEYSTONE
+//   player 1|PlayerA_Maine|85|5000000|10000000|0|27
+//
+// A player line is id|name|skill|salary|market value|star (0 or 1)|age; the
+// age may be left out (27). Unions and regions are spelled as in team_data.h.
+//
+// The file is mapped and parsed in place: fields are string_views into the
+// mapping, numbers go through std::from_chars, and players are appended
+// straight to the registry's PlayerTable.
+//
+// Returns false (and reports "path:line: problem" to std::cerr) on the first
+// malformed line.
+bool readLeagueFile(const std::string& path, LoadedLeague& out);
+bool writeLeagueFile(const std::string& path, const LoadedLeague& league);
+
+// Binary league cache (".apmwleaguecache").
+//
+// Fixed-layout, versioned, native byte order, like the season archive. Every
+// player attribute is a flat column, so loading is one bulk copy per column
+// into the PlayerTable plus the name strings:
+//
+//   LeagueCacheHeader
+//   LeagueCacheTeam[team_count]
+//   char strings[strings_size]        league name, cities, themes, player names
+//   LeagueCacheName names[player_count]
+//   int32 ids, int32 ages, double skill_ratings, int64 salaries,
+//   int64 market_values, uint8 star_flags   (each [player_count])
+//
+// The header records the size and modification time of the text file the
+// cache was built from, so a stale cache is detected without reading the text.
+constexpr char kLeagueCacheMagic[8] = {'A', 'P', 'M', 'W', 'L', 'G', 'C', '\0'};
+constexpr std::uint32_t kLeagueCacheVersion = 1;
+constexpr std::uint32_t kLeagueCacheByteOrder = 0x01020304u;
+
+struct LeagueCacheHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint64_t source_size;      // Of the text file; 0 if written without one
+    std::int64_t source_modified;   // Its modification time, in file clock ticks
+    std::uint64_t seed;
+    std::uint32_t has_seed;
+    std::int32_t games_per_team;
+    std::uint32_t team_count;
+    std::uint32_t name_length;      // League name, at offset 0 of the strings section
+    std::uint64_t player_count;
+    std::uint64_t strings_size;
+    std::uint64_t teams_offset;
+    std::uint64_t strings_offset;
+    std::uint64_t names_offset;
+    std::uint64_t ids_offset;
+    std::uint64_t ages_offset;
+    std::uint64_t skill_offset;
+    std::uint64_t salary_offset;
+    std::uint64_t market_value_offset;
+    std::uint64_t star_offset;
+};
+
+struct LeagueCacheTeam {
+    std::int32_t team_number;       // Team::id
+    std::uint32_t city_offset;      // Into the strings section
+    std::uint32_t mascot_offset;
+    std::uint16_t city_length;
+    std::uint16_t mascot_length;
+    std::uint8_t union_type;
+    std::uint8_t region_type;
+    std::uint16_t reserved;
+    std::uint32_t player_count;     // Rows follow the previous team's
+};
+
+struct LeagueCacheName {
+    std::uint32_t offset;           // Into the strings section
+    std::uint32_t length;
+};
+
+static_assert(sizeof(LeagueCacheHeader) == 144, "LeagueCacheHeader layout changed; bump kLeagueCacheVersion");
+static_assert(sizeof(LeagueCacheTeam) == 24, "LeagueCacheTeam layout changed; bump kLeagueCacheVersion");
+static_assert(sizeof(LeagueCacheName) == 8, "LeagueCacheName layout changed; bump kLeagueCacheVersion");
+
+// Writes `league` as a cache. A non-empty `source_path` stamps the cache with
+// that text file's size and modification time.
+bool writeLeagueCache(const std::string& path, const LoadedLeague& league, const std::string& source_path = "");
+// Loads a cache without checking its source. Returns false (and reports to
+// std::cerr) if it is missing, truncated, from another version or byte order,
+// or refers outside itself.
+bool readLeagueCache(const std::string& path, LoadedLeague& out);
+
+// Loads the text league at `path`. With a `cache_path`, a cache built from the
+// current version of `path` is loaded instead; otherwise the text is parsed
+// and the cache (re)written for next time.
+bool loadLeague(const std::string& path, LoadedLeague& out, const std::string& cache_path = "");
+
+// Conversions to and from the in-code definition (e.g., for the batch driver).
+LoadedLeague loadDefinition(const LeagueDefinition& league);
+LeagueDefinition toDefinition(const LoadedLeague& league);
+
+} // namespace LeagueSchedulerNS
+
+#endif // LEAGUE_FILE_H
@@ -22,89 +22,377 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
 #include <iostream>
+#include <memory>
+#include <memory_resource>
 #include <vector>
 #include <string>
 #include "scheduling/league_scheduler_2.h"    // Includes the LeagueSchedulerNS namespace
+#include "scheduling/schedule_quality.h"      // Travel, rest and balance scoring
 #include "money_and_players/game_data.h"      // For Game and ResidencyBlock structs
+#include "money_and_players/team_registry.h"  // Owns each Team once; schedules hold TeamId handles
+#include "simulation/season_simulator.h"     // Game outcomes and Monte Carlo season replays
+#include "simulation/standings.h"            // Streaming standings with snapshot reads
+#include "simulation/play_by_play.h"         // Plate-appearance events into the columnar EventLog
+#include "storage/season_file.h"             // Binary season archive
+#include "reporting/schedule_exporter.h"     // Text/CSV/JSON-lines schedule output
+#include "league/league_definition.h"        // Teams and rosters of the default league
+#include "league/league_file.h"              // League definition files and their binary cache
+#include "batch/batch_runner.h"              // Many leagues sharded across worker threads
+#include "instrumentation/instrumentation.h" // Scoped trace timers, counters, Chrome trace export
 // Note: team_data.h and player_data.h are included via game_data.h
 
 // Using the new namespace explicitly
 using namespace LeagueSchedulerNS;
 
-int main() {
-    std::cout << "Starting APMW League Schedule Generation (C++ 3.5.0 with Money & Players)" << std::endl;
+namespace {
+
+// Streams the season: renders each block as it is produced, appends it to the
+// season archive (if one is being written) and keeps it for the simulator.
+class SeasonTee : public ScheduleSink {
+public:
+    SeasonTee(ScheduleSink& report, SeasonFileWriter* archive, SeasonSchedule& kept)
+        : report_(report), archive_(archive), kept_(kept) {}
+
+    void beginSeason(const SeasonPlan& plan) override {
+        kept_.reserve(plan.blocks.size());
+        report_.beginSeason(plan);
+    }
+
+    void onBlock(ResidencyBlock&& block) override {
+        if (archive_ != nullptr) {
+            archive_->append(block);
+        }
+        kept_.push_back(block);
+        report_.onBlock(std::move(block));
+    }
+
+    void endSeason() override { report_.endSeason(); }
+
+private:
+    ScheduleSink& report_;
+    SeasonFileWriter* archive_;
+    SeasonSchedule& kept_;
+};
 
-    // Initialize the 18 teams with cities and mascot/fan theme placeholders
-    std::vector<Team> all_teams;
-    int current_team_id = 1;
-
-    // Atlantic Union (9 teams)
-    all_teams.emplace_back(current_team_id++, "Maine", "Lumberjack Spirit", UnionType::ATLANTIC, RegionType::KEYSTONE);
-    all_teams.emplace_back(current_team_id++, "New York", "Metropolitan Spirit", UnionType::ATLANTIC, RegionType::KEYSTONE);
-    all_teams.emplace_back(current_team_id++, "Philadelphia", "Founder Spirit", UnionType::ATLANTIC, RegionType::KEYSTONE);
-    all_teams.emplace_back(current_team_id++, "Pittsburgh", "Iron Spirit", UnionType::ATLANTIC, RegionType::KEYSTONE);
-    all_teams.emplace_back(current_team_id++, "Atlanta", "Peach Blossom", UnionType::ATLANTIC, RegionType::TIDEWATER);
-    all_teams.emplace_back(current_team_id++, "Miami", "Manatee Calm", UnionType::ATLANTIC, RegionType::TIDEWATER);
-    all_teams.emplace_back(current_team_id++, "Charlotte", "Aviator Grit", UnionType::ATLANTIC, RegionType::TIDEWATER);
-    all_teams.emplace_back(current_team_id++, "Cleveland", "Guardian Resolve", UnionType::ATLANTIC, RegionType::THE_CONFLUENCE);
-    all_teams.emplace_back(current_team_id++, "Detroit", "Automaker Drive", UnionType::ATLANTIC, RegionType::THE_CONFLUENCE);
-
-    // Pacific Union (9 teams)
-    all_teams.emplace_back(current_team_id++, "Los Angeles", "Star Radiance", UnionType::PACIFIC, RegionType::GOLDEN_PENNANT);
-    all_teams.emplace_back(current_team_id++, "San Diego", "Surf Vibe", UnionType::PACIFIC, RegionType::GOLDEN_PENNANT);
-    all_teams.emplace_back(current_team_id++, "San Francisco", "Seal Endurance", UnionType::PACIFIC, RegionType::GOLDEN_PENNANT);
-    all_teams.emplace_back(current_team_id++, "Seattle", "Rainier Force", UnionType::PACIFIC, RegionType::CASCADE_TERRITORY);
-    all_teams.emplace_back(current_team_id++, "Austin", "Armadillo Resilience", UnionType::PACIFIC, RegionType::THE_SUNSTONE_DIVISION);
-    all_teams.emplace_back(current_team_id++, "Dallas", "Lonestar Pride", UnionType::PACIFIC, RegionType::THE_SUNSTONE_DIVISION);
-    all_teams.emplace_back(current_team_id++, "Denver", "Summit Peak", UnionType::PACIFIC, RegionType::THE_SUNSTONE_DIVISION);
-    all_teams.emplace_back(current_team_id++, "St. Louis", "Archer Aim", UnionType::PACIFIC, RegionType::THE_HEARTLAND_CORE);
-    all_teams.emplace_back(current_team_id++, "Kansas City", "Monarch Reign", UnionType::PACIFIC, RegionType::THE_HEARTLAND_CORE);
-
-    // Populate teams with some players, including "star players"
-    int current_player_id = 1;
-    for (auto& team : all_teams) {
-        team.players.emplace_back(current_player_id++, "PlayerA_" + team.city, 85.0, 5000000, 10000000, false);
-        team.players.emplace_back(current_player_id++, "PlayerB_" + team.city, 80.0, 3000000, 5000000, false);
-        team.players.emplace_back(current_player_id++, "PlayerC_" + team.city, 75.0, 2000000, 3000000, false);
-        if (team.city == "Los Angeles" || team.city == "New York" || team.city == "Austin") {
-            team.players.emplace_back(current_player_id++, "StarPlayer_" + team.city, 95.0, 15000000, 25000000, true);
+} // namespace
+
+int main(int argc, char** argv) {
+    // Command-line options:
+    //   --seed N             reproducible run (default: the league file's seed, else the clock)
+    //   --block-threads N    build residency blocks on N threads
+    //   --verify-sharding    check that sharded block generation matches serial output
+    //   --verify-repair      apply scripted postponements and closures and check the repaired season
+    //   --save-season PATH   write the generated season to a binary archive
+    //   --load-season PATH   summarize a saved season archive instead of generating one
+    //   --format FMT         schedule report format: text (default), csv or jsonl
+    //   --output PATH        write the schedule report to PATH instead of standard output
+    //   --league PATH        load teams and rosters from a league definition file
+    //                        (see league/league_file.h; default: the built-in league)
+    //   --league-cache PATH  binary cache for --league: loaded when it matches the file,
+    //                        rewritten when it does not
+    //   --write-league PATH  write the league as a definition file and exit
+    //   --batch N            schedule N independent copies of the league (seeds base .. base + N - 1)
+    //                        across worker threads, one JSON-lines file per worker
+    //                        (<output or "batch">.<worker>.jsonl), and report leagues/s
+    //   --batch-workers N    worker threads for --batch (default: one per hardware thread)
+    //   --quality            print the season's quality report (travel, rest, balance, union mix)
+    //   --events PATH        simulate the season plate appearance by plate appearance, save the
+    //                        event log to PATH and print batting leaders from it
+    //   --trace PATH         record scheduler/simulation timings as Chrome trace JSON and
+    //                        print the instrumentation counters (instrumented builds)
+    bool has_seed = false;
+    std::uint64_t seed = 0;
+    unsigned block_threads = 1;
+    bool verify_sharding = false;
+    bool verify_repair = false;
+    std::string save_path;
+    std::string load_path;
+    ScheduleFormat report_format = ScheduleFormat::TEXT;
+    std::string report_path = "-";
+    std::string trace_path;
+    std::string league_path;
+    std::string league_cache_path;
+    std::string write_league_path;
+    std::size_t batch_leagues = 0;
+    unsigned batch_workers = 0;
+    bool print_quality = false;
+    std::string events_path;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--seed" && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+            has_seed = true;
+        } else if (arg == "--block-threads" && i + 1 < argc) {
+            block_threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--verify-sharding") {
+            verify_sharding = true;
+        } else if (arg == "--verify-repair") {
+            verify_repair = true;
+        } else if (arg == "--save-season" && i + 1 < argc) {
+            save_path = argv[++i];
+        } else if (arg == "--load-season" && i + 1 < argc) {
+            load_path = argv[++i];
+        } else if (arg == "--format" && i + 1 < argc) {
+            if (!parseScheduleFormat(argv[++i], report_format)) {
+                std::cerr << "Unknown format: " << argv[i] << " (expected text, csv or jsonl)" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--output" && i + 1 < argc) {
+            report_path = argv[++i];
+        } else if (arg == "--league" && i + 1 < argc) {
+            league_path = argv[++i];
+        } else if (arg == "--league-cache" && i + 1 < argc) {
+            league_cache_path = argv[++i];
+        } else if (arg == "--write-league" && i + 1 < argc) {
+            write_league_path = argv[++i];
+        } else if (arg == "--batch" && i + 1 < argc) {
+            batch_leagues = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else if (arg == "--batch-workers" && i + 1 < argc) {
+            batch_workers = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--quality") {
+            print_quality = true;
+        } else if (arg == "--events" && i + 1 < argc) {
+            events_path = argv[++i];
+        } else if (arg == "--trace" && i + 1 < argc) {
+            trace_path = argv[++i];
         } else {
-            team.players.emplace_back(current_player_id++, "PlayerD_" + team.city, 70.0, 1000000, 2000000, false);
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return 1;
         }
     }
 
-    LeagueScheduler2 scheduler;
-    int games_per_team = 110;
+    if (!trace_path.empty()) {
+        startTrace();
+    }
 
-    std::vector<ResidencyBlock> season_schedule = scheduler.generateSeasonSchedule(all_teams, games_per_team);
+    if (!load_path.empty()) {
+        // Reads straight from the mapping: no schedule is rebuilt in memory.
+        SeasonFileReader archive;
+        if (!archive.open(load_path)) {
+            return 1;
+        }
+        std::cout << "Season archive " << load_path << ": seed " << archive.seed() << ", starts "
+                  << archive.seasonStart() << ", " << archive.blockCount() << " residency blocks, "
+                  << archive.gameCount() << " games" << std::endl;
+        std::vector<int> games_per_team(archive.teamCount(), 0);
+        for (const Game& game : archive.games()) {
+            ++games_per_team[game.team1];
+            ++games_per_team[game.team2];
+        }
+        for (TeamId team = 0; team < archive.teamCount(); ++team) {
+            std::cout << "  " << archive.team(team).city() << ": " << games_per_team[team] << " games" << std::endl;
+        }
+        return 0;
+    }
 
-    std::cout << "\n--- Sample Season Schedule ---" << std::endl;
-    for (const auto& block : season_schedule) {
-        std::cout << "--------------------------------------" << std::endl;
-        std::cout << "Residency Block: " << block.host_team.city << " Host "
-                  << (block.is_apex_residency ? "(APEX RESIDENCY)" : "") << std::endl;
-        std::cout << "  Visiting Residents: ";
-        for (const auto& visitor : block.visiting_residents) {
-            std::cout << visitor.city << " ";
+    std::cout << "Starting APMW League Schedule Generation (C++ 3.5.0 with Money & Players)" << std::endl;
+
+    // Teams, rosters and season length: a league file if one was given, else
+    // the built-in 18-team league.
+    LoadedLeague league;
+    if (!league_path.empty()) {
+        if (!loadLeague(league_path, league, league_cache_path)) {
+            return 1;
         }
-        std::cout << std::endl;
-        std::cout << "  Dates: " << block.start_date << " to " << block.end_date << std::endl;
-        std::cout << "  Games (" << block.games.size() << "):" << std::endl;
-        for (const auto& game : block.games) {
-            std::cout << "    - " << game.date << ": "
-                      << game.team1.city << " (Away/First Bat) vs. "
-                      << game.team2.city << " (Home/Second Bat) "
-                      << " at " << game.actual_host_stadium.city << " Stadium. Type: ";
-            if (game.game_type == GameType::REGULAR_SEASON) {
-                std::cout << "REGULAR_SEASON";
-            } else if (game.game_type == GameType::CROSSROADS_GAME) {
-                std::cout << "CROSSROADS_GAME";
-            } else if (game.game_type == GameType::APEX_RESIDENCY_GAME) {
-                std::cout << "APEX_RESIDENCY_GAME";
+    } else {
+        league = loadDefinition(defaultLeagueDefinition());
+    }
+    if (!write_league_path.empty()) {
+        if (!writeLeagueFile(write_league_path, league)) {
+            return 1;
+        }
+        std::cout << "Wrote league definition to " << write_league_path << std::endl;
+        return 0;
+    }
+    TeamRegistry& all_teams = league.teams;
+
+    LeagueScheduler2 scheduler;
+    if (has_seed) {
+        scheduler.setSeed(seed);
+    } else if (league.has_seed) {
+        scheduler.setSeed(league.seed);
+    }
+    scheduler.setBlockThreads(block_threads);
+    const int games_per_team = league.games_per_team;
+
+    if (batch_leagues > 0) {
+        // Independent copies of the league, seeds base + 0 .. base + N - 1.
+        std::vector<LeagueDefinition> leagues(batch_leagues, toDefinition(league));
+        for (LeagueDefinition& copy : leagues) {
+            copy.has_seed = false;
+        }
+        for (std::size_t i = 0; i < leagues.size(); ++i) {
+            leagues[i].name = league.name + "-" + std::to_string(i);
+        }
+        BatchOptions batch;
+        batch.workers = batch_workers;
+        batch.seed = scheduler.seed();
+        if (report_path != "-") {
+            batch.output_prefix = report_path;
+        }
+        const BatchResult result = BatchRunner(batch).run(leagues);
+        std::cout << "Batch: " << result.leagues << " leagues, " << result.games << " games on "
+                  << result.shards.size() << " workers in " << std::fixed << std::setprecision(3) << result.seconds
+                  << " s (" << std::setprecision(1) << result.leaguesPerSecond() << " leagues/s)"
+                  << std::defaultfloat << std::endl;
+        for (const BatchShardResult& shard : result.shards) {
+            std::cout << "  " << shard.path << ": " << shard.leagues << " leagues";
+            if (shard.cpu >= 0) {
+                std::cout << " (cpu " << shard.cpu << ")";
             }
             std::cout << std::endl;
         }
+        return result.ok ? 0 : 1;
+    }
+
+    std::cout << "Season seed: " << scheduler.seed() << std::endl;
+
+    if (verify_sharding) {
+        const unsigned threads = block_threads > 1 ? block_threads : 4;
+        const bool match = scheduler.verifyShardedMatchesSerial(all_teams, games_per_team, threads);
+        std::cout << "Sharded (" << threads << " threads) vs. serial block generation: "
+                  << (match ? "IDENTICAL" : "MISMATCH") << std::endl;
+        return match ? 0 : 1;
+    }
+
+    if (verify_repair) {
+        std::size_t disruptions = 0;
+        const bool ok = scheduler.verifyRepair(all_teams, games_per_team, disruptions);
+        std::cout << "Schedule repair (" << disruptions << " disruptions): " << (ok ? "CONSISTENT" : "INCONSISTENT")
+                  << std::endl;
+        return ok ? 0 : 1;
+    }
+
+    SeasonFileWriter archive;
+    if (!save_path.empty()) {
+        SeasonFileInfo info;
+        info.seed = scheduler.seed();
+        info.season_index = scheduler.seasonIndex();
+        info.season_start = scheduler.config().season_start;
+        if (!archive.open(save_path, all_teams, info)) {
+            return 1;
+        }
+    }
+
+    BufferedWriter report_out;
+    if (!report_out.open(report_path)) {
+        return 1;
+    }
+    std::unique_ptr<ScheduleExporter> report = makeScheduleExporter(report_format, all_teams, report_out);
+
+    // The kept season (blocks and their games) lives in one arena that is
+    // released in a single step when main returns.
+    std::pmr::monotonic_buffer_resource season_arena;
+    SeasonSchedule season_schedule(&season_arena);
+    SeasonTee tee(*report, archive.isOpen() ? &archive : nullptr, season_schedule);
+    scheduler.streamSeasonSchedule(all_teams, games_per_team, tee);
+    if (!report_out.close()) {
+        std::cerr << "Error: failed to write the schedule report to " << report_path << std::endl;
+        return 1;
+    }
+
+    if (archive.isOpen()) {
+        if (!archive.finish()) {
+            return 1;
+        }
+        std::cout << "\nSaved season to " << save_path << std::endl;
+    }
+
+    const SeasonPlan& plan = scheduler.lastPlan();
+    std::cout << "\n--- Games Per Team ---" << std::endl;
+    for (TeamId team = 0; team < plan.games_per_team.size(); ++team) {
+        std::cout << "  " << all_teams[team].city << ": " << plan.games_per_team[team] << " games ("
+                  << plan.blocks_hosted[team] << " blocks hosted, "
+                  << plan.blocks_visited[team] << " as visiting resident)" << std::endl;
+    }
+
+    if (print_quality) {
+        const DistanceMatrix distances(all_teams);
+        const ScheduleScorer scorer(all_teams, distances);
+        const QualityReport quality = scorer.evaluate(season_schedule);
+        std::cout << "\n--- Schedule Quality (cost " << std::fixed << std::setprecision(2) << quality.total() << ") ---"
+                  << std::endl;
+        std::cout << "  Travel " << std::setprecision(0) << quality.travel_miles << " miles, "
+                  << quality.short_rests << " short rests, " << quality.overlaps << " overlapping blocks";
+        if (distances.unknownTeams() > 0) {
+            std::cout << " (" << distances.unknownTeams() << " teams without a known city location)";
+        }
+        std::cout << std::endl;
+        for (TeamId team = 0; team < quality.teams.size(); ++team) {
+            const TeamQuality& row = quality.teams[team];
+            std::cout << "  " << std::left << std::setw(14) << all_teams[team].city << std::right
+                      << std::setw(7) << row.travel_miles << " mi  home/away " << row.home_games << "/" << row.away_games
+                      << "  crossroads bat last/first " << row.crossroads_batting_last << "/" << row.crossroads_batting_first
+                      << "  in-union " << row.union_games << "/" << row.games << std::endl;
+        }
+        std::cout << std::defaultfloat;
+    }
+
+    // Play the season once into the standings service, then replay it many times for playoff odds.
+    SeasonSimulator simulator(all_teams, season_schedule);
+    StandingsService standings(all_teams);
+    {
+        StandingsService::Writer results = standings.writer();
+        simulator.playSeason(results, scheduler.seed());
+    }
+    const std::shared_ptr<const StandingsSnapshot> table = standings.snapshot();
+
+    MonteCarloConfig monte_carlo;
+    monte_carlo.replays = 2000;
+    monte_carlo.seed = scheduler.seed();
+    MonteCarloResult odds = simulator.runMonteCarlo(monte_carlo);
+
+    std::cout << "\n--- Simulated Standings and Playoff Odds (" << odds.replays << " replays) ---" << std::endl;
+    for (TeamId team = 0; team < all_teams.size(); ++team) {
+        std::cout << "  " << std::left << std::setw(14) << all_teams[team].city << std::right
+                  << std::setw(4) << table->record(team).wins << "-" << std::setw(3) << table->record(team).losses
+                  << "  mean wins " << std::fixed << std::setprecision(1) << std::setw(5) << odds.teams[team].mean_wins
+                  << "  playoffs " << std::setw(5) << 100.0 * odds.teams[team].playoff_probability << "%"
+                  << std::defaultfloat << std::endl;
+    }
+
+    if (!events_path.empty()) {
+        EventLog events;
+        PlayByPlaySimulator play_by_play(all_teams, season_schedule);
+        const std::uint64_t appended = play_by_play.record(events, scheduler.seed());
+        if (!events.save(events_path)) {
+            return 1;
+        }
+        PlayerTable& players = all_teams.players();
+        events.applyBattingAverages(players);
+        EventQuery crossroads_home_runs;
+        crossroads_home_runs.events = eventBit(PlayEvent::HOME_RUN);
+        crossroads_home_runs.game_types = gameTypeBit(GameType::CROSSROADS_GAME);
+
+        std::cout << "\n--- Play-by-Play (" << appended << " plate appearances, " << events.compressedBytes()
+                  << " bytes) ---" << std::endl;
+        std::cout << "  Saved to " << events_path << std::endl;
+        std::cout << "  Crossroads home runs: " << events.count(crossroads_home_runs) << std::endl;
+        std::vector<PlayerRow> leaders;
+        players.metrics().leaderboard(Metrics::BATTING_AVERAGE, 5, leaders);
+        std::cout << "  Batting average leaders:" << std::endl;
+        for (PlayerRow row : leaders) {
+            std::cout << "    " << std::left << std::setw(24) << players.row(row).name << std::right << std::fixed
+                      << std::setprecision(3) << players.metrics().get(row, Metrics::BATTING_AVERAGE)
+                      << std::defaultfloat << std::endl;
+        }
+    }
+
+    if (!trace_path.empty()) {
+        stopTrace();
+        const CounterTotals totals = counterTotals();
+        std::cout << "\n--- Instrumentation ---" << std::endl;
+        for (std::size_t i = 0; i < kInstrumentCounterCount; ++i) {
+            std::cout << "  " << instrumentCounterName(static_cast<InstrumentCounter>(i)) << ": " << totals[i] << std::endl;
+        }
+        if (!writeChromeTrace(trace_path)) {
+            return 1;
+        }
+        std::cout << "  Trace written to " << trace_path << std::endl;
     }
 
     std::cout << "\nSchedule generation complete." << std::endl;
@@ -0,0 +1,133 @@
+#ifndef CALENDAR_H
+#define CALENDAR_H
+
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <string>
+
+namespace LeagueSchedulerNS {
+
+// A calendar date packed into a 16-bit day number (days since 2000-01-01,
+// covering 2000-01-01 through 2179-06-06).
+// Schedules store and compare dates as plain integers; conversion to and from
+// civil (year, month, day) form only happens at the edges (parsing config,
+// printing reports).
+class CalendarDate {
+public:
+    using DayNumber = std::uint16_t;
+
+    constexpr CalendarDate() : day_(0) {}
+    constexpr explicit CalendarDate(DayNumber day) : day_(day) {}
+
+    static constexpr CalendarDate fromCivil(int year, int month, int day) {
+        return CalendarDate(static_cast<DayNumber>(daysFromCivil(year, month, day) - kEpochOffset));
+    }
+
+    // Parses "YYYY-MM-DD". Returns false (and leaves `out` untouched) on
+    // malformed input, dates that do not exist (e.g. 2025-02-31) and dates
+    // outside the day number's range.
+    static bool parse(const std::string& text, CalendarDate& out) {
+        int y = 0, m = 0, d = 0;
+        if (std::sscanf(text.c_str(), "%d-%d-%d", &y, &m, &d) != 3 || m < 1 || m > 12 || d < 1 || d > 31 ||
+            y < 2000 || y > 2179) {  // Keeps daysFromCivil well inside int
+            return false;
+        }
+        const int day = daysFromCivil(y, m, d) - kEpochOffset;
+        if (day < 0 || day > 0xFFFF) {
+            return false;
+        }
+        int check_y = 0, check_m = 0, check_d = 0;
+        civilFromDays(day + kEpochOffset, check_y, check_m, check_d);
+        if (check_y != y || check_m != m || check_d != d) {
+            return false;
+        }
+        out = CalendarDate(static_cast<DayNumber>(day));
+        return true;
+    }
+
+    constexpr DayNumber dayNumber() const { return day_; }
+
+    void toCivil(int& year, int& month, int& day) const {
+        civilFromDays(static_cast<int>(day_) + kEpochOffset, year, month, day);
+    }
+
+    // Writes "YYYY-MM-DD" plus a terminator into `buffer` (at least 11 bytes)
+    // without allocating; returns the number of characters written (10).
+    int format(char* buffer) const {
+        int y = 0, m = 0, d = 0;
+        toCivil(y, m, d);
+        writeDigits(buffer, y, 4);
+        buffer[4] = '-';
+        writeDigits(buffer + 5, m, 2);
+        buffer[7] = '-';
+        writeDigits(buffer + 8, d, 2);
+        buffer[10] = '\0';
+        return 10;
+    }
+
+    std::string toString() const {
+        char buffer[11];
+        format(buffer);
+        return std::string(buffer, 10);
+    }
+
+    constexpr CalendarDate operator+(int days) const { return CalendarDate(static_cast<DayNumber>(day_ + days)); }
+    constexpr CalendarDate operator-(int days) const { return CalendarDate(static_cast<DayNumber>(day_ - days)); }
+    constexpr int operator-(CalendarDate other) const { return static_cast<int>(day_) - static_cast<int>(other.day_); }
+    CalendarDate& operator+=(int days) { day_ = static_cast<DayNumber>(day_ + days); return *this; }
+
+    constexpr bool operator==(CalendarDate o) const { return day_ == o.day_; }
+    constexpr bool operator!=(CalendarDate o) const { return day_ != o.day_; }
+    constexpr bool operator<(CalendarDate o) const { return day_ < o.day_; }
+    constexpr bool operator<=(CalendarDate o) const { return day_ <= o.day_; }
+    constexpr bool operator>(CalendarDate o) const { return day_ > o.day_; }
+    constexpr bool operator>=(CalendarDate o) const { return day_ >= o.day_; }
+
+    // Days since 1970-01-01 for a proleptic Gregorian date (H. Hinnant's algorithm).
+    static constexpr int daysFromCivil(int y, int m, int d) {
+        y -= m <= 2 ? 1 : 0;
+        const int era = (y >= 0 ? y : y - 399) / 400;
+        const int yoe = y - era * 400;
+        const int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+        const int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + doe - 719468;
+    }
+
+    static void civilFromDays(int z, int& y, int& m, int& d) {
+        z += 719468;
+        const int era = (z >= 0 ? z : z - 146096) / 146097;
+        const int doe = z - era * 146097;
+        const int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        const int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const int mp = (5 * doy + 2) / 153;
+        d = doy - (153 * mp + 2) / 5 + 1;
+        m = mp + (mp < 10 ? 3 : -9);
+        y = yoe + era * 400 + (m <= 2 ? 1 : 0);
+    }
+
+private:
+    static constexpr int kEpochOffset = 10957; // daysFromCivil(2000, 1, 1)
+
+    static void writeDigits(char* out, int value, int width) {
+        for (int i = width - 1; i >= 0; --i) {
+            out[i] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+    }
+
+    DayNumber day_;
+};
+
+static_assert(CalendarDate::daysFromCivil(2000, 1, 1) == 10957, "calendar epoch");
+static_assert(sizeof(CalendarDate) == 2, "CalendarDate must stay packed");
+
+inline std::ostream& operator<<(std::ostream& os, CalendarDate date) {
+    char buffer[11];
+    date.format(buffer);
+    return os.write(buffer, 10);
+}
+
+} // namespace LeagueSchedulerNS
+
+#endif // CALENDAR_H
@@ -1,38 +1,96 @@
 #ifndef GAME_DATA_H
 #define GAME_DATA_H
 
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
 #include <string>
+#include <utility>
 #include <vector>
+#include "calendar.h" // Packed CalendarDate day numbers
 #include "team_data.h" // Assuming team_data.h defines the Team struct
+#include "team_registry.h" // TeamId handles into the league's TeamRegistry
 
 namespace LeagueSchedulerNS { // Ensure this is within the LeagueSchedulerNS namespace
-enum class GameType {
+enum class GameType : std::uint8_t {
     REGULAR_SEASON,
     CROSSROADS_GAME,
     // NEW: Type for Apex Residency games
     APEX_RESIDENCY_GAME 
 };
 
+// Display names indexed by GameType (keep in enum order).
+constexpr const char* kGameTypeNames[] = {"REGULAR_SEASON", "CROSSROADS_GAME", "APEX_RESIDENCY_GAME"};
+constexpr std::size_t kGameTypeCount = sizeof(kGameTypeNames) / sizeof(kGameTypeNames[0]);
+static_assert(kGameTypeCount == static_cast<std::size_t>(GameType::APEX_RESIDENCY_GAME) + 1,
+              "kGameTypeNames must cover every GameType");
+
+inline const char* gameTypeName(GameType type) {
+    const std::size_t index = static_cast<std::size_t>(type);
+    return index < kGameTypeCount ? kGameTypeNames[index] : "UNKNOWN";
+}
+
+// Teams are referenced by TeamId; resolve them through the owning TeamRegistry
+// (e.g., registry[game.team1].city).
 struct Game {
-    Team team1;
-    Team team2;
-    Team designated_home_team_for_batting; // Crucial for alternating first bat rule
-    Team actual_host_stadium;
-    std::string date;
-    GameType game_type;
+    TeamId team1 = kInvalidTeamId;
+    TeamId team2 = kInvalidTeamId;
+    TeamId designated_home_team_for_batting = kInvalidTeamId; // Crucial for alternating first bat rule
+    TeamId actual_host_stadium = kInvalidTeamId;
+    CalendarDate date;
+    GameType game_type = GameType::REGULAR_SEASON;
     // Potentially add more game-specific attributes here for future
 };
 
+// Allocator-aware: a block's vectors draw from the memory resource it was
+// constructed with, and a SeasonSchedule hands its own resource to every block
+// it holds. Building a season into a std::pmr::monotonic_buffer_resource puts
+// the whole season in one arena that is released in O(1).
 struct ResidencyBlock {
-    Team host_team;
-    std::vector<Team> visiting_residents;
-    std::vector<Game> games;
-    std::string start_date; // Placeholder
-    std::string end_date;   // Placeholder
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+    TeamId host_team = kInvalidTeamId;
+    std::pmr::vector<TeamId> visiting_residents;
+    std::pmr::vector<Game> games;
+    CalendarDate start_date;
+    CalendarDate end_date;  // Inclusive
     // Add an identifier for special residency types, if needed
     bool is_apex_residency = false; // NEW: Flag to identify Apex Residencies
+
+    ResidencyBlock() = default;
+    explicit ResidencyBlock(const allocator_type& alloc) : visiting_residents(alloc), games(alloc) {}
+    ResidencyBlock(const ResidencyBlock&) = default;
+    ResidencyBlock(ResidencyBlock&&) noexcept = default;
+    ResidencyBlock(const ResidencyBlock& other, const allocator_type& alloc)
+        : host_team(other.host_team), visiting_residents(other.visiting_residents, alloc), games(other.games, alloc),
+          start_date(other.start_date), end_date(other.end_date), is_apex_residency(other.is_apex_residency) {}
+    ResidencyBlock(ResidencyBlock&& other, const allocator_type& alloc)
+        : host_team(other.host_team), visiting_residents(std::move(other.visiting_residents), alloc),
+          games(std::move(other.games), alloc), start_date(other.start_date), end_date(other.end_date),
+          is_apex_residency(other.is_apex_residency) {}
+    ResidencyBlock& operator=(const ResidencyBlock&) = default;
+    ResidencyBlock& operator=(ResidencyBlock&&) = default;
+
+    allocator_type get_allocator() const { return games.get_allocator(); }
 };
 
+// A whole season of blocks. Uses the default resource unless constructed with
+// another one (e.g., SeasonSchedule season(&arena)).
+using SeasonSchedule = std::pmr::vector<ResidencyBlock>;
+
+inline bool operator==(const Game& a, const Game& b) {
+    return a.team1 == b.team1 && a.team2 == b.team2 &&
+           a.designated_home_team_for_batting == b.designated_home_team_for_batting &&
+           a.actual_host_stadium == b.actual_host_stadium && a.date == b.date && a.game_type == b.game_type;
+}
+inline bool operator!=(const Game& a, const Game& b) { return !(a == b); }
+
+inline bool operator==(const ResidencyBlock& a, const ResidencyBlock& b) {
+    return a.host_team == b.host_team && a.visiting_residents == b.visiting_residents && a.games == b.games &&
+           a.start_date == b.start_date && a.end_date == b.end_date && a.is_apex_residency == b.is_apex_residency;
+}
+inline bool operator!=(const ResidencyBlock& a, const ResidencyBlock& b) { return !(a == b); }
+
 } // namespace LeagueSchedulerNS
 
 #endif // GAME_DATA_H
@@ -0,0 +1,201 @@
+#ifndef LEAGUE_TOPOLOGY_H
+#define LEAGUE_TOPOLOGY_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "team_data.h"
+#include "team_registry.h"
+
+namespace LeagueSchedulerNS {
+
+// --- Compile-time lore tables -------------------------------------------
+// Everything here is derived from the UnionType / RegionType enums and the
+// lore lists below when the program is compiled; nothing scans teams.
+
+constexpr std::size_t kUnionCount = static_cast<std::size_t>(UnionType::UNKNOWN) + 1;
+constexpr std::size_t kRegionCount = static_cast<std::size_t>(RegionType::UNKNOWN) + 1;
+
+// Spellings used by league files and reports (keep in enum order).
+constexpr const char* kUnionNames[kUnionCount] = {"ATLANTIC", "PACIFIC", "UNKNOWN"};
+constexpr const char* kRegionNames[kRegionCount] = {
+    "KEYSTONE", "TIDEWATER", "THE_CONFLUENCE", "GOLDEN_PENNANT", "CASCADE_TERRITORY",
+    "THE_SUNSTONE_DIVISION", "THE_HEARTLAND_CORE", "UNKNOWN"};
+
+inline const char* unionName(UnionType type) { return kUnionNames[static_cast<std::size_t>(type)]; }
+inline const char* regionName(RegionType type) { return kRegionNames[static_cast<std::size_t>(type)]; }
+
+// The union each region belongs to.
+constexpr UnionType kRegionUnion[kRegionCount] = {
+    UnionType::ATLANTIC, UnionType::ATLANTIC, UnionType::ATLANTIC,                       // Keystone, Tidewater, Confluence
+    UnionType::PACIFIC, UnionType::PACIFIC, UnionType::PACIFIC, UnionType::PACIFIC,      // Golden Pennant .. Heartland
+    UnionType::UNKNOWN};
+
+struct RegionRivalry {
+    RegionType first;
+    RegionType second;
+};
+
+// Standing cross-union rivalries (the Heartland-Confluence series).
+constexpr RegionRivalry kRegionRivalries[] = {
+    {RegionType::THE_HEARTLAND_CORE, RegionType::THE_CONFLUENCE},
+};
+
+// Relationship bits between two teams (see LeagueTopology::pairFlags).
+enum MatchupFlag : std::uint8_t {
+    kSameUnion = 1u << 0,
+    kSameRegion = 1u << 1,
+    kRivalry = 1u << 2,
+};
+
+namespace detail {
+
+constexpr std::array<std::uint8_t, kUnionCount> makeUnionRegionMasks() {
+    std::array<std::uint8_t, kUnionCount> masks{};
+    for (std::size_t r = 0; r + 1 < kRegionCount; ++r) {
+        masks[static_cast<std::size_t>(kRegionUnion[r])] |= static_cast<std::uint8_t>(1u << r);
+    }
+    masks[static_cast<std::size_t>(UnionType::UNKNOWN)] = 0;
+    return masks;
+}
+
+// [a][b]: kSameRegion / kRivalry for teams of regions a and b. UNKNOWN
+// relates to nothing, not even itself.
+constexpr std::array<std::array<std::uint8_t, kRegionCount>, kRegionCount> makeRegionPairFlags() {
+    std::array<std::array<std::uint8_t, kRegionCount>, kRegionCount> flags{};
+    for (std::size_t r = 0; r + 1 < kRegionCount; ++r) {
+        flags[r][r] = kSameRegion;
+    }
+    for (const RegionRivalry& rivalry : kRegionRivalries) {
+        const std::size_t a = static_cast<std::size_t>(rivalry.first);
+        const std::size_t b = static_cast<std::size_t>(rivalry.second);
+        flags[a][b] |= kRivalry;
+        flags[b][a] |= kRivalry;
+    }
+    return flags;
+}
+
+} // namespace detail
+
+// Bit r is set if region r belongs to the union.
+constexpr std::array<std::uint8_t, kUnionCount> kUnionRegionMasks = detail::makeUnionRegionMasks();
+constexpr std::array<std::array<std::uint8_t, kRegionCount>, kRegionCount> kRegionPairFlags =
+    detail::makeRegionPairFlags();
+
+static_assert(kRegionCount <= 8 && kUnionCount <= 8, "Region and union masks are one byte");
+static_assert((kUnionRegionMasks[0] & kUnionRegionMasks[1]) == 0, "A region belongs to one union");
+static_assert(kRegionPairFlags[static_cast<std::size_t>(RegionType::THE_CONFLUENCE)]
+                              [static_cast<std::size_t>(RegionType::THE_HEARTLAND_CORE)] == kRivalry,
+              "Heartland-Confluence is a rivalry");
+
+// --- Per-league topology -------------------------------------------------
+
+// Read-only run of team handles (a CSR row of LeagueTopology).
+class TeamIdRange {
+public:
+    TeamIdRange(const TeamId* first, const TeamId* last) : first_(first), last_(last) {}
+    const TeamId* begin() const { return first_; }
+    const TeamId* end() const { return last_; }
+    std::size_t size() const { return static_cast<std::size_t>(last_ - first_); }
+    bool empty() const { return first_ == last_; }
+    TeamId operator[](std::size_t i) const { return first_[i]; }
+
+private:
+    const TeamId* first_;
+    const TeamId* last_;
+};
+
+// A league's union and region structure, indexed by TeamId.
+//
+// Built once from a registry (one pass), after which every membership or
+// matchup question is an array lookup or a mask test, with no branching on
+// enums: teams are stored as one-hot union and region bytes, members of each
+// union and region as contiguous CSR rows in TeamId order, and pair
+// relationships come from the compile-time kRegionPairFlags table.
+//
+//   LeagueTopology topology(registry);
+//   for (TeamId t : topology.regionMembers(RegionType::KEYSTONE)) ...
+//   if (topology.pairFlags(a, b) & kRivalry) ...
+class LeagueTopology {
+public:
+    LeagueTopology() = default;
+    explicit LeagueTopology(const TeamRegistry& teams) {
+        const std::size_t n = teams.size();
+        region_.resize(n);
+        union_bit_.resize(n);
+        region_bit_.resize(n);
+        std::array<std::uint32_t, kUnionCount + 1> union_offsets{};
+        std::array<std::uint32_t, kRegionCount + 1> region_offsets{};
+        for (std::size_t t = 0; t < n; ++t) {
+            const Team& team = teams[static_cast<TeamId>(t)];
+            const std::size_t u = static_cast<std::size_t>(team.union_type);
+            const std::size_t r = static_cast<std::size_t>(team.region_type);
+            region_[t] = static_cast<std::uint8_t>(r);
+            union_bit_[t] = static_cast<std::uint8_t>((1u << u) & kKnownUnionBits);
+            region_bit_[t] = static_cast<std::uint8_t>((1u << r) & kKnownRegionBits);
+            ++union_offsets[u + 1];
+            ++region_offsets[r + 1];
+        }
+        for (std::size_t i = 1; i < union_offsets.size(); ++i) {
+            union_offsets[i] += union_offsets[i - 1];
+        }
+        for (std::size_t i = 1; i < region_offsets.size(); ++i) {
+            region_offsets[i] += region_offsets[i - 1];
+        }
+        union_offsets_ = union_offsets;
+        region_offsets_ = region_offsets;
+        union_members_.resize(n);
+        region_members_.resize(n);
+        for (std::size_t t = 0; t < n; ++t) {
+            union_members_[union_offsets[static_cast<std::size_t>(teams[static_cast<TeamId>(t)].union_type)]++] =
+                static_cast<TeamId>(t);
+            region_members_[region_offsets[static_cast<std::size_t>(teams[static_cast<TeamId>(t)].region_type)]++] =
+                static_cast<TeamId>(t);
+        }
+    }
+
+    std::size_t teamCount() const { return region_.size(); }
+
+    // Members in TeamId order (teams with an UNKNOWN union or region are listed under UNKNOWN).
+    TeamIdRange unionMembers(UnionType type) const {
+        const std::size_t u = static_cast<std::size_t>(type);
+        return TeamIdRange(union_members_.data() + union_offsets_[u], union_members_.data() + union_offsets_[u + 1]);
+    }
+    TeamIdRange regionMembers(RegionType type) const {
+        const std::size_t r = static_cast<std::size_t>(type);
+        return TeamIdRange(region_members_.data() + region_offsets_[r], region_members_.data() + region_offsets_[r + 1]);
+    }
+
+    RegionType region(TeamId team) const { return static_cast<RegionType>(region_[team]); }
+    // RegionType of every team as a byte, for kernels indexing kRegionPairFlags-style tables.
+    const std::uint8_t* regionIndices() const { return region_.data(); }
+
+    // One-hot masks (0 for UNKNOWN).
+    std::uint8_t unionBit(TeamId team) const { return union_bit_[team]; }
+    std::uint8_t regionBit(TeamId team) const { return region_bit_[team]; }
+    bool inUnion(TeamId team, UnionType type) const { return (union_bit_[team] >> static_cast<unsigned>(type)) & 1u; }
+    bool inRegion(TeamId team, RegionType type) const { return (region_bit_[team] >> static_cast<unsigned>(type)) & 1u; }
+
+    // MatchupFlag bits for a game between `a` and `b`.
+    std::uint8_t pairFlags(TeamId a, TeamId b) const {
+        return static_cast<std::uint8_t>(kRegionPairFlags[region_[a]][region_[b]] |
+                                         static_cast<std::uint8_t>((union_bit_[a] & union_bit_[b]) != 0));
+    }
+
+private:
+    static constexpr unsigned kKnownUnionBits = (1u << (kUnionCount - 1)) - 1;
+    static constexpr unsigned kKnownRegionBits = (1u << (kRegionCount - 1)) - 1;
+
+    std::vector<std::uint8_t> region_;       // RegionType per team
+    std::vector<std::uint8_t> union_bit_;    // 1 << UnionType, 0 for UNKNOWN
+    std::vector<std::uint8_t> region_bit_;   // 1 << RegionType, 0 for UNKNOWN
+    std::array<std::uint32_t, kUnionCount + 1> union_offsets_{};   // Union u: members [offsets[u], offsets[u + 1])
+    std::array<std::uint32_t, kRegionCount + 1> region_offsets_{};
+    std::vector<TeamId> union_members_;
+    std::vector<TeamId> region_members_;
+};
+
+} // namespace LeagueSchedulerNS
+
+#endif // LEAGUE_TOPOLOGY_H
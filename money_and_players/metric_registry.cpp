@@ -0,0 +1,69 @@
+/**
+ * @file metric_registry.cpp
+ * @brief Process-wide interning of performance metric names.
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "metric_registry.h"
+
+MetricRegistry& MetricRegistry::global() {
+    static MetricRegistry registry;
+    return registry;
+}
+
+MetricRegistry::MetricRegistry() {
+    // Order must match the constants in the Metrics namespace.
+    intern("batting_average", MetricStorage::DENSE);
+    intern("era", MetricStorage::DENSE);
+    intern("wins_above_replacement", MetricStorage::DENSE);
+}
+
+MetricId MetricRegistry::intern(const std::string& name, MetricStorage storage) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = ids_.find(name);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+    const MetricId id = static_cast<MetricId>(names_.size());
+    names_.push_back(name);
+    storage_.push_back(storage);
+    ids_.emplace(name, id);
+    return id;
+}
+
+MetricId MetricRegistry::find(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = ids_.find(name);
+    return it == ids_.end() ? static_cast<MetricId>(names_.size()) : it->second;
+}
+
+const std::string& MetricRegistry::name(MetricId id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return names_[id];
+}
+
+MetricStorage MetricRegistry::storage(MetricId id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return id < storage_.size() ? storage_[id] : MetricStorage::SPARSE;
+}
+
+std::size_t MetricRegistry::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return names_.size();
+}
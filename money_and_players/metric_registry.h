@@ -0,0 +1,103 @@
+#ifndef METRIC_REGISTRY_H
+#define METRIC_REGISTRY_H
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Small integer id for an interned performance metric name.
+using MetricId = std::uint16_t;
+
+// Well-known metrics, interned up front so hot code can use the ids directly.
+namespace Metrics {
+constexpr MetricId BATTING_AVERAGE = 0;        // "batting_average"
+constexpr MetricId ERA = 1;                    // "era"
+constexpr MetricId WINS_ABOVE_REPLACEMENT = 2; // "wins_above_replacement"
+} // namespace Metrics
+
+// How a metric is stored in a MetricStore.
+// DENSE metrics get one contiguous column across all players (fast
+// leaderboards); SPARSE metrics live in a hash map keyed by (player, metric)
+// and are promoted to a dense column once enough players carry them.
+enum class MetricStorage {
+    DENSE,
+    SPARSE
+};
+
+// Process-wide schema that interns metric names to MetricIds once.
+// Interning is thread-safe; ids are never reused or reordered.
+class MetricRegistry {
+public:
+    // The shared registry used by Player, PlayerTable and MetricStore.
+    static MetricRegistry& global();
+
+    // Returns the id for `name`, registering it if needed.
+    MetricId intern(const std::string& name, MetricStorage storage = MetricStorage::SPARSE);
+
+    // Returns the id for `name`, or size() if it has not been interned.
+    MetricId find(const std::string& name) const;
+
+    const std::string& name(MetricId id) const;
+    MetricStorage storage(MetricId id) const;
+    std::size_t size() const;
+
+private:
+    MetricRegistry();
+
+    mutable std::mutex mutex_;
+    std::deque<std::string> names_; // deque: references stay valid as metrics are added
+    std::vector<MetricStorage> storage_;
+    std::unordered_map<std::string, MetricId> ids_;
+};
+
+// A player's own metric values as a small flat (id, value) list.
+// Used by the standalone Player record; copying it is a single allocation
+// instead of rebuilding a tree of string keys.
+class MetricValues {
+public:
+    // Returns a reference to the value for `id`, inserting 0.0 if missing.
+    double& operator[](MetricId id) {
+        for (auto& entry : values_) {
+            if (entry.first == id) {
+                return entry.second;
+            }
+        }
+        values_.emplace_back(id, 0.0);
+        return values_.back().second;
+    }
+    double& operator[](const std::string& name) {
+        return (*this)[MetricRegistry::global().intern(name)];
+    }
+
+    // Returns the value for `id`, or `fallback` if missing.
+    double get(MetricId id, double fallback = 0.0) const {
+        for (const auto& entry : values_) {
+            if (entry.first == id) {
+                return entry.second;
+            }
+        }
+        return fallback;
+    }
+    bool contains(MetricId id) const {
+        for (const auto& entry : values_) {
+            if (entry.first == id) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::size_t size() const { return values_.size(); }
+    bool empty() const { return values_.empty(); }
+    std::vector<std::pair<MetricId, double>>::const_iterator begin() const { return values_.begin(); }
+    std::vector<std::pair<MetricId, double>>::const_iterator end() const { return values_.end(); }
+
+private:
+    std::vector<std::pair<MetricId, double>> values_;
+};
+
+#endif // METRIC_REGISTRY_H
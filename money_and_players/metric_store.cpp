@@ -0,0 +1,167 @@
+/**
+ * @file metric_store.cpp
+ * @brief Dense/sparse storage of per-player performance metrics.
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "metric_store.h"
+#include <algorithm>
+
+namespace {
+const double kMissing = std::numeric_limits<double>::quiet_NaN();
+} // namespace
+
+void MetricStore::resize(std::size_t rows) {
+    rows_ = rows;
+    for (auto& column : dense_) {
+        column.resize(rows, kMissing);
+    }
+}
+
+void MetricStore::reserve(std::size_t rows) {
+    reserved_ = rows;
+    for (auto& column : dense_) {
+        column.reserve(rows);
+    }
+}
+
+void MetricStore::clear() {
+    rows_ = 0;
+    dense_slot_.clear();
+    dense_.clear();
+    sparse_.clear();
+    sparse_count_.clear();
+}
+
+double* MetricStore::mutableDenseColumn(MetricId metric) {
+    if (metric < dense_slot_.size() && dense_slot_[metric] >= 0) {
+        return dense_[static_cast<std::size_t>(dense_slot_[metric])].data();
+    }
+    if (MetricRegistry::global().storage(metric) == MetricStorage::DENSE) {
+        makeDense(metric);
+        return dense_.back().data();
+    }
+    return nullptr;
+}
+
+void MetricStore::makeDense(MetricId metric) {
+    if (metric >= dense_slot_.size()) {
+        dense_slot_.resize(metric + 1u, -1);
+    }
+    if (dense_slot_[metric] >= 0) {
+        return;
+    }
+    dense_slot_[metric] = static_cast<int>(dense_.size());
+    dense_.emplace_back();
+    AlignedVector<double>& column = dense_.back();
+    column.reserve(std::max(reserved_, rows_));
+    column.assign(rows_, kMissing);
+
+    // Move any sparse values for this metric into the new column.
+    if (metric < sparse_count_.size() && sparse_count_[metric] > 0) {
+        for (auto it = sparse_.begin(); it != sparse_.end();) {
+            if (static_cast<MetricId>(it->first & 0xFFFF) == metric) {
+                column[static_cast<std::size_t>(it->first >> 16)] = it->second;
+                it = sparse_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        sparse_count_[metric] = 0;
+    }
+}
+
+void MetricStore::noteSparseInsert(MetricId metric) {
+    if (metric >= sparse_count_.size()) {
+        sparse_count_.resize(metric + 1u, 0);
+    }
+    ++sparse_count_[metric];
+}
+
+double& MetricStore::ref(PlayerRow row, MetricId metric) {
+    if (double* column = mutableDenseColumn(metric)) {
+        double& v = column[row];
+        if (std::isnan(v)) {
+            v = 0.0;
+        }
+        return v;
+    }
+    auto inserted = sparse_.emplace(key(row, metric), 0.0);
+    if (inserted.second) {
+        noteSparseInsert(metric);
+        // Promote once the metric is common enough that a column is cheaper.
+        if (rows_ >= 16 && sparse_count_[metric] > rows_ / 4) {
+            makeDense(metric);
+            return dense_[static_cast<std::size_t>(dense_slot_[metric])][row];
+        }
+    }
+    return inserted.first->second;
+}
+
+void MetricStore::erase(PlayerRow row, MetricId metric) {
+    if (metric < dense_slot_.size() && dense_slot_[metric] >= 0) {
+        dense_[static_cast<std::size_t>(dense_slot_[metric])][row] = kMissing;
+        return;
+    }
+    if (sparse_.erase(key(row, metric)) > 0) {
+        --sparse_count_[metric];
+    }
+}
+
+std::size_t MetricStore::leaderboard(MetricId metric, std::size_t k, std::vector<PlayerRow>& out,
+                                     bool descending) const {
+    out.clear();
+    if (const double* column = denseColumn(metric)) {
+        // One pass over the contiguous column, then a partial sort of the candidates.
+        for (std::size_t i = 0; i < rows_; ++i) {
+            if (!std::isnan(column[i])) {
+                out.push_back(static_cast<PlayerRow>(i));
+            }
+        }
+        auto better = [&](PlayerRow a, PlayerRow b) {
+            if (column[a] != column[b]) {
+                return descending ? column[a] > column[b] : column[a] < column[b];
+            }
+            return a < b;
+        };
+        const std::size_t n = std::min(k, out.size());
+        std::partial_sort(out.begin(), out.begin() + static_cast<std::ptrdiff_t>(n), out.end(), better);
+        out.resize(n);
+        return n;
+    }
+
+    std::vector<std::pair<double, PlayerRow>> candidates;
+    for (const auto& entry : sparse_) {
+        if (static_cast<MetricId>(entry.first & 0xFFFF) == metric) {
+            candidates.emplace_back(entry.second, static_cast<PlayerRow>(entry.first >> 16));
+        }
+    }
+    auto better = [&](const std::pair<double, PlayerRow>& a, const std::pair<double, PlayerRow>& b) {
+        if (a.first != b.first) {
+            return descending ? a.first > b.first : a.first < b.first;
+        }
+        return a.second < b.second;
+    };
+    const std::size_t n = std::min(k, candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + static_cast<std::ptrdiff_t>(n), candidates.end(), better);
+    for (std::size_t i = 0; i < n; ++i) {
+        out.push_back(candidates[i].second);
+    }
+    return n;
+}
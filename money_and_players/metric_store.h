@@ -0,0 +1,125 @@
+#ifndef METRIC_STORE_H
+#define METRIC_STORE_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "aligned_allocator.h"
+#include "metric_registry.h"
+
+// Row index of a player inside a PlayerTable.
+using PlayerRow = std::uint32_t;
+
+// Performance metric values for every player of a PlayerTable.
+// DENSE metrics are one aligned column per metric across all rows; a missing
+// value is stored as NaN. SPARSE metrics live in a hash map keyed by
+// (row, metric) and are promoted to a dense column once more than a quarter
+// of the rows carry them. Reads and writes by (row, metric) are O(1).
+class MetricStore {
+public:
+    MetricStore() = default;
+
+    // Keeps every dense column sized to the table's row count.
+    void resize(std::size_t rows);
+    void reserve(std::size_t rows);
+    void clear();
+    std::size_t rows() const { return rows_; }
+
+    bool has(PlayerRow row, MetricId metric) const {
+        if (const double* column = denseColumn(metric)) {
+            return !std::isnan(column[row]);
+        }
+        return sparse_.find(key(row, metric)) != sparse_.end();
+    }
+
+    // Returns the value, or `fallback` if the player has no value for it.
+    double get(PlayerRow row, MetricId metric, double fallback = 0.0) const {
+        if (const double* column = denseColumn(metric)) {
+            const double v = column[row];
+            return std::isnan(v) ? fallback : v;
+        }
+        auto it = sparse_.find(key(row, metric));
+        return it == sparse_.end() ? fallback : it->second;
+    }
+
+    void set(PlayerRow row, MetricId metric, double value) { ref(row, metric) = value; }
+
+    // Returns a writable reference, inserting 0.0 if missing.
+    // Like a std::vector reference, it is invalidated when rows are added
+    // or the metric is promoted to dense storage.
+    double& ref(PlayerRow row, MetricId metric);
+
+    // Removes a value (dense: stores NaN).
+    void erase(PlayerRow row, MetricId metric);
+
+    // The contiguous column for a dense metric, or nullptr if it is sparse.
+    const double* denseColumn(MetricId metric) const {
+        if (metric < dense_slot_.size() && dense_slot_[metric] >= 0) {
+            return dense_[static_cast<std::size_t>(dense_slot_[metric])].data();
+        }
+        return nullptr;
+    }
+
+    // Forces a metric into a dense column (e.g., before bulk updates).
+    void makeDense(MetricId metric);
+
+    // Writes the `k` best rows for `metric` into `out` (best first) and returns
+    // how many were written. Rows without a value are skipped. Use
+    // `descending = false` for lower-is-better metrics such as ERA.
+    std::size_t leaderboard(MetricId metric, std::size_t k, std::vector<PlayerRow>& out,
+                            bool descending = true) const;
+
+private:
+    static std::uint64_t key(PlayerRow row, MetricId metric) {
+        return (static_cast<std::uint64_t>(row) << 16) | metric;
+    }
+    double* mutableDenseColumn(MetricId metric);
+    void noteSparseInsert(MetricId metric);
+
+    std::size_t rows_ = 0;
+    std::size_t reserved_ = 0;
+    std::vector<int> dense_slot_;                 // MetricId -> index into dense_, -1 if sparse
+    std::vector<AlignedVector<double>> dense_;    // One column per dense metric
+    std::unordered_map<std::uint64_t, double> sparse_;
+    std::vector<std::uint32_t> sparse_count_;     // Per-metric sparse population, for promotion
+};
+
+// The metrics of one PlayerTable row, addressed through the table's MetricStore.
+// This is what `PlayerRef::performance_metrics` is, so
+// `player.performance_metrics["era"] = 3.1` keeps working on table rows.
+template <bool Const>
+class BasicMetricsRef {
+public:
+    using Store = std::conditional_t<Const, const MetricStore, MetricStore>;
+
+    BasicMetricsRef(Store& store, PlayerRow row) : store_(&store), row_(row) {}
+
+    template <bool C = Const, typename = std::enable_if_t<!C>>
+    double& operator[](MetricId metric) const { return store_->ref(row_, metric); }
+    template <bool C = Const, typename = std::enable_if_t<!C>>
+    double& operator[](const std::string& name) const {
+        return store_->ref(row_, MetricRegistry::global().intern(name));
+    }
+
+    double get(MetricId metric, double fallback = 0.0) const { return store_->get(row_, metric, fallback); }
+    bool contains(MetricId metric) const { return store_->has(row_, metric); }
+    double at(const std::string& name, double fallback = 0.0) const {
+        MetricRegistry& registry = MetricRegistry::global();
+        MetricId metric = registry.find(name);
+        return metric < registry.size() ? store_->get(row_, metric, fallback) : fallback;
+    }
+
+private:
+    Store* store_;
+    PlayerRow row_;
+};
+
+using MetricsRef = BasicMetricsRef<false>;
+using ConstMetricsRef = BasicMetricsRef<true>;
+
+#endif // METRIC_STORE_H
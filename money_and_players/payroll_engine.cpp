@@ -0,0 +1,285 @@
+/**
+ * @file payroll_engine.cpp
+ * @brief Batch payroll, luxury-tax and market-value projection engine with what-if scenarios.
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "payroll_engine.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "work_stealing_pool.h"
+
+namespace LeagueSchedulerNS {
+
+namespace {
+
+// Projects kWidth consecutive rows. Every loop has a compile-time trip count
+// and no branches, so each lane loop becomes a handful of vector instructions.
+template <std::size_t kWidth>
+void projectChunk(const double* skill, const int* age, const std::uint8_t* star, const long long* market_value,
+                  const ValuationModel& model, std::size_t out_stride, double* out) {
+    double growth[kWidth];
+    double base_age[kWidth];
+    double scale[kWidth];
+    double compound[kWidth];
+    for (std::size_t lane = 0; lane < kWidth; ++lane) {
+        growth[lane] = 1.0 + model.skill_growth * (skill[lane] - model.skill_reference) / 100.0 +
+                       model.star_growth * static_cast<double>(star[lane]);
+        base_age[lane] = static_cast<double>(age[lane]);
+        const double offset = base_age[lane] - model.peak_age;
+        const double curve = std::max(model.min_age_factor, 1.0 - model.age_curvature * offset * offset);
+        scale[lane] = static_cast<double>(market_value[lane]) / curve;
+        compound[lane] = 1.0;
+    }
+    for (int year = 1; year <= model.projection_years; ++year) {
+        double* row = out + static_cast<std::size_t>(year - 1) * out_stride;
+        for (std::size_t lane = 0; lane < kWidth; ++lane) {
+            compound[lane] *= growth[lane];
+            const double offset = base_age[lane] + year - model.peak_age;
+            const double curve = std::max(model.min_age_factor, 1.0 - model.age_curvature * offset * offset);
+            row[lane] = scale[lane] * curve * compound[lane];
+        }
+    }
+}
+
+} // namespace
+
+void projectMarketValues(const double* skill, const int* age, const std::uint8_t* star, const long long* market_value,
+                         std::size_t count, const ValuationModel& model, double* out) {
+    constexpr std::size_t kLanes = PayrollEngine::kLanes;
+    std::size_t i = 0;
+    for (; i + kLanes <= count; i += kLanes) {
+        projectChunk<kLanes>(skill + i, age + i, star + i, market_value + i, model, count, out + i);
+    }
+    for (; i < count; ++i) {
+        projectChunk<1>(skill + i, age + i, star + i, market_value + i, model, count, out + i);
+    }
+}
+
+std::uint32_t PayrollEngine::addLeague(const TeamRegistry& teams) {
+    leagues_.push_back(League{&teams, team_count_, row_count_, teams.players().size()});
+    team_count_ += teams.size();
+    row_count_ += teams.players().size();
+    return static_cast<std::uint32_t>(leagues_.size() - 1);
+}
+
+void PayrollEngine::evaluate() {
+    const int years = std::max(0, model_.projection_years);
+    const std::size_t year_count = static_cast<std::size_t>(years);
+
+    // Leagues may have grown since addLeague(); re-lay out the row offsets.
+    team_count_ = 0;
+    row_count_ = 0;
+    for (League& league : leagues_) {
+        league.first_team = team_count_;
+        league.first_row = row_count_;
+        league.row_count = league.teams->players().size();
+        team_count_ += league.teams->size();
+        row_count_ += league.row_count;
+    }
+
+    baseline_.projection_years = years;
+    baseline_.payroll.assign(team_count_, 0);
+    baseline_.market_value.assign(team_count_, 0);
+    baseline_.luxury_tax.assign(team_count_, 0);
+    baseline_.projected_value.assign(team_count_ * year_count, 0.0);
+    row_team_.assign(row_count_, 0xFFFFFFFFu);
+    row_league_.assign(row_count_, 0);
+    row_salary_.resize(row_count_);
+    row_market_value_.resize(row_count_);
+    row_projection_.resize(row_count_ * year_count);
+
+    for (std::size_t l = 0; l < leagues_.size(); ++l) {
+        const League& league = leagues_[l];
+        const PlayerTable& table = league.teams->players();
+        std::copy(table.salaries(), table.salaries() + league.row_count, row_salary_.begin() + league.first_row);
+        std::copy(table.marketValues(), table.marketValues() + league.row_count,
+                  row_market_value_.begin() + league.first_row);
+        std::fill(row_league_.begin() + league.first_row, row_league_.begin() + league.first_row + league.row_count,
+                  static_cast<std::uint32_t>(l));
+        double* projection = row_projection_.data() + league.first_row * year_count;
+        if (years > 0) {
+            projectMarketValues(table.skillRatings(), table.ages(), table.starFlags(), table.marketValues(),
+                                league.row_count, model_, projection);
+        }
+
+        for (std::size_t t = 0; t < league.teams->size(); ++t) {
+            const Team& team = (*league.teams)[static_cast<TeamId>(t)];
+            const std::size_t global_team = league.first_team + t;
+            const PlayerRow first = team.players.firstRow();
+            const PlayerRow last = team.players.endRow();
+            std::fill(row_team_.begin() + league.first_row + first, row_team_.begin() + league.first_row + last,
+                      static_cast<std::uint32_t>(global_team));
+            baseline_.payroll[global_team] = sumSalaries(table, first, last);
+            baseline_.market_value[global_team] = sumMarketValues(table, first, last);
+            for (std::size_t y = 0; y < year_count; ++y) {
+                const double* values = projection + y * league.row_count;
+                double total = 0.0;
+                for (PlayerRow r = first; r < last; ++r) {
+                    total += values[r];
+                }
+                baseline_.projected_value[global_team * year_count + y] = total;
+            }
+            baseline_.luxury_tax[global_team] = luxuryTax(baseline_.payroll[global_team]);
+        }
+    }
+}
+
+ScenarioResult PayrollEngine::evaluateScenario(const Scenario& scenario) const {
+    validate(scenario);
+    const std::size_t years = static_cast<std::size_t>(baseline_.projection_years);
+    ScenarioResult result;
+    PayrollSummary& changed = result.changed;
+    changed.projection_years = baseline_.projection_years;
+
+    // Position of `team` in the result, copying its baseline aggregates in on first touch.
+    auto slot = [&](std::size_t team) {
+        auto it = std::find(result.teams.begin(), result.teams.end(), team);
+        if (it != result.teams.end()) {
+            return static_cast<std::size_t>(it - result.teams.begin());
+        }
+        result.teams.push_back(team);
+        changed.payroll.push_back(baseline_.payroll[team]);
+        changed.market_value.push_back(baseline_.market_value[team]);
+        changed.luxury_tax.push_back(baseline_.luxury_tax[team]);
+        changed.projected_value.insert(changed.projected_value.end(),
+                                       baseline_.projected_value.begin() + static_cast<std::ptrdiff_t>(team * years),
+                                       baseline_.projected_value.begin() + static_cast<std::ptrdiff_t>((team + 1) * years));
+        return result.teams.size() - 1;
+    };
+
+    // Current salary and team of every player the scenario has touched so far
+    // (edits compose, e.g. a new contract and then a trade).
+    struct Edited {
+        std::size_t row;
+        long long salary;
+        std::size_t team;
+    };
+    std::vector<Edited> edited;
+
+    for (const ScenarioEdit& edit : scenario) {
+        const std::size_t row = globalRow(edit.player);
+        auto it = std::find_if(edited.begin(), edited.end(), [&](const Edited& e) { return e.row == row; });
+        if (it == edited.end()) {
+            edited.push_back(Edited{row, row_salary_[row], row_team_[row]});
+            it = edited.end() - 1;
+        }
+        if (it->team >= team_count_) {
+            continue;  // Row not on any roster
+        }
+        if (edit.kind == ScenarioEdit::Kind::CONTRACT) {
+            changed.payroll[slot(it->team)] += edit.new_salary - it->salary;
+            it->salary = edit.new_salary;
+        } else {
+            const std::size_t to_team = destinationTeam(edit);
+            if (to_team == it->team) {
+                continue;
+            }
+            const std::size_t from = slot(it->team);
+            const std::size_t to = slot(to_team);
+            changed.payroll[from] -= it->salary;
+            changed.payroll[to] += it->salary;
+            changed.market_value[from] -= row_market_value_[row];
+            changed.market_value[to] += row_market_value_[row];
+            for (std::size_t y = 0; y < years; ++y) {
+                const double value = rowProjection(row, static_cast<int>(y) + 1);
+                changed.projected_value[from * years + y] -= value;
+                changed.projected_value[to * years + y] += value;
+            }
+            it->team = to_team;
+        }
+    }
+
+    for (std::size_t i = 0; i < result.teams.size(); ++i) {
+        changed.luxury_tax[i] = luxuryTax(changed.payroll[i]);
+        result.luxury_tax_delta += changed.luxury_tax[i] - baseline_.luxury_tax[result.teams[i]];
+    }
+
+    return result;
+}
+
+std::vector<ScenarioResult> PayrollEngine::evaluateScenarios(const std::vector<Scenario>& scenarios,
+                                                             unsigned threads) const {
+    for (const Scenario& scenario : scenarios) {
+        validate(scenario);
+    }
+    std::vector<ScenarioResult> results(scenarios.size());
+    WorkStealingPool pool(threads);
+    pool.parallelFor(scenarios.size(), 64, [&](std::size_t begin, std::size_t end, unsigned) {
+        for (std::size_t i = begin; i < end; ++i) {
+            results[i] = evaluateScenario(scenarios[i]);
+        }
+    });
+    return results;
+}
+
+PayrollSummary PayrollEngine::applyResult(const ScenarioResult& result) const {
+    PayrollSummary summary = baseline_;
+    const std::size_t years = static_cast<std::size_t>(baseline_.projection_years);
+    for (std::size_t i = 0; i < result.teams.size(); ++i) {
+        const std::size_t team = result.teams[i];
+        summary.payroll[team] = result.changed.payroll[i];
+        summary.market_value[team] = result.changed.market_value[i];
+        summary.luxury_tax[team] = result.changed.luxury_tax[i];
+        std::copy(result.changed.projected_value.begin() + static_cast<std::ptrdiff_t>(i * years),
+                  result.changed.projected_value.begin() + static_cast<std::ptrdiff_t>((i + 1) * years),
+                  summary.projected_value.begin() + static_cast<std::ptrdiff_t>(team * years));
+    }
+    return summary;
+}
+
+std::size_t PayrollEngine::globalRow(const PlayerHandle& player) const {
+    if (player.league >= leagues_.size() || player.row >= leagues_[player.league].row_count ||
+        leagues_[player.league].first_row + player.row >= row_team_.size()) {
+        throw std::out_of_range("PayrollEngine: player handle outside the evaluated leagues");
+    }
+    return leagues_[player.league].first_row + player.row;
+}
+
+std::size_t PayrollEngine::destinationTeam(const ScenarioEdit& edit) const {
+    const League& league = leagues_[edit.player.league];
+    if (edit.to_team >= league.teams->size() || league.first_team + edit.to_team >= baseline_.teamCount()) {
+        throw std::out_of_range("PayrollEngine: trade to a team outside the player's league");
+    }
+    return league.first_team + edit.to_team;
+}
+
+void PayrollEngine::validate(const Scenario& scenario) const {
+    for (const ScenarioEdit& edit : scenario) {
+        globalRow(edit.player);
+        if (edit.kind == ScenarioEdit::Kind::TRADE) {
+            destinationTeam(edit);
+        }
+    }
+}
+
+long long PayrollEngine::luxuryTax(long long payroll) const {
+    const long long over = payroll - model_.luxury_threshold;
+    return over > 0 ? std::llround(static_cast<double>(over) * model_.luxury_tax_rate) : 0;
+}
+
+double PayrollEngine::rowProjection(std::size_t row, int year) const {
+    const League& league = leagues_[row_league_[row]];
+    const std::size_t years = static_cast<std::size_t>(baseline_.projection_years);
+    return row_projection_[league.first_row * years + static_cast<std::size_t>(year - 1) * league.row_count +
+                           (row - league.first_row)];
+}
+
+} // namespace LeagueSchedulerNS
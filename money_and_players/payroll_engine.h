@@ -0,0 +1,173 @@
+#ifndef PAYROLL_ENGINE_H
+#define PAYROLL_ENGINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "player_table.h"
+#include "team_registry.h"
+
+namespace LeagueSchedulerNS {
+
+// Market-value and payroll model for the "Money and Players" concept.
+//
+// A player's projected market value in year y (y = 1 .. projection_years) is
+//
+//   value_y = market_value * ageCurve(age + y) / ageCurve(age) * yearly_growth^y
+//   ageCurve(a)   = max(min_age_factor, 1 - age_curvature * (a - peak_age)^2)
+//   yearly_growth = 1 + skill_growth * (skill_rating - skill_reference) / 100
+//                     + star_growth * is_star_player
+//
+// so young high-skill players appreciate and veterans past the peak decline.
+struct ValuationModel {
+    int projection_years = 5;
+    double peak_age = 27.0;
+    double age_curvature = 0.004;       // Share of value lost per squared year away from the peak
+    double min_age_factor = 0.15;
+    double skill_reference = 75.0;      // Skill at which value neither grows nor shrinks with skill
+    double skill_growth = 0.10;         // Yearly growth per 100 skill points above the reference
+    double star_growth = 0.03;          // Extra yearly growth for star players
+    long long luxury_threshold = 20000000;  // Payroll above this is taxed
+    double luxury_tax_rate = 0.5;       // Tax per dollar above the threshold
+};
+
+// Per-team aggregates for every team of every league in the engine, indexed by
+// the engine's global team index (see PayrollEngine::teamIndex).
+struct PayrollSummary {
+    int projection_years = 0;
+    std::vector<long long> payroll;
+    std::vector<long long> market_value;
+    std::vector<long long> luxury_tax;        // 0 when the payroll is at or under the threshold
+    std::vector<double> projected_value;      // [team * projection_years + (year - 1)]
+
+    std::size_t teamCount() const { return payroll.size(); }
+    bool overLuxuryThreshold(std::size_t team) const { return luxury_tax[team] > 0; }
+    double projectedValue(std::size_t team, int year) const {
+        return projected_value[team * static_cast<std::size_t>(projection_years) + static_cast<std::size_t>(year - 1)];
+    }
+};
+
+// A player of one league in the engine.
+struct PlayerHandle {
+    std::uint32_t league = 0;
+    PlayerRow row = 0;      // Row in that league's PlayerTable
+};
+
+// One what-if edit. A scenario is a list of edits applied together.
+struct ScenarioEdit {
+    enum class Kind {
+        CONTRACT,   // Player's salary becomes `new_salary`
+        TRADE       // Player moves to `to_team` (a TeamId in the player's own league)
+    };
+
+    Kind kind = Kind::CONTRACT;
+    PlayerHandle player;
+    long long new_salary = 0;
+    TeamId to_team = kInvalidTeamId;
+
+    static ScenarioEdit contract(PlayerHandle player, long long salary) {
+        return {Kind::CONTRACT, player, salary, kInvalidTeamId};
+    }
+    static ScenarioEdit trade(PlayerHandle player, TeamId to_team) {
+        return {Kind::TRADE, player, 0, to_team};
+    }
+};
+
+using Scenario = std::vector<ScenarioEdit>;
+
+// Outcome of one scenario: aggregates of the teams it changed. Every other
+// team is exactly as in the baseline.
+struct ScenarioResult {
+    std::vector<std::size_t> teams;   // Changed teams (global indices), in first-edited order
+    PayrollSummary changed;           // Aggregates for `teams`, in the same order
+    long long luxury_tax_delta = 0;   // Change in total luxury tax vs. the baseline
+};
+
+// Batch payroll and market-value engine over one or more leagues' PlayerTables.
+//
+// evaluate() reads the salary, market value, skill, age and star columns
+// straight from each registry's PlayerTable (no Team or Player objects are
+// built) and projects every player in fixed-width chunks of kLanes rows, so
+// the per-lane loops compile to SIMD code. Per-row projections are kept, so a
+// scenario is evaluated as deltas against the baseline and reports only the
+// teams it changed: its cost is O(edits * (projection_years + edits)),
+// independent of the number of players and teams.
+//
+//   PayrollEngine engine(model);
+//   engine.addLeague(registry);
+//   engine.evaluate();
+//   const PayrollSummary& base = engine.baseline();
+//   std::vector<ScenarioResult> what_if = engine.evaluateScenarios(scenarios);
+class PayrollEngine {
+public:
+    // Rows per chunk in the projection kernel (eight doubles = one AVX-512
+    // register, two AVX2 registers).
+    static constexpr std::size_t kLanes = 8;
+
+    explicit PayrollEngine(const ValuationModel& model = ValuationModel()) : model_(model) {}
+
+    // Registers a league and returns its index. The registry must outlive the
+    // engine; call evaluate() again after its players change.
+    std::uint32_t addLeague(const TeamRegistry& teams);
+
+    std::size_t leagueCount() const { return leagues_.size(); }
+    std::size_t teamCount() const { return team_count_; }
+    // Global team index of `team` in `league` (the index into PayrollSummary vectors).
+    std::size_t teamIndex(std::uint32_t league, TeamId team) const { return leagues_[league].first_team + team; }
+
+    const ValuationModel& model() const { return model_; }
+
+    // Recomputes the baseline aggregates and per-player projections.
+    void evaluate();
+    const PayrollSummary& baseline() const { return baseline_; }
+
+    // Applies one scenario's edits to the baseline. Throws std::out_of_range
+    // for a player or team outside the engine.
+    ScenarioResult evaluateScenario(const Scenario& scenario) const;
+
+    // Evaluates independent scenarios on a work-stealing pool
+    // (`threads == 0` = one per hardware thread). Results are in input order.
+    std::vector<ScenarioResult> evaluateScenarios(const std::vector<Scenario>& scenarios, unsigned threads = 0) const;
+
+    // The baseline with `result` applied, for callers that want every team.
+    PayrollSummary applyResult(const ScenarioResult& result) const;
+
+private:
+    struct League {
+        const TeamRegistry* teams;
+        std::size_t first_team;     // Global index of its TeamId 0
+        std::size_t first_row;      // Offset of its rows in the per-row arrays
+        std::size_t row_count;
+    };
+
+    std::size_t globalRow(const PlayerHandle& player) const;
+    std::size_t destinationTeam(const ScenarioEdit& edit) const;
+    // Throws std::out_of_range like evaluateScenario(), before any work is queued.
+    void validate(const Scenario& scenario) const;
+    long long luxuryTax(long long payroll) const;
+    double rowProjection(std::size_t row, int year) const;
+
+    ValuationModel model_;
+    std::vector<League> leagues_;
+    std::size_t team_count_ = 0;
+    std::size_t row_count_ = 0;
+
+    PayrollSummary baseline_;
+    std::vector<std::uint32_t> row_team_;     // Global row -> global team index
+    std::vector<std::uint32_t> row_league_;   // Global row -> league
+    std::vector<long long> row_salary_;       // Columns as of evaluate()
+    std::vector<long long> row_market_value_;
+    // Year-major per league, as projectMarketValues writes it:
+    // [league.first_row * projection_years + (year - 1) * league.row_count + local row]
+    std::vector<double> row_projection_;
+};
+
+// Projects `count` players' market values `model.projection_years` years
+// ahead. out[y * count + i] is player i's value in year y + 1. Runs in chunks
+// of PayrollEngine::kLanes rows with a scalar tail.
+void projectMarketValues(const double* skill, const int* age, const std::uint8_t* star, const long long* market_value,
+                         std::size_t count, const ValuationModel& model, double* out);
+
+} // namespace LeagueSchedulerNS
+
+#endif // PAYROLL_ENGINE_H
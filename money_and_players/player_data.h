@@ -3,7 +3,7 @@
 
 #include <string>
 #include <vector>
-#include <map>
+#include "metric_registry.h" // MetricId interning and the per-player MetricValues list
 
 // Represents a single player in the league.
 // This structure holds attributes that can be used by the One-Game Simulation Agent
@@ -21,18 +21,20 @@ struct Player {
     long long market_value;     // Player's market value
 
     bool is_star_player;        // Flag for star players, who might be subject to special agentic control
+    int age;                    // Age in years; drives the market-value age curve (payroll_engine.h)
 
-    // Performance metrics (simplified for this example)
-    std::map<std::string, double> performance_metrics; // e.g., "batting_average", "era", "wins_above_replacement"
+    // Performance metrics keyed by interned MetricId (see metric_registry.h),
+    // e.g., performance_metrics["era"] or performance_metrics[Metrics::ERA]
+    MetricValues performance_metrics;
 
     // Default constructor
     Player() : id(0), name(""), skill_rating(0.0), games_played_season(0), fatigue_level(0.0),
-               salary(0), market_value(0), is_star_player(false) {}
+               salary(0), market_value(0), is_star_player(false), age(27) {}
 
     // Parameterized constructor for easy initialization
     Player(int _id, const std::string& _name, double _skill_rating, long long _salary, long long _market_value, bool _is_star_player)
         : id(_id), name(_name), skill_rating(_skill_rating), games_played_season(0), fatigue_level(0.0),
-          salary(_salary), market_value(_market_value), is_star_player(_is_star_player) {}
+          salary(_salary), market_value(_market_value), is_star_player(_is_star_player), age(27) {}
 };
 
 #endif // PLAYER_DATA_H
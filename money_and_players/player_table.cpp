@@ -0,0 +1,198 @@
+/**
+ * @file player_table.cpp
+ * @brief Columnar player storage, roster views and bulk per-player kernels.
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "player_table.h"
+#include <stdexcept>
+
+// --- PlayerTable ---
+
+PlayerRow PlayerTable::append(const Player& player) {
+    const PlayerRow row = static_cast<PlayerRow>(ids_.size());
+    ids_.push_back(player.id);
+    names_.push_back(player.name);
+    skill_rating_.push_back(player.skill_rating);
+    games_played_season_.push_back(player.games_played_season);
+    fatigue_level_.push_back(player.fatigue_level);
+    salary_.push_back(player.salary);
+    market_value_.push_back(player.market_value);
+    is_star_player_.push_back(player.is_star_player ? 1 : 0);
+    age_.push_back(player.age);
+    metrics_.resize(ids_.size());
+    for (const auto& entry : player.performance_metrics) {
+        metrics_.set(row, entry.first, entry.second);
+    }
+    row_of_id_[player.id] = row;
+    return row;
+}
+
+PlayerRow PlayerTable::appendRows(const PlayerColumns& columns) {
+    const PlayerRow first = static_cast<PlayerRow>(ids_.size());
+    const std::size_t n = columns.count;
+    ids_.insert(ids_.end(), columns.ids, columns.ids + n);
+    names_.resize(ids_.size());
+    skill_rating_.insert(skill_rating_.end(), columns.skill_ratings, columns.skill_ratings + n);
+    games_played_season_.resize(ids_.size(), 0);
+    fatigue_level_.resize(ids_.size(), 0.0);
+    salary_.insert(salary_.end(), columns.salaries, columns.salaries + n);
+    market_value_.insert(market_value_.end(), columns.market_values, columns.market_values + n);
+    is_star_player_.insert(is_star_player_.end(), columns.star_flags, columns.star_flags + n);
+    age_.insert(age_.end(), columns.ages, columns.ages + n);
+    metrics_.resize(ids_.size());
+    for (std::size_t i = 0; i < n; ++i) {
+        row_of_id_[columns.ids[i]] = first + static_cast<PlayerRow>(i);
+    }
+    return first;
+}
+
+void PlayerTable::reserve(std::size_t n) {
+    ids_.reserve(n);
+    names_.reserve(n);
+    skill_rating_.reserve(n);
+    games_played_season_.reserve(n);
+    fatigue_level_.reserve(n);
+    salary_.reserve(n);
+    market_value_.reserve(n);
+    is_star_player_.reserve(n);
+    age_.reserve(n);
+    metrics_.reserve(n);
+    row_of_id_.reserve(n);
+}
+
+void PlayerTable::clear() {
+    ids_.clear();
+    names_.clear();
+    skill_rating_.clear();
+    games_played_season_.clear();
+    fatigue_level_.clear();
+    salary_.clear();
+    market_value_.clear();
+    is_star_player_.clear();
+    age_.clear();
+    metrics_.clear();
+    row_of_id_.clear();
+}
+
+// --- Kernels ---
+
+long long sumSalaries(const PlayerTable& table, PlayerRow first, PlayerRow last) {
+    const long long* salary = table.salaries();
+    long long total = 0;
+    for (PlayerRow i = first; i < last; ++i) {
+        total += salary[i];
+    }
+    return total;
+}
+
+long long sumMarketValues(const PlayerTable& table, PlayerRow first, PlayerRow last) {
+    const long long* value = table.marketValues();
+    long long total = 0;
+    for (PlayerRow i = first; i < last; ++i) {
+        total += value[i];
+    }
+    return total;
+}
+
+void decayFatigue(PlayerTable& table, double decay_factor, PlayerRow first, PlayerRow last) {
+    double* fatigue = table.fatigueLevels();
+    for (PlayerRow i = first; i < last; ++i) {
+        fatigue[i] *= decay_factor;
+    }
+}
+
+std::size_t filterBySkill(const PlayerTable& table, double min_skill, std::vector<PlayerRow>& out) {
+    const double* skill = table.skillRatings();
+    const PlayerRow n = static_cast<PlayerRow>(table.size());
+    out.resize(n);
+    // Branch-free compaction: always store, only advance on a match.
+    std::size_t found = 0;
+    for (PlayerRow i = 0; i < n; ++i) {
+        out[found] = i;
+        found += (skill[i] >= min_skill) ? 1 : 0;
+    }
+    out.resize(found);
+    return found;
+}
+
+std::size_t filterByFatigue(const PlayerTable& table, double max_fatigue, PlayerRow first, PlayerRow last,
+                            std::vector<PlayerRow>& out) {
+    const double* fatigue = table.fatigueLevels();
+    out.resize(last > first ? last - first : 0);
+    std::size_t found = 0;
+    for (PlayerRow i = first; i < last; ++i) {
+        out[found] = i;
+        found += (fatigue[i] < max_fatigue) ? 1 : 0;
+    }
+    out.resize(found);
+    return found;
+}
+
+void starPlayerMask(const PlayerTable& table, double min_skill, std::vector<std::uint8_t>& mask) {
+    const double* skill = table.skillRatings();
+    const std::uint8_t* star = table.starFlags();
+    const std::size_t n = table.size();
+    mask.resize(n);
+    std::uint8_t* out = mask.data();
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = static_cast<std::uint8_t>(star[i] | static_cast<std::uint8_t>(skill[i] >= min_skill));
+    }
+}
+
+// --- PlayerRoster ---
+
+PlayerRoster::PlayerRoster(const PlayerRoster& other)
+    : table_(other.table_), first_(other.first_), count_(other.count_) {
+    if (other.owned_) {
+        owned_ = std::make_unique<PlayerTable>(*other.owned_);
+    }
+}
+
+PlayerRoster& PlayerRoster::operator=(const PlayerRoster& other) {
+    if (this != &other) {
+        PlayerRoster copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+PlayerRef PlayerRoster::push_back(const Player& player) {
+    if (!table_ && !owned_) {
+        owned_ = std::make_unique<PlayerTable>();
+    }
+    PlayerTable* t = table();
+    if (first_ + count_ != t->size()) {
+        if (count_ != 0) {
+            throw std::logic_error("PlayerRoster::push_back: roster rows must be appended contiguously");
+        }
+        first_ = static_cast<PlayerRow>(t->size());
+    }
+    PlayerRow row = t->append(player);
+    ++count_;
+    return t->row(row);
+}
+
+void PlayerRoster::reserve(std::size_t n) {
+    if (!table_ && !owned_) {
+        owned_ = std::make_unique<PlayerTable>();
+    }
+    PlayerTable* t = table();
+    t->reserve(first_ + n);
+}
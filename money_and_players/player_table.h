@@ -0,0 +1,270 @@
+#ifndef PLAYER_TABLE_H
+#define PLAYER_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "aligned_allocator.h"
+#include "metric_store.h"
+#include "player_data.h"
+
+// A "reference" to one row of a PlayerTable.
+// Each member is a reference into the matching column, so existing code that
+// reads or writes `player.skill_rating` keeps compiling against a table row.
+template <bool Const>
+struct BasicPlayerRef {
+    template <typename T>
+    using Ref = std::conditional_t<Const, const T&, T&>;
+
+    Ref<int> id;
+    Ref<std::string> name;
+    Ref<double> skill_rating;
+    Ref<int> games_played_season;
+    Ref<double> fatigue_level;
+    Ref<long long> salary;
+    Ref<long long> market_value;
+    Ref<std::uint8_t> is_star_player;
+    Ref<int> age;
+    BasicMetricsRef<Const> performance_metrics; // Row view into the table's MetricStore
+
+    // Materializes the row as a standalone Player record.
+    Player toPlayer() const {
+        Player p(id, name, skill_rating, salary, market_value, is_star_player != 0);
+        p.games_played_season = games_played_season;
+        p.fatigue_level = fatigue_level;
+        p.age = age;
+        const std::size_t metric_count = MetricRegistry::global().size();
+        for (std::size_t m = 0; m < metric_count; ++m) {
+            const MetricId metric = static_cast<MetricId>(m);
+            if (performance_metrics.contains(metric)) {
+                p.performance_metrics[metric] = performance_metrics.get(metric);
+            }
+        }
+        return p;
+    }
+};
+
+using PlayerRef = BasicPlayerRef<false>;
+using ConstPlayerRef = BasicPlayerRef<true>;
+
+// Borrowed column arrays for PlayerTable::appendRows(), each `count` long
+// (e.g., straight out of a mapped league cache).
+struct PlayerColumns {
+    std::size_t count = 0;
+    const int* ids = nullptr;
+    const double* skill_ratings = nullptr;
+    const long long* salaries = nullptr;
+    const long long* market_values = nullptr;
+    const std::uint8_t* star_flags = nullptr;
+    const int* ages = nullptr;
+};
+
+// Columnar (struct-of-arrays) storage for players.
+// Every hot numeric attribute lives in its own contiguous, 64-byte aligned
+// array indexed by PlayerRow, so league-wide scans only touch the columns they
+// need. The cold name column lives on the side, and performance metrics live
+// in a MetricStore (dense per-metric columns plus a sparse fallback).
+class PlayerTable {
+public:
+    PlayerTable() = default;
+
+    // Appends a player and returns its row.
+    PlayerRow append(const Player& player);
+
+    // Appends `columns.count` rows with one bulk copy per column (empty names,
+    // no games played, no fatigue, no metrics) and returns the first new row.
+    PlayerRow appendRows(const PlayerColumns& columns);
+    void setName(PlayerRow r, std::string_view name) { names_[r].assign(name.data(), name.size()); }
+
+    // Looks up the row of a Player::id. Returns size() if the id is unknown.
+    PlayerRow rowOf(int player_id) const {
+        auto it = row_of_id_.find(player_id);
+        return it == row_of_id_.end() ? static_cast<PlayerRow>(size()) : it->second;
+    }
+
+    PlayerRef row(PlayerRow r) {
+        return PlayerRef{ids_[r], names_[r], skill_rating_[r], games_played_season_[r], fatigue_level_[r],
+                         salary_[r], market_value_[r], is_star_player_[r], age_[r], MetricsRef(metrics_, r)};
+    }
+    ConstPlayerRef row(PlayerRow r) const {
+        return ConstPlayerRef{ids_[r], names_[r], skill_rating_[r], games_played_season_[r], fatigue_level_[r],
+                              salary_[r], market_value_[r], is_star_player_[r], age_[r],
+                              ConstMetricsRef(metrics_, r)};
+    }
+
+    std::size_t size() const { return ids_.size(); }
+    bool empty() const { return ids_.empty(); }
+    void reserve(std::size_t n);
+    void clear();
+
+    // Raw column access for bulk kernels.
+    const int* ids() const { return ids_.data(); }
+    const double* skillRatings() const { return skill_rating_.data(); }
+    double* skillRatings() { return skill_rating_.data(); }
+    const int* gamesPlayedSeason() const { return games_played_season_.data(); }
+    int* gamesPlayedSeason() { return games_played_season_.data(); }
+    const double* fatigueLevels() const { return fatigue_level_.data(); }
+    double* fatigueLevels() { return fatigue_level_.data(); }
+    const long long* salaries() const { return salary_.data(); }
+    long long* salaries() { return salary_.data(); }
+    const long long* marketValues() const { return market_value_.data(); }
+    long long* marketValues() { return market_value_.data(); }
+    const std::uint8_t* starFlags() const { return is_star_player_.data(); }
+    std::uint8_t* starFlags() { return is_star_player_.data(); }
+    const int* ages() const { return age_.data(); }
+    int* ages() { return age_.data(); }
+
+    // Performance metrics for every row: O(1) get/set by (row, metric) and
+    // leaderboard scans over a single metric column.
+    MetricStore& metrics() { return metrics_; }
+    const MetricStore& metrics() const { return metrics_; }
+
+private:
+    // Hot numeric columns
+    AlignedVector<double> skill_rating_;
+    AlignedVector<double> fatigue_level_;
+    AlignedVector<int> games_played_season_;
+    AlignedVector<long long> salary_;
+    AlignedVector<long long> market_value_;
+    AlignedVector<std::uint8_t> is_star_player_;
+    AlignedVector<int> age_;
+
+    // Cold columns
+    std::vector<int> ids_;
+    std::vector<std::string> names_;
+    MetricStore metrics_;
+
+    std::unordered_map<int, PlayerRow> row_of_id_;
+};
+
+// --- Bulk kernels over a row range [first, last) ---
+// Written as plain counted loops over raw columns with no data-dependent
+// branches, so the compiler can vectorize them.
+
+// Sum of salaries (team payroll when the range is a roster).
+long long sumSalaries(const PlayerTable& table, PlayerRow first, PlayerRow last);
+inline long long sumSalaries(const PlayerTable& table) {
+    return sumSalaries(table, 0, static_cast<PlayerRow>(table.size()));
+}
+
+// Sum of market values.
+long long sumMarketValues(const PlayerTable& table, PlayerRow first, PlayerRow last);
+
+// fatigue = fatigue * decay_factor (e.g., 0.9 for an off day).
+void decayFatigue(PlayerTable& table, double decay_factor, PlayerRow first, PlayerRow last);
+inline void decayFatigue(PlayerTable& table, double decay_factor) {
+    decayFatigue(table, decay_factor, 0, static_cast<PlayerRow>(table.size()));
+}
+
+// Writes the rows with skill_rating >= min_skill into `out` (replacing its contents)
+// and returns how many were found.
+std::size_t filterBySkill(const PlayerTable& table, double min_skill, std::vector<PlayerRow>& out);
+
+// Writes the rows in [first, last) with fatigue_level < max_fatigue (players fit
+// to play) into `out` (replacing its contents) and returns how many were found.
+std::size_t filterByFatigue(const PlayerTable& table, double max_fatigue, PlayerRow first, PlayerRow last,
+                            std::vector<PlayerRow>& out);
+
+// mask[i] = 1 if row i is a flagged star player or has skill_rating >= min_skill.
+// `mask` is resized to table.size().
+void starPlayerMask(const PlayerTable& table, double min_skill, std::vector<std::uint8_t>& mask);
+
+// A team's roster: a view over a contiguous row range of a PlayerTable.
+// Teams registered in a TeamRegistry view rows of the registry's shared table.
+// A standalone Team owns a private table, so `Team t; t.players.emplace_back(...)`
+// keeps working; TeamRegistry::add() moves those rows into the shared table.
+class PlayerRoster {
+public:
+    template <bool Const>
+    class Iterator {
+    public:
+        using Table = std::conditional_t<Const, const PlayerTable, PlayerTable>;
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = BasicPlayerRef<Const>;
+        using difference_type = std::ptrdiff_t;
+        using reference = BasicPlayerRef<Const>;
+        using pointer = void;
+
+        Iterator(Table* table, PlayerRow row) : table_(table), row_(row) {}
+        reference operator*() const { return table_->row(row_); }
+        Iterator& operator++() { ++row_; return *this; }
+        Iterator operator++(int) { Iterator tmp = *this; ++row_; return tmp; }
+        Iterator& operator--() { --row_; return *this; }
+        Iterator& operator+=(difference_type n) { row_ += static_cast<PlayerRow>(n); return *this; }
+        Iterator operator+(difference_type n) const { return Iterator(table_, row_ + static_cast<PlayerRow>(n)); }
+        difference_type operator-(const Iterator& o) const {
+            return static_cast<difference_type>(row_) - static_cast<difference_type>(o.row_);
+        }
+        bool operator==(const Iterator& o) const { return row_ == o.row_; }
+        bool operator!=(const Iterator& o) const { return row_ != o.row_; }
+        PlayerRow row() const { return row_; }
+
+    private:
+        Table* table_;
+        PlayerRow row_;
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    PlayerRoster() = default;
+    PlayerRoster(const PlayerRoster& other);
+    PlayerRoster& operator=(const PlayerRoster& other);
+    PlayerRoster(PlayerRoster&&) noexcept = default;
+    PlayerRoster& operator=(PlayerRoster&&) noexcept = default;
+
+    // Appends a player to this roster. Rows must be appended contiguously:
+    // the roster has to end at the last row of its table (build rosters team
+    // by team). Throws std::logic_error otherwise.
+    template <typename... Args>
+    PlayerRef emplace_back(Args&&... args) {
+        return push_back(Player(std::forward<Args>(args)...));
+    }
+    PlayerRef push_back(const Player& player);
+
+    std::size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    void reserve(std::size_t n);
+
+    PlayerRef operator[](std::size_t i) { return table()->row(first_ + static_cast<PlayerRow>(i)); }
+    ConstPlayerRef operator[](std::size_t i) const { return table()->row(first_ + static_cast<PlayerRow>(i)); }
+    PlayerRef front() { return (*this)[0]; }
+    ConstPlayerRef front() const { return (*this)[0]; }
+    PlayerRef back() { return (*this)[count_ - 1]; }
+    ConstPlayerRef back() const { return (*this)[count_ - 1]; }
+
+    iterator begin() { return iterator(table(), first_); }
+    iterator end() { return iterator(table(), first_ + count_); }
+    const_iterator begin() const { return const_iterator(table(), first_); }
+    const_iterator end() const { return const_iterator(table(), first_ + count_); }
+
+    // The row range [firstRow(), endRow()) this roster covers in table().
+    PlayerRow firstRow() const { return first_; }
+    PlayerRow endRow() const { return first_ + count_; }
+    PlayerTable* table() { return table_ ? table_ : owned_.get(); }
+    const PlayerTable* table() const { return table_ ? table_ : owned_.get(); }
+
+    // Re-points this roster at rows [first, first + count) of `table`
+    // (used by TeamRegistry). Drops any privately owned rows.
+    void bind(PlayerTable* table, PlayerRow first, PlayerRow count) {
+        owned_.reset();
+        table_ = table;
+        first_ = first;
+        count_ = count;
+    }
+
+private:
+    PlayerTable* table_ = nullptr;        // Shared table (non-owning), if bound
+    std::unique_ptr<PlayerTable> owned_;  // Private table for standalone teams
+    PlayerRow first_ = 0;
+    PlayerRow count_ = 0;
+};
+
+#endif // PLAYER_TABLE_H
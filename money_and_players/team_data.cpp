@@ -0,0 +1,44 @@
+/**
+ * @file team_data.cpp
+ * @brief Team copy operations, counted in instrumented builds.
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "team_data.h"
+#include "../instrumentation/instrumentation.h"
+
+Team::Team(const Team& other)
+    : id(other.id), city(other.city), mascot_theme(other.mascot_theme),
+      union_type(other.union_type), region_type(other.region_type),
+      wins(other.wins), losses(other.losses), players(other.players) {
+    APMW_COUNT(TEAM_COPIES, 1);
+}
+
+Team& Team::operator=(const Team& other) {
+    id = other.id;
+    city = other.city;
+    mascot_theme = other.mascot_theme;
+    union_type = other.union_type;
+    region_type = other.region_type;
+    wins = other.wins;
+    losses = other.losses;
+    players = other.players;
+    APMW_COUNT(TEAM_COPIES, 1);
+    return *this;
+}
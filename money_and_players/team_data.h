@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include "player_data.h" // Include the new player data structure
+#include "player_table.h" // Columnar player storage; rosters are row-range views into it
 
 // Enum for Union types (e.g., Atlantic Union, Pacific Union)
 enum class UnionType {
@@ -35,8 +36,9 @@ struct Team {
     RegionType region_type;
     int wins;
     int losses;
-    // New: A roster of Player objects for this team
-    std::vector<Player> players;
+    // Roster for this team: a view over a contiguous row range of a PlayerTable
+    // (the owning TeamRegistry's table once the team is registered).
+    PlayerRoster players;
 
     // Default constructor
     Team() : id(0), city(""), mascot_theme(""), union_type(UnionType::UNKNOWN),
@@ -48,6 +50,15 @@ struct Team {
         : id(_id), city(_city), mascot_theme(_mascot_theme),
           union_type(_union_type), region_type(_region_type),
           wins(0), losses(0) {}
+
+    // Copies are defined out of line (team_data.cpp) so that every translation
+    // unit sees the same Team whatever the APMW_INSTRUMENTATION switch; in
+    // instrumented builds they count TEAM_COPIES (schedules should only ever
+    // hold TeamIds). Moves are free and not counted.
+    Team(const Team& other);
+    Team& operator=(const Team& other);
+    Team(Team&&) = default;
+    Team& operator=(Team&&) = default;
 };
 
 #endif // TEAM_DATA_H
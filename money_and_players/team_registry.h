@@ -0,0 +1,125 @@
+#ifndef TEAM_REGISTRY_H
+#define TEAM_REGISTRY_H
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "team_data.h"
+
+namespace LeagueSchedulerNS {
+
+// Compact handle to a Team owned by a TeamRegistry.
+// Schedules (Game, ResidencyBlock) store these instead of full Team copies,
+// so a game costs a few bytes per team instead of a whole roster.
+using TeamId = std::uint16_t;
+
+// Sentinel for "no team" (e.g., a default-constructed Game).
+constexpr TeamId kInvalidTeamId = 0xFFFF;
+
+// Owns every Team in the league exactly once.
+// A TeamId is the team's index in the registry, so resolving a handle is a
+// single array access. Handles stay valid for the lifetime of the registry;
+// references returned by get()/operator[] are invalidated by add()/emplace().
+//
+// The registry also owns the league-wide PlayerTable. Each registered team's
+// `players` roster is a view over its own row range of that table, so rows
+// are grouped by team in registration order.
+class TeamRegistry {
+public:
+    TeamRegistry() : players_(std::make_unique<PlayerTable>()) {}
+
+    TeamRegistry(const TeamRegistry& other)
+        : teams_(other.teams_), players_(std::make_unique<PlayerTable>(*other.players_)) {
+        rebindRosters();
+    }
+    TeamRegistry& operator=(const TeamRegistry& other) {
+        if (this != &other) {
+            TeamRegistry copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+    // Moving keeps the PlayerTable at the same address, so rosters stay bound.
+    TeamRegistry(TeamRegistry&&) noexcept = default;
+    TeamRegistry& operator=(TeamRegistry&&) noexcept = default;
+
+    // Takes ownership of an existing Team and returns its handle.
+    // The team's roster rows are copied to the end of the shared PlayerTable.
+    TeamId add(Team team) {
+        const PlayerRow first = static_cast<PlayerRow>(players_->size());
+        const PlayerRow count = static_cast<PlayerRow>(team.players.size());
+        for (std::size_t i = 0; i < team.players.size(); ++i) {
+            players_->append(team.players[i].toPlayer());
+        }
+        team.players.bind(players_.get(), first, count);
+        teams_.push_back(std::move(team));
+        return static_cast<TeamId>(teams_.size() - 1);
+    }
+
+    // Constructs a Team in place (same arguments as the Team constructors).
+    // Its roster starts empty and grows at the end of the shared PlayerTable.
+    template <typename... Args>
+    TeamId emplace(Args&&... args) {
+        teams_.emplace_back(std::forward<Args>(args)...);
+        teams_.back().players.bind(players_.get(), static_cast<PlayerRow>(players_->size()), 0);
+        return static_cast<TeamId>(teams_.size() - 1);
+    }
+
+    // Constructs a Team whose roster is rows [first, first + count) already in
+    // players(), for bulk loaders that append every row before the teams.
+    template <typename... Args>
+    TeamId emplaceWithRoster(PlayerRow first, PlayerRow count, Args&&... args) {
+        teams_.emplace_back(std::forward<Args>(args)...);
+        teams_.back().players.bind(players_.get(), first, count);
+        return static_cast<TeamId>(teams_.size() - 1);
+    }
+
+    // Resolving accessors: turn a handle back into the owned Team.
+    const Team& get(TeamId id) const { return teams_[id]; }
+    Team& get(TeamId id) { return teams_[id]; }
+    const Team& operator[](TeamId id) const { return teams_[id]; }
+    Team& operator[](TeamId id) { return teams_[id]; }
+
+    // Looks up the handle for a Team::id (the league-facing team number).
+    // Returns kInvalidTeamId if no such team is registered.
+    TeamId findByTeamNumber(int team_number) const {
+        for (std::size_t i = 0; i < teams_.size(); ++i) {
+            if (teams_[i].id == team_number) {
+                return static_cast<TeamId>(i);
+            }
+        }
+        return kInvalidTeamId;
+    }
+
+    std::size_t size() const { return teams_.size(); }
+    bool empty() const { return teams_.empty(); }
+    void reserve(std::size_t n) { teams_.reserve(n); }
+
+    // Iteration over the owned teams, in handle order.
+    std::vector<Team>::iterator begin() { return teams_.begin(); }
+    std::vector<Team>::iterator end() { return teams_.end(); }
+    std::vector<Team>::const_iterator begin() const { return teams_.begin(); }
+    std::vector<Team>::const_iterator end() const { return teams_.end(); }
+
+    const std::vector<Team>& teams() const { return teams_; }
+
+    // The league-wide columnar player storage backing every roster.
+    PlayerTable& players() { return *players_; }
+    const PlayerTable& players() const { return *players_; }
+
+private:
+    void rebindRosters() {
+        for (Team& team : teams_) {
+            team.players.bind(players_.get(), team.players.firstRow(),
+                              static_cast<PlayerRow>(team.players.size()));
+        }
+    }
+
+    std::vector<Team> teams_;
+    std::unique_ptr<PlayerTable> players_; // Heap-allocated so moves keep roster pointers valid
+};
+
+} // namespace LeagueSchedulerNS
+
+#endif // TEAM_REGISTRY_H
@@ -0,0 +1,79 @@
+/**
+ * @file buffered_writer.cpp
+ * @brief Large-buffer output stream used by the schedule exporters.
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "buffered_writer.h"
+#include <iostream>
+
+namespace LeagueSchedulerNS {
+
+bool BufferedWriter::open(const std::string& path) {
+    close();
+    good_ = true;
+    if (path == "-") {
+        attach(stdout);
+        return true;
+    }
+    stream_ = std::fopen(path.c_str(), "wb");
+    if (stream_ == nullptr) {
+        std::cerr << "Error: cannot create " << path << std::endl;
+        good_ = false;
+        return false;
+    }
+    owns_stream_ = true;
+    return true;
+}
+
+void BufferedWriter::attach(std::FILE* stream) {
+    close();
+    good_ = true;
+    stream_ = stream;
+    owns_stream_ = false;
+}
+
+bool BufferedWriter::flush() {
+    if (used_ > 0) {
+        writeThrough(buffer_.data(), used_);
+        used_ = 0;
+    }
+    if (stream_ != nullptr && std::fflush(stream_) != 0) {
+        good_ = false;
+    }
+    return good_;
+}
+
+bool BufferedWriter::close() {
+    flush();
+    if (owns_stream_ && std::fclose(stream_) != 0) {
+        good_ = false;
+    }
+    stream_ = nullptr;
+    owns_stream_ = false;
+    return good_;
+}
+
+void BufferedWriter::writeThrough(const char* data, std::size_t size) {
+    if (stream_ == nullptr || std::fwrite(data, 1, size, stream_) != size) {
+        good_ = false;
+    }
+}
+
+} // namespace LeagueSchedulerNS
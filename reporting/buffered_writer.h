@@ -0,0 +1,90 @@
+#ifndef BUFFERED_WRITER_H
+#define BUFFERED_WRITER_H
+
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../money_and_players/calendar.h"
+
+namespace LeagueSchedulerNS {
+
+// Output stream for bulk reports.
+// Everything is appended to one large, reused buffer and handed to the OS in
+// big fwrite() calls; numbers and dates are formatted in place (no temporary
+// strings, no locale lookups), and nothing flushes per line.
+class BufferedWriter {
+public:
+    static constexpr std::size_t kDefaultCapacity = std::size_t(1) << 20; // 1 MiB
+
+    explicit BufferedWriter(std::size_t capacity = kDefaultCapacity) : buffer_(capacity < 64 ? 64 : capacity) {}
+    ~BufferedWriter() { close(); }
+
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    // Writes to `path` ("-" means standard output). Returns false (and reports
+    // to std::cerr) if the file cannot be created.
+    bool open(const std::string& path);
+    // Writes to an already open stream, which the caller keeps owning.
+    void attach(std::FILE* stream);
+    // Flushes, and closes the file if open() created it. Returns false if any write failed.
+    bool close();
+    bool flush();
+
+    bool good() const { return good_; }
+
+    void write(const char* data, std::size_t size) {
+        if (size > buffer_.size() - used_) {
+            flush();
+            if (size > buffer_.size()) {
+                writeThrough(data, size);
+                return;
+            }
+        }
+        std::memcpy(buffer_.data() + used_, data, size);
+        used_ += size;
+    }
+    void write(std::string_view text) { write(text.data(), text.size()); }
+    void put(char c) {
+        if (used_ == buffer_.size()) {
+            flush();
+        }
+        buffer_[used_++] = c;
+    }
+
+    template <typename Integer>
+    void writeInt(Integer value) {
+        char* out = reserve(24);
+        used_ += static_cast<std::size_t>(std::to_chars(out, out + 24, value).ptr - out);
+    }
+
+    // "YYYY-MM-DD".
+    void writeDate(CalendarDate date) {
+        char* out = reserve(11);
+        used_ += static_cast<std::size_t>(date.format(out));
+    }
+
+private:
+    // Returns room for at least `size` bytes at the end of the buffer.
+    char* reserve(std::size_t size) {
+        if (size > buffer_.size() - used_) {
+            flush();
+        }
+        return buffer_.data() + used_;
+    }
+    void writeThrough(const char* data, std::size_t size);
+
+    std::vector<char> buffer_;
+    std::size_t used_ = 0;
+    std::FILE* stream_ = nullptr;
+    bool owns_stream_ = false;
+    bool good_ = true;
+};
+
+} // namespace LeagueSchedulerNS
+
+#endif // BUFFERED_WRITER_H
@@ -0,0 +1,196 @@
+/**
+ * @file schedule_exporter.cpp
+ * @brief Text, CSV and JSON-lines schedule exporters writing through a BufferedWriter.
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "schedule_exporter.h"
+
+namespace LeagueSchedulerNS {
+
+std::string csvField(const std::string& text) {
+    if (text.find_first_of(",\"\r\n") == std::string::npos) {
+        return text;
+    }
+    std::string quoted = "\"";
+    for (char c : text) {
+        if (c == '"') {
+            quoted += '"';
+        }
+        quoted += c;
+    }
+    quoted += '"';
+    return quoted;
+}
+
+std::string jsonString(const std::string& text) {
+    static const char kHex[] = "0123456789abcdef";
+    std::string quoted = "\"";
+    for (unsigned char c : text) {
+        if (c == '"' || c == '\\') {
+            quoted += '\\';
+            quoted += static_cast<char>(c);
+        } else if (c < 0x20) {
+            quoted += "\\u00";
+            quoted += kHex[c >> 4];
+            quoted += kHex[c & 0xF];
+        } else {
+            quoted += static_cast<char>(c);
+        }
+    }
+    quoted += '"';
+    return quoted;
+}
+
+bool parseScheduleFormat(const std::string& name, ScheduleFormat& format) {
+    if (name == "text") {
+        format = ScheduleFormat::TEXT;
+    } else if (name == "csv") {
+        format = ScheduleFormat::CSV;
+    } else if (name == "jsonl" || name == "json") {
+        format = ScheduleFormat::JSON_LINES;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::unique_ptr<ScheduleExporter> makeScheduleExporter(ScheduleFormat format, const TeamRegistry& teams,
+                                                       BufferedWriter& out) {
+    switch (format) {
+    case ScheduleFormat::CSV:
+        return std::make_unique<CsvScheduleExporter>(teams, out);
+    case ScheduleFormat::JSON_LINES:
+        return std::make_unique<JsonLinesScheduleExporter>(teams, out);
+    case ScheduleFormat::TEXT:
+    default:
+        return std::make_unique<TextScheduleExporter>(teams, out);
+    }
+}
+
+void ScheduleExporter::exportSchedule(const SeasonSchedule& schedule) {
+    start();
+    for (const ResidencyBlock& block : schedule) {
+        writeBlock(block);
+        ++block_index_;
+    }
+    out_.flush();
+}
+
+// ---------------------------------------------------------------- text
+
+void TextScheduleExporter::writeHeader() {
+    out_.write("\n--- Sample Season Schedule ---\n");
+}
+
+void TextScheduleExporter::writeBlock(const ResidencyBlock& block) {
+    out_.write("--------------------------------------\nResidency Block: ");
+    out_.write(teams_[block.host_team].city);
+    out_.write(block.is_apex_residency ? " Host (APEX RESIDENCY)\n" : " Host \n");
+    out_.write("  Visiting Residents: ");
+    for (TeamId visitor : block.visiting_residents) {
+        out_.write(teams_[visitor].city);
+        out_.put(' ');
+    }
+    out_.write("\n  Dates: ");
+    out_.writeDate(block.start_date);
+    out_.write(" to ");
+    out_.writeDate(block.end_date);
+    out_.write("\n  Games (");
+    out_.writeInt(block.games.size());
+    out_.write("):\n");
+    for (const Game& game : block.games) {
+        out_.write("    - ");
+        out_.writeDate(game.date);
+        out_.write(": ");
+        out_.write(teams_[game.team1].city);
+        out_.write(" (Away/First Bat) vs. ");
+        out_.write(teams_[game.team2].city);
+        out_.write(" (Home/Second Bat)  at ");
+        out_.write(teams_[game.actual_host_stadium].city);
+        out_.write(" Stadium. Type: ");
+        out_.write(gameTypeName(game.game_type));
+        out_.put('\n');
+    }
+}
+
+// ---------------------------------------------------------------- CSV
+
+CsvScheduleExporter::CsvScheduleExporter(const TeamRegistry& teams, BufferedWriter& out)
+    : ScheduleExporter(teams, out) {
+    names_.reserve(teams.size());
+    for (const Team& team : teams) {
+        names_.push_back(csvField(team.city));
+    }
+}
+
+void CsvScheduleExporter::writeHeader() {
+    out_.write("block,date,away,home,bats_last,stadium,game_type\n");
+}
+
+void CsvScheduleExporter::writeBlock(const ResidencyBlock& block) {
+    for (const Game& game : block.games) {
+        out_.writeInt(block_index_);
+        out_.put(',');
+        out_.writeDate(game.date);
+        out_.put(',');
+        out_.write(names_[game.team1]);
+        out_.put(',');
+        out_.write(names_[game.team2]);
+        out_.put(',');
+        out_.write(names_[game.designated_home_team_for_batting]);
+        out_.put(',');
+        out_.write(names_[game.actual_host_stadium]);
+        out_.put(',');
+        out_.write(gameTypeName(game.game_type));
+        out_.put('\n');
+    }
+}
+
+// ---------------------------------------------------------------- JSON lines
+
+JsonLinesScheduleExporter::JsonLinesScheduleExporter(const TeamRegistry& teams, BufferedWriter& out)
+    : ScheduleExporter(teams, out) {
+    names_.reserve(teams.size());
+    for (const Team& team : teams) {
+        names_.push_back(jsonString(team.city));
+    }
+}
+
+void JsonLinesScheduleExporter::writeBlock(const ResidencyBlock& block) {
+    for (const Game& game : block.games) {
+        out_.write("{\"block\":");
+        out_.writeInt(block_index_);
+        out_.write(",\"date\":\"");
+        out_.writeDate(game.date);
+        out_.write("\",\"away\":");
+        out_.write(names_[game.team1]);
+        out_.write(",\"home\":");
+        out_.write(names_[game.team2]);
+        out_.write(",\"bats_last\":");
+        out_.write(names_[game.designated_home_team_for_batting]);
+        out_.write(",\"stadium\":");
+        out_.write(names_[game.actual_host_stadium]);
+        out_.write(",\"type\":\"");
+        out_.write(gameTypeName(game.game_type));
+        out_.write("\"}\n");
+    }
+}
+
+} // namespace LeagueSchedulerNS
@@ -0,0 +1,107 @@
+#ifndef SCHEDULE_EXPORTER_H
+#define SCHEDULE_EXPORTER_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../money_and_players/game_data.h"
+#include "../money_and_players/team_registry.h"
+#include "../scheduling/schedule_sink.h"
+#include "buffered_writer.h"
+
+namespace LeagueSchedulerNS {
+
+enum class ScheduleFormat {
+    TEXT,        // Human-readable block listing (the classic console report)
+    CSV,         // One row per game, with a header row
+    JSON_LINES   // One JSON object per game
+};
+
+// Accepts "text", "csv" and "jsonl" (or "json"). Returns false for anything else.
+bool parseScheduleFormat(const std::string& name, ScheduleFormat& format);
+
+// Quoting used by the exporters, for other CSV / JSON writers too.
+std::string csvField(const std::string& text);    // Quoted only if it contains , " CR or LF
+std::string jsonString(const std::string& text);  // JSON string literal, quotes included
+
+// Schedule sink that renders blocks as they stream in.
+// Team names are escaped for the format once, up front, so emitting a game
+// is a handful of buffer copies and integer/date conversions.
+class ScheduleExporter : public ScheduleSink {
+public:
+    ScheduleExporter(const TeamRegistry& teams, BufferedWriter& out) : teams_(teams), out_(out) {}
+
+    void beginSeason(const SeasonPlan& plan) override {
+        (void)plan;
+        start();
+    }
+    void onBlock(ResidencyBlock&& block) override {
+        start();
+        writeBlock(block);
+        ++block_index_;
+    }
+    void endSeason() override { out_.flush(); }
+
+    // Exports an already materialized season.
+    void exportSchedule(const SeasonSchedule& schedule);
+
+protected:
+    virtual void writeHeader() {}
+    virtual void writeBlock(const ResidencyBlock& block) = 0;
+
+    const TeamRegistry& teams_;
+    BufferedWriter& out_;
+    std::size_t block_index_ = 0;  // Index of the block being written
+
+private:
+    void start() {
+        if (!started_) {
+            started_ = true;
+            writeHeader();
+        }
+    }
+
+    bool started_ = false;
+};
+
+std::unique_ptr<ScheduleExporter> makeScheduleExporter(ScheduleFormat format, const TeamRegistry& teams,
+                                                       BufferedWriter& out);
+
+class TextScheduleExporter : public ScheduleExporter {
+public:
+    using ScheduleExporter::ScheduleExporter;
+
+protected:
+    void writeHeader() override;
+    void writeBlock(const ResidencyBlock& block) override;
+};
+
+// Columns: block,date,away,home,bats_last,stadium,game_type
+class CsvScheduleExporter : public ScheduleExporter {
+public:
+    CsvScheduleExporter(const TeamRegistry& teams, BufferedWriter& out);
+
+protected:
+    void writeHeader() override;
+    void writeBlock(const ResidencyBlock& block) override;
+
+private:
+    std::vector<std::string> names_; // Team cities, CSV-quoted where needed
+};
+
+// {"block":0,"date":"2025-03-27","away":"...","home":"...","bats_last":"...","stadium":"...","type":"..."}
+class JsonLinesScheduleExporter : public ScheduleExporter {
+public:
+    JsonLinesScheduleExporter(const TeamRegistry& teams, BufferedWriter& out);
+
+protected:
+    void writeBlock(const ResidencyBlock& block) override;
+
+private:
+    std::vector<std::string> names_; // Team cities as JSON string literals, quotes included
+};
+
+} // namespace LeagueSchedulerNS
+
+#endif // SCHEDULE_EXPORTER_H
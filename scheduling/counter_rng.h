@@ -0,0 +1,73 @@
+#ifndef COUNTER_RNG_H
+#define COUNTER_RNG_H
+
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+
+namespace LeagueSchedulerNS {
+
+// Counter-based random number generator (SplitMix64-style).
+//
+// The n-th output is a pure function mix(key + n * gamma) of a 64-bit key and
+// a counter, so there is no hidden state to share between threads: any number
+// of independent streams can be derived from one seed by hashing identifiers
+// into the key (see forStream), and each stream can be consumed on any thread
+// with identical results.
+//
+// Satisfies UniformRandomBitGenerator, so it works with std::shuffle and the
+// <random> distributions.
+class CounterRng {
+public:
+    using result_type = std::uint64_t;
+
+    explicit CounterRng(std::uint64_t key = 0, std::uint64_t counter = 0) : key_(key), counter_(counter) {}
+
+    // Derives an independent stream from a seed and a tuple of identifiers,
+    // e.g. forStream(seed, {season, host, round}).
+    static CounterRng forStream(std::uint64_t seed, std::initializer_list<std::uint64_t> ids) {
+        std::uint64_t key = mix(seed ^ 0x243F6A8885A308D3ull);
+        for (std::uint64_t id : ids) {
+            key = mix(key ^ (id + 0x9E3779B97F4A7C15ull + (key << 6) + (key >> 2)));
+        }
+        return CounterRng(key);
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() { return at(counter_++); }
+
+    // The output at an arbitrary position of this stream (random access).
+    result_type at(std::uint64_t counter) const { return mix(key_ + (counter + 1) * kGamma); }
+
+    void discard(std::uint64_t n) { counter_ += n; }
+
+    // Uniform integer in [0, n) (multiply-shift; bias is negligible for small n).
+    std::uint32_t bounded(std::uint32_t n) {
+        return static_cast<std::uint32_t>(((operator()() >> 32) * static_cast<std::uint64_t>(n)) >> 32);
+    }
+
+    // Uniform double in [0, 1).
+    double uniform01() { return static_cast<double>(operator()() >> 11) * (1.0 / 9007199254740992.0); }
+
+    std::uint64_t key() const { return key_; }
+    std::uint64_t counter() const { return counter_; }
+
+    // SplitMix64 finalizer.
+    static std::uint64_t mix(std::uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+private:
+    static constexpr std::uint64_t kGamma = 0x9E3779B97F4A7C15ull;
+
+    std::uint64_t key_;
+    std::uint64_t counter_;
+};
+
+} // namespace LeagueSchedulerNS
+
+#endif // COUNTER_RNG_H
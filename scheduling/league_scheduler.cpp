@@ -23,111 +23,234 @@
  */
 
 #include "league_scheduler_2.h"
+#include "instrumentation.h"
 #include <iostream>
 #include <chrono> 
 #include <algorithm> 
-#include <random>    
+#include <thread>
+#include <utility>
 
 namespace LeagueSchedulerNS {
 
+namespace {
+
+// Stream tags keep the engine's streams disjoint from the per-block streams.
+constexpr std::uint64_t kEngineStream = 1;
+constexpr std::uint64_t kBlockStream = 2;
+
+// Blocks built per thread before the window is handed to the sink.
+constexpr std::size_t kBlocksPerShard = 64;
+
+} // namespace
+
 // Constructor to initialize the random number generator
-LeagueScheduler2::LeagueScheduler2() : rng(std::chrono::steady_clock::now().time_since_epoch().count()) {}
+LeagueScheduler2::LeagueScheduler2()
+    : seed_(static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count())) {}
+
+LeagueScheduler2::LeagueScheduler2(std::uint64_t seed) : seed_(seed) {}
 
-std::vector<ResidencyBlock> LeagueScheduler2::generateSeasonSchedule(const std::vector<Team>& all_teams, int games_per_team) {
-    std::vector<ResidencyBlock> season_schedule;
+LeagueScheduler2::LeagueScheduler2(const SeasonEngineConfig& config, std::uint64_t seed)
+    : seed_(seed), config_(config) {}
 
+SeasonSchedule LeagueScheduler2::generateSeasonSchedule(const TeamRegistry& all_teams, int games_per_team,
+                                                        std::pmr::memory_resource* resource) {
+    SeasonSchedule season_schedule(resource);
+    VectorScheduleSink sink(season_schedule);
+    streamSeasonSchedule(all_teams, games_per_team, sink);
+    return season_schedule;
+}
+
+void LeagueScheduler2::streamSeasonSchedule(const TeamRegistry& all_teams, int games_per_team, ScheduleSink& sink) {
+    APMW_TRACE_SCOPE("scheduler.season");
     if (all_teams.size() < 3) {
         std::cerr << "Need at least 3 teams to create a residency block (1 host + 2 visitors)." << std::endl;
-        return season_schedule;
+        return;
     }
 
-    int residency_block_counter = 0;
-    for (const auto& host_team : all_teams) {
-        std::vector<Team> potential_visitors;
-        for (const auto& team : all_teams) {
-            if (team.id != host_team.id) {
-                potential_visitors.push_back(team);
-            }
-        }
+    SeasonEngineConfig config = config_;
+    config.games_per_team = games_per_team;
+    config.seed = CounterRng::forStream(seed_, {kEngineStream, static_cast<std::uint64_t>(season_index_)}).key();
+    {
+        APMW_TRACE_SCOPE("scheduler.plan");
+        const LeagueTopology topology(all_teams);
+        last_plan_ = SeasonEngine(config).plan(all_teams.size(), &topology);
+    }
 
-        if (potential_visitors.size() < 2) {
-            continue;
+    // Book every block's teams on the availability bitsets; a failed booking
+    // means a team would be in two places on the same day.
+    APMW_TRACE_SCOPE("scheduler.availability");
+    last_availability_.reset(all_teams.size(), last_plan_.season_days);
+    int conflicts = 0;
+    for (const PlannedBlock& planned : last_plan_.blocks) {
+        for (TeamId team : {planned.host, planned.visitor1, planned.visitor2}) {
+            if (!last_availability_.book(team, planned.start_day, planned.totalGames())) {
+                ++conflicts;
+            }
         }
+    }
+    if (conflicts > 0) {
+        std::cerr << "Error: " << conflicts << " double-booked team block(s) in the generated season." << std::endl;
+    }
 
-        std::shuffle(potential_visitors.begin(), potential_visitors.end(), rng);
-        // FIX: Create a new vector containing two specific teams from the shuffled list.
-        std::vector<Team> visiting_teams = {potential_visitors[0], potential_visitors[1]};
+    const int teams_off_quota = last_plan_.teams_off_quota;
+    const std::size_t block_count = last_plan_.blocks.size();
+    if (report_progress_) {
+        std::cout << "Generated " << block_count << " residency blocks over "
+                  << last_plan_.rounds << " rounds." << std::endl;
+    }
+    if (teams_off_quota > 0) {
+        std::cerr << "Warning: " << teams_off_quota << " team(s) could not be scheduled for exactly "
+                  << games_per_team << " games." << std::endl;
+    }
 
-        ResidencyBlock block = createResidencyBlock(host_team, visiting_teams);
-        season_schedule.push_back(block);
-        residency_block_counter++;
+    // Blocks are independent (each has its own stream), so a window of them can
+    // be built on any number of threads, each filling its own contiguous shard,
+    // and then handed to the sink in plan order. Only one window is ever live,
+    // and its blocks are refilled in place, so memory stays bounded by the
+    // window rather than the season.
+    const unsigned threads = static_cast<unsigned>(std::min<std::size_t>(block_threads_, std::max<std::size_t>(1, block_count)));
+    const std::size_t window = threads == 1 ? 1 : static_cast<std::size_t>(threads) * kBlocksPerShard;
+    std::vector<ResidencyBlock> buffer(std::min(window, block_count));
 
-        if (residency_block_counter >= all_teams.size()) { 
-            break;
+    sink.beginSeason(last_plan_);
+    for (std::size_t first = 0; first < block_count; first += window) {
+        const std::size_t count = std::min(window, block_count - first);
+        auto build_shard = [&](unsigned shard) {
+            APMW_TRACE_SCOPE("scheduler.build_blocks");
+            const std::size_t begin = count * shard / threads;
+            const std::size_t end = count * (shard + 1) / threads;
+            for (std::size_t b = begin; b < end; ++b) {
+                fillResidencyBlock(last_plan_.blocks[first + b], buffer[b]);
+            }
+        };
+        std::vector<std::thread> workers;
+        for (unsigned shard = 1; shard < threads && count > 1; ++shard) {
+            workers.emplace_back(build_shard, shard);
+        }
+        if (workers.empty()) {
+            APMW_TRACE_SCOPE("scheduler.build_blocks");
+            for (std::size_t b = 0; b < count; ++b) {
+                fillResidencyBlock(last_plan_.blocks[first + b], buffer[b]);
+            }
+        } else {
+            build_shard(0);
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        }
+        APMW_TRACE_SCOPE("scheduler.sink");
+        for (std::size_t b = 0; b < count; ++b) {
+            sink.onBlock(std::move(buffer[b]));
         }
     }
+    sink.endSeason();
+}
 
-    std::cout << "Generated " << season_schedule.size() << " residency blocks." << std::endl;
-    return season_schedule;
+CounterRng LeagueScheduler2::blockStream(const PlannedBlock& planned) const {
+    return CounterRng::forStream(seed_, {kBlockStream, static_cast<std::uint64_t>(season_index_),
+                                         planned.host, static_cast<std::uint64_t>(planned.round)});
 }
 
-ResidencyBlock LeagueScheduler2::createResidencyBlock(const Team& host, const std::vector<Team>& visitors) {
-    ResidencyBlock block;
-    block.host_team = host;
-    block.visiting_residents = visitors;
-    block.start_date = "2025-07-25"; // Placeholder
-    block.end_date = "2025-07-31";   // Placeholder
+bool LeagueScheduler2::verifyShardedMatchesSerial(const TeamRegistry& all_teams, int games_per_team, unsigned threads) {
+    const unsigned saved_threads = block_threads_;
+    setBlockThreads(1);
+    SeasonSchedule serial = generateSeasonSchedule(all_teams, games_per_team);
+    setBlockThreads(threads);
+    SeasonSchedule sharded = generateSeasonSchedule(all_teams, games_per_team);
+    block_threads_ = saved_threads;
+    return serial == sharded;
+}
 
-    if (visitors.size() < 2) {
-        std::cerr << "Error: Not enough visiting residents for a residency block and Crossroads Games." << std::endl;
-        return block;
+bool LeagueScheduler2::verifyRepair(const TeamRegistry& all_teams, int games_per_team, std::size_t& disruptions) {
+    SeasonSchedule season = generateSeasonSchedule(all_teams, games_per_team);
+    ScheduleRepairer repairer = this->repairer(season);
+    disruptions = 0;
+    auto check = [&](const ScheduleDisruption& disruption) {
+        repairer.apply(disruption);
+        ++disruptions;
+        return repairer.verify();
+    };
+    if (!repairer.verify()) {
+        return false;
     }
 
-    // Games between Host and each Visitor
-    for (const auto& visitor : visitors) {
-        Game game;
-        // FIX: Assign a single Team object (the current visitor in the loop).
-        game.team1 = visitor;
-        game.team2 = host;
-        game.designated_home_team_for_batting = host;
-        game.actual_host_stadium = host;
-        game.date = block.start_date;
-        game.game_type = GameType::REGULAR_SEASON;
-        block.games.push_back(game);
+    // Blocks are read back by index: repairs append make-up blocks to the season.
+    const std::size_t generated = season.size();
+    for (int pass = 0; pass < 2; ++pass) {
+        for (std::size_t b = 0; b < generated; ++b) {
+            std::vector<std::pair<TeamId, CalendarDate>> crossroads;
+            for (const Game& game : season[b].games) {
+                if (game.game_type == GameType::CROSSROADS_GAME) {
+                    crossroads.emplace_back(game.team1, game.date);
+                }
+            }
+            // Latest first, so a slide does not move the next game to postpone.
+            for (auto it = crossroads.rbegin(); it != crossroads.rend(); ++it) {
+                if (!check(ScheduleDisruption::gamePostponed(it->first, it->second))) {
+                    return false;
+                }
+            }
+        }
     }
+    // Hosts' own games after their stadiums took make-ups (possibly while they were away).
+    for (std::size_t b = 0; b < generated; ++b) {
+        const ResidencyBlock& block = season[b];
+        for (const Game& game : block.games) {
+            if (game.team1 == block.host_team || game.team2 == block.host_team) {
+                if (!check(ScheduleDisruption::gamePostponed(block.host_team, game.date))) {
+                    return false;
+                }
+                break;
+            }
+        }
+    }
+    // One stadium closure per round, each over that round's first two days.
+    for (std::size_t b = 0; b < generated; b += std::max<std::size_t>(1, all_teams.size() / 3)) {
+        const ResidencyBlock& block = season[b];
+        if (!check(ScheduleDisruption::stadiumUnavailable(block.host_team, block.start_date, block.start_date + 1))) {
+            return false;
+        }
+    }
+    return true;
+}
 
-    // Crossroads Games between the two visiting residents
-    // FIX: Pass the two individual Team objects from the visitors vector.
-    std::vector<Game> crossroads_series = generateCrossroadsGames(visitors[0], visitors[1], host, 5);
-    block.games.insert(block.games.end(), crossroads_series.begin(), crossroads_series.end());
+void LeagueScheduler2::fillResidencyBlock(const PlannedBlock& planned, ResidencyBlock& block) const {
+    block.host_team = planned.host;
+    block.visiting_residents.assign({planned.visitor1, planned.visitor2});
+    block.start_date = config_.season_start + planned.start_day;
+    block.end_date = block.start_date + (planned.totalGames() - 1);
+    block.is_apex_residency = false;
+    block.games.clear();
+    block.games.reserve(planned.totalGames());
 
-    return block;
-}
+    // Crossroads Games between the two visiting residents: one coin flip per block.
+    CounterRng rng = blockStream(planned);
+    const bool visitor1_bats_first = (rng.bounded(2) == 0);
 
-std::vector<Game> LeagueScheduler2::generateCrossroadsGames(const Team& visitor1, const Team& visitor2, const Team& host_stadium, int num_games_in_series) {
-    std::vector<Game> series_games;
-    std::uniform_int_distribution<> distrib(0, 1);
-    bool visitor1_bats_first = (distrib(rng) == 0);
-
-    for (int i = 0; i < num_games_in_series; ++i) {
-        Game game;
-        game.actual_host_stadium = host_stadium;
-        game.game_type = GameType::CROSSROADS_GAME;
-        game.date = "Crossroads Game " + std::to_string(i + 1);
-
-        // Alternate who bats first each game
-        if ((i % 2 == 0) ? visitor1_bats_first : !visitor1_bats_first) {
-            game.team1 = visitor1;
-            game.team2 = visitor2;
-            game.designated_home_team_for_batting = visitor2;
-        } else {
-            game.team1 = visitor2;
-            game.team2 = visitor1;
-            game.designated_home_team_for_batting = visitor1;
+    // One game per day at the host stadium. Interleave the three series
+    // (host-v1, host-v2, crossroads) so no team plays every day of the block.
+    // Games are written straight into the block; no per-series vectors.
+    const TeamId visitors[2] = {planned.visitor1, planned.visitor2};
+    const int series_length[3] = {planned.host_games_vs_visitor1, planned.host_games_vs_visitor2,
+                                  planned.crossroads_games};
+    int next[3] = {0, 0, 0};
+    int day = planned.start_day;
+    while (block.games.size() < static_cast<std::size_t>(planned.totalGames())) {
+        for (int s = 0; s < 3; ++s) {
+            if (next[s] >= series_length[s]) {
+                continue;
+            }
+            Game game = s < 2
+                ? SeriesPolicy<SeriesKind::HOST_VS_VISITOR>::game(visitors[s], planned.host, planned.host, next[s], false)
+                : SeriesPolicy<SeriesKind::CROSSROADS>::game(planned.visitor1, planned.visitor2, planned.host, next[s],
+                                                             visitor1_bats_first);
+            ++next[s];
+            game.date = config_.season_start + day++;
+            block.games.push_back(game);
         }
-        series_games.push_back(game);
     }
-    return series_games;
+    APMW_COUNT(BLOCKS_BUILT, 1);
+    APMW_COUNT(GAMES_BUILT, block.games.size());
 }
 
 } // namespace LeagueSchedulerNS
@@ -3,30 +3,109 @@
 
 #include <vector>
 #include <string>
-#include <random>
+#include <cstdint>
 #include <algorithm>
 #include "../money_and_players/team_data.h" 
 #include "../money_and_players/game_data.h" 
+#include "../money_and_players/team_registry.h"
+#include "season_engine.h"
+#include "series_policy.h"
+#include "schedule_sink.h"
+#include "counter_rng.h"
+#include "team_availability.h"
+#include "schedule_repair.h"
 
 namespace LeagueSchedulerNS { 
 
 class LeagueScheduler2 {
 public:
     // FIX: Added the missing constructor declaration.
+    // Seeds from the clock; call seed() to record the value for a later replay.
     LeagueScheduler2();
+    // Reproducible: the same seed always yields the same season.
+    explicit LeagueScheduler2(std::uint64_t seed);
+    // Uses the given season engine settings (series lengths, restarts, ...) and seed.
+    LeagueScheduler2(const SeasonEngineConfig& config, std::uint64_t seed);
 
-    // Main function to generate the season schedule
-    std::vector<ResidencyBlock> generateSeasonSchedule(const std::vector<Team>& all_teams, int games_per_team);
+    std::uint64_t seed() const { return seed_; }
+    void setSeed(std::uint64_t seed) { seed_ = seed; }
+
+    const SeasonEngineConfig& config() const { return config_; }
+
+    // Which season of a multi-season run this is; part of every stream key.
+    int seasonIndex() const { return season_index_; }
+    void setSeasonIndex(int season_index) { season_index_ = season_index; }
+
+    // Number of threads used to materialize residency blocks (1 = serial).
+    // Each block draws from its own (seed, season, host, round) stream, so the
+    // output is identical for any thread count.
+    void setBlockThreads(unsigned threads) { block_threads_ = threads == 0 ? 1 : threads; }
+
+    // Whether each season prints its "Generated N residency blocks" line to
+    // std::cout (on by default; batch runs turn it off). Warnings still go to std::cerr.
+    void setReportProgress(bool report) { report_progress_ = report; }
+
+    // Main function to generate the season schedule.
+    // Runs the SeasonEngine until every team reaches `games_per_team`, then
+    // materializes its dated residency blocks.
+    // Blocks and games refer to teams by TeamId; resolve them through `all_teams`.
+    // Thin adapter over streamSeasonSchedule() that collects every block.
+    // The season (the vector and every block's games) is allocated from
+    // `resource`; pass a std::pmr::monotonic_buffer_resource to build the
+    // season in one arena and free it in O(1).
+    SeasonSchedule generateSeasonSchedule(const TeamRegistry& all_teams, int games_per_team,
+                                          std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    // Same season, handed to `sink` block by block in plan order instead of
+    // being materialized. Memory stays bounded by the block-building window
+    // (one block when serial), so large leagues and multi-season runs can
+    // stream straight into a printer, archive writer or simulator.
+    void streamSeasonSchedule(const TeamRegistry& all_teams, int games_per_team, ScheduleSink& sink);
+
+    // The engine plan behind the most recent generateSeasonSchedule() call.
+    const SeasonPlan& lastPlan() const { return last_plan_; }
+
+    // Per-team day bitsets for that season (set bit = team is in a residency block).
+    const TeamAvailability& lastAvailability() const { return last_availability_; }
+
+    // Repairs `season` (this scheduler's most recent output) in place after
+    // postponements or stadium closures, re-planning only the affected blocks
+    // instead of regenerating the season:
+    //
+    //   ScheduleRepairer repairer = scheduler.repairer(season);
+    //   repairer.apply(ScheduleDisruption::gamePostponed(team, date));
+    ScheduleRepairer repairer(SeasonSchedule& season) const {
+        return ScheduleRepairer(season, last_plan_.games_per_team.size(), config_.season_start, seed_, season_index_);
+    }
+
+    // Generates the season serially and again with host blocks sharded across
+    // `threads`, and returns true if both outputs are identical.
+    bool verifyShardedMatchesSerial(const TeamRegistry& all_teams, int games_per_team, unsigned threads);
+
+    // Generates the season, then postpones every block's crossroads games
+    // twice over (so slides fill the travel days and the rest become make-up
+    // blocks), postpones each host's first game after that, and closes a
+    // stadium a round at a time, checking ScheduleRepairer::verify() after
+    // every disruption. Returns true if every check passed; `disruptions`
+    // receives the number applied.
+    bool verifyRepair(const TeamRegistry& all_teams, int games_per_team, std::size_t& disruptions);
 
 private:
-    // Helper function to create a single residency block
-    ResidencyBlock createResidencyBlock(const Team& host, const std::vector<Team>& visitors);
+    // Helper function to fill a single residency block from the engine's plan,
+    // reusing `block`'s storage. Safe to call concurrently for different blocks.
+    void fillResidencyBlock(const PlannedBlock& planned, ResidencyBlock& block) const;
+
+    // Random stream for one block, keyed by (seed, season, host, round).
+    CounterRng blockStream(const PlannedBlock& planned) const;
 
-    // Implements the "alternating first bat" rule for Crossroads Games
-    std::vector<Game> generateCrossroadsGames(const Team& visitor1, const Team& visitor2, const Team& host_stadium, int num_games_in_series);
+    std::uint64_t seed_;
+    int season_index_ = 0;
+    unsigned block_threads_ = 1;
+    bool report_progress_ = true;
 
-    // Random number generator
-    std::mt19937 rng;
+    SeasonEngineConfig config_;
+    SeasonPlan last_plan_;
+    TeamAvailability last_availability_;
 };
 
 } // namespace LeagueSchedulerNS
@@ -0,0 +1,156 @@
+/**
+ * @file schedule_index.cpp
+ * @brief Read-only CSR query index over a generated season.
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "schedule_index.h"
+#include <algorithm>
+
+namespace LeagueSchedulerNS {
+
+namespace {
+
+// Counting-sort `games` (already in date order) into CSR lists. `for_each_key`
+// calls its `emit` argument once per list the game belongs to; iterating in
+// date order keeps every list sorted by date.
+template <typename KeysFn>
+void buildCsr(std::size_t key_count, const std::vector<Game>& games, KeysFn for_each_key,
+              std::vector<std::uint32_t>& offsets, std::vector<std::uint32_t>& entries) {
+    offsets.assign(key_count + 1, 0);
+    for (const Game& game : games) {
+        for_each_key(game, [&](std::size_t key) { ++offsets[key + 1]; });
+    }
+    for (std::size_t key = 0; key < key_count; ++key) {
+        offsets[key + 1] += offsets[key];
+    }
+    entries.resize(offsets[key_count]);
+    std::vector<std::uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (std::size_t i = 0; i < games.size(); ++i) {
+        for_each_key(games[i], [&](std::size_t key) { entries[cursor[key]++] = static_cast<std::uint32_t>(i); });
+    }
+}
+
+} // namespace
+
+void ScheduleIndex::build(const SeasonSchedule& season, std::size_t team_count) {
+    team_count_ = team_count;
+    games_.clear();
+    game_blocks_.clear();
+    date_offsets_.assign(1, 0);
+
+    std::size_t game_count = 0;
+    bool any = false;
+    for (const ResidencyBlock& block : season) {
+        for (const Game& game : block.games) {
+            if (!any || game.date < first_date_) {
+                first_date_ = game.date;
+            }
+            if (!any || game.date > last_date_) {
+                last_date_ = game.date;
+            }
+            any = true;
+        }
+        game_count += block.games.size();
+    }
+    if (!any) {
+        first_date_ = last_date_ = CalendarDate();
+    }
+
+    // Date order: one counting-sort pass over the season keyed by day.
+    if (any) {
+        const std::size_t days = static_cast<std::size_t>(last_date_ - first_date_) + 1;
+        date_offsets_.assign(days + 1, 0);
+        for (const ResidencyBlock& block : season) {
+            for (const Game& game : block.games) {
+                ++date_offsets_[static_cast<std::size_t>(game.date - first_date_) + 1];
+            }
+        }
+        for (std::size_t day = 0; day < days; ++day) {
+            date_offsets_[day + 1] += date_offsets_[day];
+        }
+        games_.resize(game_count);
+        game_blocks_.resize(game_count);
+        std::vector<std::uint32_t> cursor(date_offsets_.begin(), date_offsets_.end() - 1);
+        for (std::size_t b = 0; b < season.size(); ++b) {
+            for (const Game& game : season[b].games) {
+                const std::uint32_t slot = cursor[static_cast<std::size_t>(game.date - first_date_)]++;
+                games_[slot] = game;
+                game_blocks_[slot] = static_cast<std::uint32_t>(b);
+            }
+        }
+    }
+
+    buildCsr(team_count, games_,
+             [&](const Game& game, auto emit) {
+                 if (game.team1 < team_count) {
+                     emit(game.team1);
+                 }
+                 if (game.team2 < team_count && game.team2 != game.team1) {
+                     emit(game.team2);
+                 }
+             },
+             team_offsets_, team_games_);
+    buildCsr(team_count, games_,
+             [&](const Game& game, auto emit) {
+                 if (game.actual_host_stadium < team_count) {
+                     emit(game.actual_host_stadium);
+                 }
+             },
+             stadium_offsets_, stadium_games_);
+    buildCsr(team_count * kGameTypeCount, games_,
+             [&](const Game& game, auto emit) {
+                 if (game.actual_host_stadium < team_count &&
+                     static_cast<std::size_t>(game.game_type) < kGameTypeCount) {
+                     emit(stadiumTypeKey(game.actual_host_stadium, game.game_type));
+                 }
+             },
+             stadium_type_offsets_, stadium_type_games_);
+    buildCsr(kGameTypeCount, games_,
+             [&](const Game& game, auto emit) {
+                 if (static_cast<std::size_t>(game.game_type) < kGameTypeCount) {
+                     emit(static_cast<std::size_t>(game.game_type));
+                 }
+             },
+             type_offsets_, type_games_);
+}
+
+ScheduleIndex::GameSpan ScheduleIndex::gamesBetween(CalendarDate first, CalendarDate last) const {
+    if (games_.empty() || last < first || last < first_date_ || first > last_date_) {
+        return {};
+    }
+    const std::size_t from = static_cast<std::size_t>(std::max(first, first_date_) - first_date_);
+    const std::size_t to = static_cast<std::size_t>(std::min(last, last_date_) - first_date_) + 1;
+    return {games_.data() + date_offsets_[from], games_.data() + date_offsets_[to]};
+}
+
+ScheduleIndex::GameList ScheduleIndex::teamGames(TeamId team, CalendarDate first, CalendarDate last) const {
+    if (team >= team_count_ || last < first) {
+        return {};
+    }
+    const std::uint32_t* begin = team_games_.data() + team_offsets_[team];
+    const std::uint32_t* end = team_games_.data() + team_offsets_[team + 1];
+    const std::uint32_t* from = std::lower_bound(begin, end, first,
+                                                 [&](std::uint32_t i, CalendarDate d) { return games_[i].date < d; });
+    const std::uint32_t* to = std::upper_bound(from, end, last,
+                                               [&](CalendarDate d, std::uint32_t i) { return d < games_[i].date; });
+    return {from, to, games_.data()};
+}
+
+} // namespace LeagueSchedulerNS
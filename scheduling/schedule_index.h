@@ -0,0 +1,153 @@
+#ifndef SCHEDULE_INDEX_H
+#define SCHEDULE_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../money_and_players/calendar.h"
+#include "../money_and_players/game_data.h"
+#include "../money_and_players/team_registry.h"
+
+namespace LeagueSchedulerNS {
+
+// Read-only query index over a generated season.
+//
+// The season's games are copied once into a flat array sorted by date (ties
+// keep block order), so a date range is a contiguous slice of it. Team,
+// stadium and game-type lookups are CSR adjacency lists: one offsets array
+// per key plus one array of game indices, each list in date order.
+//
+//   ScheduleIndex index(season, registry.size());
+//   for (const Game& game : index.teamGames(denver, today, today + 6)) ...
+//   for (const Game& game : index.stadiumGames(miami, GameType::CROSSROADS_GAME)) ...
+//
+// Every query costs O(result), plus O(log games of the team) when it is
+// bounded by dates. Building is a few linear counting-sort passes. The index
+// is immutable once built, so any number of threads may query one instance
+// without locking. It does not refer back to the season; rebuild it after
+// the season changes (e.g., after a ScheduleRepairer pass).
+class ScheduleIndex {
+public:
+    // Games selected through an index list, in date order.
+    class GameList {
+    public:
+        class iterator {
+        public:
+            iterator(const std::uint32_t* position, const Game* games) : position_(position), games_(games) {}
+            const Game& operator*() const { return games_[*position_]; }
+            const Game* operator->() const { return &games_[*position_]; }
+            iterator& operator++() { ++position_; return *this; }
+            bool operator==(const iterator& other) const { return position_ == other.position_; }
+            bool operator!=(const iterator& other) const { return position_ != other.position_; }
+            // Position of the current game in ScheduleIndex::games().
+            std::uint32_t gameIndex() const { return *position_; }
+
+        private:
+            const std::uint32_t* position_;
+            const Game* games_;
+        };
+
+        GameList() = default;
+        GameList(const std::uint32_t* first, const std::uint32_t* last, const Game* games)
+            : first_(first), last_(last), games_(games) {}
+
+        iterator begin() const { return {first_, games_}; }
+        iterator end() const { return {last_, games_}; }
+        std::size_t size() const { return static_cast<std::size_t>(last_ - first_); }
+        bool empty() const { return first_ == last_; }
+        const Game& operator[](std::size_t i) const { return games_[first_[i]]; }
+        std::uint32_t gameIndex(std::size_t i) const { return first_[i]; }
+
+    private:
+        const std::uint32_t* first_ = nullptr;
+        const std::uint32_t* last_ = nullptr;
+        const Game* games_ = nullptr;
+    };
+
+    // A contiguous run of games() (date queries).
+    class GameSpan {
+    public:
+        GameSpan() = default;
+        GameSpan(const Game* first, const Game* last) : first_(first), last_(last) {}
+
+        const Game* begin() const { return first_; }
+        const Game* end() const { return last_; }
+        std::size_t size() const { return static_cast<std::size_t>(last_ - first_); }
+        bool empty() const { return first_ == last_; }
+        const Game& operator[](std::size_t i) const { return first_[i]; }
+
+    private:
+        const Game* first_ = nullptr;
+        const Game* last_ = nullptr;
+    };
+
+    ScheduleIndex() = default;
+    // `team_count` is the registry size; games naming a TeamId at or beyond
+    // it are left out of the team and stadium lists.
+    ScheduleIndex(const SeasonSchedule& season, std::size_t team_count) { build(season, team_count); }
+
+    void build(const SeasonSchedule& season, std::size_t team_count);
+
+    std::size_t teamCount() const { return team_count_; }
+    std::size_t gameCount() const { return games_.size(); }
+    bool empty() const { return games_.empty(); }
+    CalendarDate firstDate() const { return first_date_; }
+    CalendarDate lastDate() const { return last_date_; }
+
+    // Every game, sorted by date. Game indices returned by the lists point here.
+    GameSpan games() const { return {games_.data(), games_.data() + games_.size()}; }
+    // Season block (index into the indexed SeasonSchedule) that game `game_index` came from.
+    std::uint32_t blockOf(std::uint32_t game_index) const { return game_blocks_[game_index]; }
+
+    // Games played on `date`, or on [first, last] (inclusive).
+    GameSpan gamesOn(CalendarDate date) const { return gamesBetween(date, date); }
+    GameSpan gamesBetween(CalendarDate first, CalendarDate last) const;
+
+    // Games `team` plays in (either side), optionally only on [first, last].
+    GameList teamGames(TeamId team) const { return list(team_offsets_, team_games_, team); }
+    GameList teamGames(TeamId team, CalendarDate first, CalendarDate last) const;
+
+    // Games hosted at `stadium` (its actual_host_stadium), optionally of one type.
+    GameList stadiumGames(TeamId stadium) const { return list(stadium_offsets_, stadium_games_, stadium); }
+    GameList stadiumGames(TeamId stadium, GameType type) const {
+        return list(stadium_type_offsets_, stadium_type_games_, stadiumTypeKey(stadium, type));
+    }
+
+    GameList gamesOfType(GameType type) const {
+        return list(type_offsets_, type_games_, static_cast<std::size_t>(type));
+    }
+
+private:
+    std::size_t stadiumTypeKey(TeamId stadium, GameType type) const {
+        return static_cast<std::size_t>(stadium) * kGameTypeCount + static_cast<std::size_t>(type);
+    }
+    // List `key` of a CSR pair; empty for keys outside the index.
+    GameList list(const std::vector<std::uint32_t>& offsets, const std::vector<std::uint32_t>& entries,
+                  std::size_t key) const {
+        if (key + 1 >= offsets.size()) {
+            return {};
+        }
+        return {entries.data() + offsets[key], entries.data() + offsets[key + 1], games_.data()};
+    }
+
+    std::size_t team_count_ = 0;
+    CalendarDate first_date_;
+    CalendarDate last_date_;
+
+    std::vector<Game> games_;                  // Date order
+    std::vector<std::uint32_t> game_blocks_;   // Parallel to games_
+    std::vector<std::uint32_t> date_offsets_;  // Day d (from first_date_) is games_[offsets[d], offsets[d + 1])
+
+    std::vector<std::uint32_t> team_offsets_;          // team_count + 1
+    std::vector<std::uint32_t> team_games_;
+    std::vector<std::uint32_t> stadium_offsets_;       // team_count + 1
+    std::vector<std::uint32_t> stadium_games_;
+    std::vector<std::uint32_t> stadium_type_offsets_;  // team_count * kGameTypeCount + 1
+    std::vector<std::uint32_t> stadium_type_games_;
+    std::vector<std::uint32_t> type_offsets_;          // kGameTypeCount + 1
+    std::vector<std::uint32_t> type_games_;
+};
+
+} // namespace LeagueSchedulerNS
+
+#endif // SCHEDULE_INDEX_H
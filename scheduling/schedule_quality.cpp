@@ -0,0 +1,576 @@
+/**
+ * @file schedule_quality.cpp
+ * @brief Schedule quality scoring: distance matrix, full evaluation and incremental move deltas.
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "schedule_quality.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include "../concurrency/work_stealing_pool.h"
+
+namespace LeagueSchedulerNS {
+
+namespace {
+
+struct CityLocation {
+    const char* city;
+    double latitude;
+    double longitude;
+};
+
+// Downtown coordinates of the lore's cities.
+constexpr CityLocation kCityLocations[] = {
+    {"Maine", 43.661, -70.255},          // Portland
+    {"New York", 40.713, -74.006},
+    {"Philadelphia", 39.953, -75.165},
+    {"Pittsburgh", 40.441, -79.996},
+    {"Atlanta", 33.749, -84.388},
+    {"Miami", 25.762, -80.192},
+    {"Charlotte", 35.227, -80.843},
+    {"Cleveland", 41.499, -81.694},
+    {"Detroit", 42.331, -83.046},
+    {"Los Angeles", 34.052, -118.244},
+    {"San Diego", 32.716, -117.161},
+    {"San Francisco", 37.775, -122.419},
+    {"Seattle", 47.606, -122.332},
+    {"Austin", 30.267, -97.743},
+    {"Dallas", 32.777, -96.797},
+    {"Denver", 39.739, -104.990},
+    {"St. Louis", 38.627, -90.199},
+    {"Kansas City", 39.100, -94.579},
+};
+
+double haversineMiles(const GeoPoint& a, const GeoPoint& b) {
+    constexpr double kEarthRadiusMiles = 3958.8;
+    constexpr double kRadians = 3.14159265358979323846 / 180.0;
+    const double dlat = (b.latitude - a.latitude) * kRadians;
+    const double dlon = (b.longitude - a.longitude) * kRadians;
+    const double h = std::sin(dlat / 2) * std::sin(dlat / 2) +
+                     std::cos(a.latitude * kRadians) * std::cos(b.latitude * kRadians) *
+                     std::sin(dlon / 2) * std::sin(dlon / 2);
+    return 2.0 * kEarthRadiusMiles * std::asin(std::min(1.0, std::sqrt(h)));
+}
+
+double square(double x) { return x * x; }
+
+} // namespace
+
+bool knownCityLocation(const std::string& city, GeoPoint& location) {
+    for (const CityLocation& known : kCityLocations) {
+        if (city == known.city) {
+            location.latitude = known.latitude;
+            location.longitude = known.longitude;
+            return true;
+        }
+    }
+    return false;
+}
+
+// --- DistanceMatrix ---
+
+DistanceMatrix::DistanceMatrix(const TeamRegistry& teams) {
+    std::unordered_map<std::string, std::uint32_t> city_index;
+    std::vector<GeoPoint> cities;
+    std::vector<char> known;
+    std::uint32_t unknown = 0xFFFFFFFFu;
+    city_of_team_.resize(teams.size());
+    for (std::size_t t = 0; t < teams.size(); ++t) {
+        const std::string& city = teams[static_cast<TeamId>(t)].city;
+        auto found = city_index.find(city);
+        if (found != city_index.end()) {
+            city_of_team_[t] = found->second;
+            unknown_teams_ += known[found->second] ? 0 : 1;
+            continue;
+        }
+        GeoPoint location;
+        if (knownCityLocation(city, location)) {
+            city_of_team_[t] = static_cast<std::uint32_t>(cities.size());
+            city_index.emplace(city, city_of_team_[t]);
+            cities.push_back(location);
+            known.push_back(1);
+        } else {
+            if (unknown == 0xFFFFFFFFu) {
+                unknown = static_cast<std::uint32_t>(cities.size());
+                cities.push_back(GeoPoint());
+                known.push_back(0);
+            }
+            city_of_team_[t] = unknown;
+            city_index.emplace(city, unknown);
+            ++unknown_teams_;
+        }
+    }
+    build(cities, known);
+}
+
+DistanceMatrix::DistanceMatrix(const std::vector<GeoPoint>& locations) {
+    std::map<std::pair<double, double>, std::uint32_t> point_index;
+    std::vector<GeoPoint> cities;
+    city_of_team_.resize(locations.size());
+    for (std::size_t t = 0; t < locations.size(); ++t) {
+        auto inserted = point_index.emplace(std::make_pair(locations[t].latitude, locations[t].longitude),
+                                            static_cast<std::uint32_t>(cities.size()));
+        if (inserted.second) {
+            cities.push_back(locations[t]);
+        }
+        city_of_team_[t] = inserted.first->second;
+    }
+    build(cities, std::vector<char>(cities.size(), 1));
+}
+
+void DistanceMatrix::build(const std::vector<GeoPoint>& cities, const std::vector<char>& known) {
+    city_count_ = cities.size();
+    miles_.assign(city_count_ * city_count_, 0.0f);
+    for (std::size_t a = 0; a < city_count_; ++a) {
+        for (std::size_t b = a + 1; b < city_count_; ++b) {
+            if (!known[a] || !known[b]) {
+                continue;
+            }
+            const float miles = static_cast<float>(haversineMiles(cities[a], cities[b]));
+            miles_[a * city_count_ + b] = miles;
+            miles_[b * city_count_ + a] = miles;
+        }
+    }
+}
+
+// --- ScheduleScorer ---
+
+ScheduleScorer::ScheduleScorer(const TeamRegistry& teams, const DistanceMatrix& distances, const QualityConfig& config)
+    : config_(config), distances_(distances), topology_(teams), team_count_(teams.size()) {}
+
+ScheduleScorer::~ScheduleScorer() = default;
+
+void ScheduleScorer::collectBlocks(const SeasonSchedule& season, std::vector<Block>& blocks,
+                                   std::vector<TeamId>& block_teams) const {
+    blocks.clear();
+    block_teams.clear();
+    blocks.reserve(season.size());
+    block_teams.reserve(season.size() * 3);
+    for (const ResidencyBlock& residency : season) {
+        Block block;
+        block.start = residency.start_date.dayNumber();
+        block.length = residency.end_date.dayNumber() - block.start;
+        block.host = residency.host_team;
+        block.first_team = static_cast<std::uint32_t>(block_teams.size());
+        if (residency.host_team < team_count_) {
+            block_teams.push_back(residency.host_team);
+        }
+        for (TeamId visitor : residency.visiting_residents) {
+            if (visitor < team_count_) {
+                block_teams.push_back(visitor);
+            }
+        }
+        block.team_count = static_cast<std::uint32_t>(block_teams.size()) - block.first_team;
+        blocks.push_back(block);
+    }
+}
+
+void ScheduleScorer::countGames(const ResidencyBlock& block, TeamQuality* teams) const {
+    for (const Game& game : block.games) {
+        const TeamId a = game.team1;
+        const TeamId b = game.team2;
+        if (a >= team_count_ || b >= team_count_) {
+            continue;
+        }
+        ++teams[a].games;
+        ++teams[b].games;
+        const TeamId stadium = game.actual_host_stadium;
+        if (game.game_type == GameType::CROSSROADS_GAME || (a != stadium && b != stadium)) {
+            const TeamId last = game.designated_home_team_for_batting;
+            ++teams[last].crossroads_batting_last;
+            ++teams[last == a ? b : a].crossroads_batting_first;
+        } else {
+            ++teams[stadium].home_games;
+            ++teams[stadium == a ? b : a].away_games;
+        }
+        const std::uint8_t flags = topology_.pairFlags(a, b);
+        const int same_union = flags & kSameUnion;
+        const int same_region = (flags & kSameRegion) >> 1;
+        teams[a].union_games += same_union;
+        teams[b].union_games += same_union;
+        teams[a].region_games += same_region;
+        teams[b].region_games += same_region;
+    }
+}
+
+bool ScheduleScorer::inBlock(TeamId team, std::uint32_t block) const {
+    const Block& b = blocks_[block];
+    const TeamId* first = block_teams_.data() + b.first_team;
+    return std::find(first, first + b.team_count, team) != first + b.team_count;
+}
+
+double ScheduleScorer::hopCost(TeamId team, const Stop* from, const Stop* to) const {
+    const TeamId a = from ? from->host : team;
+    const TeamId b = to ? to->host : team;
+    double cost = config_.weights.travel_per_1000_miles * 0.001 * distances_.miles(a, b);
+    if (from && to) {
+        const int gap = to->start - from->end - 1;
+        if (gap < config_.min_rest_days) {
+            cost += config_.weights.short_rest;
+        }
+        if (gap < 0) {
+            cost += config_.weights.overlap;
+        }
+    }
+    return cost;
+}
+
+void ScheduleScorer::walk(TeamId team, const Stop* stops, std::size_t count, TeamQuality& quality) const {
+    double miles = 0.0;
+    int rest_days = 0;
+    int short_rests = 0;
+    int overlaps = 0;
+    TeamId at = team;
+    for (std::size_t i = 0; i < count; ++i) {
+        miles += distances_.miles(at, stops[i].host);
+        at = stops[i].host;
+        if (i > 0) {
+            const int gap = stops[i].start - stops[i - 1].end - 1;
+            rest_days += std::max(gap, 0);
+            short_rests += gap < config_.min_rest_days ? 1 : 0;
+            overlaps += gap < 0 ? 1 : 0;
+        }
+    }
+    miles += distances_.miles(at, team);
+    quality.travel_miles = miles;
+    quality.blocks = static_cast<int>(count);
+    quality.rest_days = rest_days;
+    quality.short_rests = short_rests;
+    quality.overlaps = overlaps;
+}
+
+double ScheduleScorer::teamCost(const TeamQuality& quality) const {
+    return config_.weights.travel_per_1000_miles * 0.001 * quality.travel_miles +
+           config_.weights.short_rest * quality.short_rests + config_.weights.overlap * quality.overlaps;
+}
+
+void ScheduleScorer::addStaticTerms(QualityReport& report) const {
+    const QualityWeights& w = config_.weights;
+    report.travel_miles = 0.0;
+    report.short_rests = 0;
+    report.overlaps = 0;
+    report.home_away_cost = report.first_bat_cost = report.union_mix_cost = report.region_mix_cost = 0.0;
+    for (const TeamQuality& team : report.teams) {
+        report.travel_miles += team.travel_miles;
+        report.short_rests += team.short_rests;
+        report.overlaps += team.overlaps;
+        report.home_away_cost += w.home_away * square(team.home_games - team.away_games);
+        report.first_bat_cost += w.first_bat * square(team.crossroads_batting_last - team.crossroads_batting_first);
+        if (team.games > 0) {
+            report.union_mix_cost += w.union_mix * square(static_cast<double>(team.union_games) / team.games - config_.target_union_share);
+            report.region_mix_cost +=
+                w.region_mix * square(static_cast<double>(team.region_games) / team.games - config_.target_region_share);
+        }
+    }
+    report.travel_cost = w.travel_per_1000_miles * 0.001 * report.travel_miles;
+    report.rest_cost = w.short_rest * report.short_rests + w.overlap * report.overlaps;
+}
+
+QualityReport ScheduleScorer::evaluate(const SeasonSchedule& season, unsigned threads) const {
+    if (!pool_ || pool_threads_ != threads) {
+        pool_.reset();
+        pool_ = std::make_unique<WorkStealingPool>(threads);
+        pool_threads_ = threads;
+    }
+    return evaluate(season, *pool_);
+}
+
+QualityReport ScheduleScorer::evaluate(const SeasonSchedule& season, WorkStealingPool& pool) const {
+    QualityReport report;
+    report.teams.assign(team_count_, TeamQuality());
+    if (team_count_ == 0) {
+        return report;
+    }
+
+    std::vector<Block> blocks;
+    std::vector<TeamId> block_teams;
+    collectBlocks(season, blocks, block_teams);
+
+    // Game-level terms: per-worker accumulators over blocks, then one reduction.
+    std::vector<std::vector<TeamQuality>> partial(pool.size(), std::vector<TeamQuality>(team_count_));
+    pool.parallelFor(season.size(), 64, [&](std::size_t begin, std::size_t end, unsigned worker) {
+        for (std::size_t i = begin; i < end; ++i) {
+            countGames(season[i], partial[worker].data());
+        }
+    });
+    for (const std::vector<TeamQuality>& worker : partial) {
+        for (std::size_t t = 0; t < team_count_; ++t) {
+            TeamQuality& into = report.teams[t];
+            const TeamQuality& from = worker[t];
+            into.games += from.games;
+            into.home_games += from.home_games;
+            into.away_games += from.away_games;
+            into.crossroads_batting_last += from.crossroads_batting_last;
+            into.crossroads_batting_first += from.crossroads_batting_first;
+            into.union_games += from.union_games;
+            into.region_games += from.region_games;
+        }
+    }
+
+    // Itineraries: every team's stops in one CSR array, sorted and walked per team.
+    std::vector<std::uint32_t> offsets(team_count_ + 1, 0);
+    for (TeamId team : block_teams) {
+        ++offsets[team + 1];
+    }
+    for (std::size_t t = 0; t < team_count_; ++t) {
+        offsets[t + 1] += offsets[t];
+    }
+    std::vector<Stop> stops(block_teams.size());
+    std::vector<std::uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (std::uint32_t b = 0; b < blocks.size(); ++b) {
+        const Block& block = blocks[b];
+        for (std::uint32_t i = 0; i < block.team_count; ++i) {
+            stops[cursor[block_teams[block.first_team + i]]++] = stopOf(block, b, block.start);
+        }
+    }
+    pool.parallelFor(team_count_, 64, [&](std::size_t begin, std::size_t end, unsigned) {
+        for (std::size_t t = begin; t < end; ++t) {
+            Stop* first = stops.data() + offsets[t];
+            Stop* last = stops.data() + offsets[t + 1];
+            std::sort(first, last, stopBefore);
+            walk(static_cast<TeamId>(t), first, static_cast<std::size_t>(last - first), report.teams[t]);
+        }
+    });
+
+    addStaticTerms(report);
+    return report;
+}
+
+void ScheduleScorer::load(const SeasonSchedule& season) {
+    collectBlocks(season, blocks_, block_teams_);
+    itineraries_.assign(team_count_, std::vector<Stop>());
+    team_quality_.assign(team_count_, TeamQuality());
+    for (std::uint32_t b = 0; b < blocks_.size(); ++b) {
+        const Block& block = blocks_[b];
+        for (std::uint32_t i = 0; i < block.team_count; ++i) {
+            itineraries_[block_teams_[block.first_team + i]].push_back(stopOf(block, b, block.start));
+        }
+        countGames(season[b], team_quality_.data());
+    }
+    dynamic_cost_ = 0.0;
+    for (std::size_t t = 0; t < team_count_; ++t) {
+        std::vector<Stop>& stops = itineraries_[t];
+        std::sort(stops.begin(), stops.end(), stopBefore);
+        walk(static_cast<TeamId>(t), stops.data(), stops.size(), team_quality_[t]);
+        dynamic_cost_ += teamCost(team_quality_[t]);
+    }
+    QualityReport terms;
+    terms.teams = team_quality_;
+    addStaticTerms(terms);
+    static_cost_ = terms.home_away_cost + terms.first_bat_cost + terms.union_mix_cost + terms.region_mix_cost;
+}
+
+QualityReport ScheduleScorer::report() const {
+    QualityReport report;
+    report.teams = team_quality_;
+    addStaticTerms(report);
+    return report;
+}
+
+// Re-costs one team's itinerary around the changed stops only.
+//
+// Each removed stop p touches the hops (p-1, p) and (p, p+1); each inserted
+// stop lands in the gap between two existing stops q-1 and q. Those node
+// ranges ("windows", where -1 and the itinerary size stand for the trip from
+// and back to home) are merged where they share a hop, and every window is
+// costed twice: as it is, and with the removed stops dropped and the new ones
+// merged in by date. Hops outside the windows are unchanged.
+double ScheduleScorer::teamDelta(TeamId team, const Change* changes, int change_count) const {
+    const std::vector<Stop>& stops = itineraries_[team];
+    const long size = static_cast<long>(stops.size());
+
+    long removed[2];
+    Stop inserted[2];
+    int moved = 0;
+    struct Window {
+        long lo;
+        long hi;
+    };
+    Window windows[4];
+    int window_count = 0;
+    for (int c = 0; c < change_count && moved < 2; ++c) {
+        const std::uint32_t block = changes[c].block;
+        if (!inBlock(team, block)) {
+            continue;
+        }
+        const Stop old_stop = stopOf(blocks_[block], block, blocks_[block].start);
+        const Stop new_stop = stopOf(blocks_[block], block, changes[c].new_start);
+        const long p = std::lower_bound(stops.begin(), stops.end(), old_stop, stopBefore) - stops.begin();
+        const long q = std::lower_bound(stops.begin(), stops.end(), new_stop, stopBefore) - stops.begin();
+        removed[moved] = p;
+        inserted[moved] = new_stop;
+        ++moved;
+        windows[window_count++] = Window{p - 1, p + 1};
+        windows[window_count++] = Window{q - 1, q};
+    }
+    if (moved == 0) {
+        return 0.0;
+    }
+    if (moved == 2 && stopBefore(inserted[1], inserted[0])) {
+        std::swap(inserted[0], inserted[1]);
+    }
+
+    // Insertion sort by lo: at most four windows.
+    for (int i = 1; i < window_count; ++i) {
+        const Window window = windows[i];
+        int j = i;
+        for (; j > 0 && windows[j - 1].lo > window.lo; --j) {
+            windows[j] = windows[j - 1];
+        }
+        windows[j] = window;
+    }
+    int merged = 0;
+    for (int i = 1; i < window_count; ++i) {
+        if (windows[i].lo < windows[merged].hi) {
+            windows[merged].hi = std::max(windows[merged].hi, windows[i].hi);
+        } else {
+            windows[++merged] = windows[i];
+        }
+    }
+    window_count = merged + 1;
+
+    auto node = [&](long index) -> const Stop* { return index < 0 || index >= size ? nullptr : &stops[index]; };
+    auto isRemoved = [&](long index) {
+        for (int i = 0; i < moved; ++i) {
+            if (removed[i] == index) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    double delta = 0.0;
+    int next_insert = 0;
+    for (int w = 0; w < window_count; ++w) {
+        const long lo = windows[w].lo;
+        const long hi = windows[w].hi;
+        for (long x = lo; x < hi; ++x) {
+            delta -= hopCost(team, node(x), node(x + 1));
+        }
+
+        const Stop* prev = node(lo);
+        for (long x = lo + 1; x <= hi; ++x) {
+            const Stop* current = node(x);
+            if (x < hi && isRemoved(x)) {
+                continue;
+            }
+            while (next_insert < moved && (current == nullptr || stopBefore(inserted[next_insert], *current))) {
+                delta += hopCost(team, prev, &inserted[next_insert]);
+                prev = &inserted[next_insert++];
+            }
+            delta += hopCost(team, prev, current);
+            prev = current;
+        }
+    }
+    return delta;
+}
+
+double ScheduleScorer::delta(const Change* changes, int change_count) const {
+    double delta = 0.0;
+    for (int c = 0; c < change_count; ++c) {
+        const Block& block = blocks_[changes[c].block];
+        for (std::uint32_t i = 0; i < block.team_count; ++i) {
+            const TeamId team = block_teams_[block.first_team + i];
+            bool seen = false;
+            for (int earlier = 0; earlier < c && !seen; ++earlier) {
+                seen = inBlock(team, changes[earlier].block);
+            }
+            if (!seen) {
+                delta += teamDelta(team, changes, change_count);
+            }
+        }
+    }
+    return delta;
+}
+
+void ScheduleScorer::apply(const Change* changes, int change_count) {
+    for (int c = 0; c < change_count; ++c) {
+        const Block& block = blocks_[changes[c].block];
+        for (std::uint32_t i = 0; i < block.team_count; ++i) {
+            const TeamId team = block_teams_[block.first_team + i];
+            bool seen = false;
+            for (int earlier = 0; earlier < c && !seen; ++earlier) {
+                seen = inBlock(team, changes[earlier].block);
+            }
+            if (seen) {
+                continue;
+            }
+
+            std::vector<Stop>& stops = itineraries_[team];
+            for (int m = 0; m < change_count; ++m) {
+                const std::uint32_t index = changes[m].block;
+                if (!inBlock(team, index)) {
+                    continue;
+                }
+                const Stop old_stop = stopOf(blocks_[index], index, blocks_[index].start);
+                stops.erase(std::lower_bound(stops.begin(), stops.end(), old_stop, stopBefore));
+            }
+            for (int m = 0; m < change_count; ++m) {
+                const std::uint32_t index = changes[m].block;
+                if (!inBlock(team, index)) {
+                    continue;
+                }
+                const Stop new_stop = stopOf(blocks_[index], index, changes[m].new_start);
+                stops.insert(std::lower_bound(stops.begin(), stops.end(), new_stop, stopBefore), new_stop);
+            }
+            TeamQuality& quality = team_quality_[team];
+            dynamic_cost_ -= teamCost(quality);
+            walk(team, stops.data(), stops.size(), quality);
+            dynamic_cost_ += teamCost(quality);
+        }
+    }
+    for (int c = 0; c < change_count; ++c) {
+        blocks_[changes[c].block].start = changes[c].new_start;
+    }
+}
+
+double ScheduleScorer::deltaMove(std::size_t block, CalendarDate start) const {
+    const Change change{static_cast<std::uint32_t>(block), start.dayNumber()};
+    return delta(&change, 1);
+}
+
+double ScheduleScorer::deltaSwap(std::size_t a, std::size_t b) const {
+    if (a == b) {
+        return 0.0;
+    }
+    const Change changes[2] = {{static_cast<std::uint32_t>(a), blocks_[b].start},
+                               {static_cast<std::uint32_t>(b), blocks_[a].start}};
+    return delta(changes, 2);
+}
+
+void ScheduleScorer::applyMove(std::size_t block, CalendarDate start) {
+    const Change change{static_cast<std::uint32_t>(block), start.dayNumber()};
+    apply(&change, 1);
+}
+
+void ScheduleScorer::applySwap(std::size_t a, std::size_t b) {
+    if (a == b) {
+        return;
+    }
+    const Change changes[2] = {{static_cast<std::uint32_t>(a), blocks_[b].start},
+                               {static_cast<std::uint32_t>(b), blocks_[a].start}};
+    apply(changes, 2);
+}
+
+} // namespace LeagueSchedulerNS
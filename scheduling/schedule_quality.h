@@ -0,0 +1,217 @@
+#ifndef SCHEDULE_QUALITY_H
+#define SCHEDULE_QUALITY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../money_and_players/calendar.h"
+#include "../money_and_players/game_data.h"
+#include "../money_and_players/league_topology.h"
+#include "../money_and_players/team_registry.h"
+
+namespace LeagueSchedulerNS {
+
+class WorkStealingPool;
+
+struct GeoPoint {
+    double latitude = 0.0;    // Degrees
+    double longitude = 0.0;
+};
+
+// Location of a league city from the built-in table (the lore's 18 cities).
+// Returns false for a city it does not know.
+bool knownCityLocation(const std::string& city, GeoPoint& location);
+
+// Great-circle miles between every pair of distinct team cities.
+//
+// Teams sharing a Team::city share a row, so the matrix is cities x cities
+// (not teams x teams) and a lookup is two array reads. Teams whose city has
+// no location are all placed at one "unknown" point, zero miles from
+// everything.
+class DistanceMatrix {
+public:
+    DistanceMatrix() = default;
+    // Locates cities through knownCityLocation().
+    explicit DistanceMatrix(const TeamRegistry& teams);
+    // One location per TeamId.
+    explicit DistanceMatrix(const std::vector<GeoPoint>& locations);
+
+    std::size_t teamCount() const { return city_of_team_.size(); }
+    std::size_t cityCount() const { return city_count_; }
+    std::size_t unknownTeams() const { return unknown_teams_; }
+
+    float miles(TeamId a, TeamId b) const { return miles_[city_of_team_[a] * city_count_ + city_of_team_[b]]; }
+
+private:
+    // `known[c]` is false for the shared unknown point, whose row stays zero.
+    void build(const std::vector<GeoPoint>& cities, const std::vector<char>& known);
+
+    std::vector<std::uint32_t> city_of_team_;
+    std::size_t city_count_ = 0;
+    std::size_t unknown_teams_ = 0;
+    std::vector<float> miles_;     // [city_a * city_count + city_b]
+};
+
+struct QualityWeights {
+    double travel_per_1000_miles = 1.0;
+    double short_rest = 2.0;        // Per gap between a team's blocks shorter than min_rest_days
+    double overlap = 1000.0;        // Per pair of a team's blocks that overlap (a double booking)
+    double home_away = 0.05;        // Per squared game of (home games - away games), per team
+    double first_bat = 0.5;         // Per squared game of (batting last - batting first) in crossroads games
+    double union_mix = 20.0;        // Per squared deviation of a team's in-union game share from the target
+    double region_mix = 0.0;        // Same for the in-region share (off by default)
+};
+
+struct QualityConfig {
+    int min_rest_days = 1;           // Off days wanted between two residency blocks of a team
+    double target_union_share = 0.5; // Share of a team's games that should be against its own union
+    double target_region_share = 0.25;
+    QualityWeights weights;
+};
+
+// Per-team aggregates. Crossroads games count as neither home nor away.
+struct TeamQuality {
+    double travel_miles = 0.0;       // Home -> each block's host stadium in date order -> home
+    int blocks = 0;
+    int rest_days = 0;               // Days between consecutive blocks
+    int short_rests = 0;
+    int overlaps = 0;                // Consecutive blocks sharing a day (also counted as short rests)
+    int games = 0;
+    int home_games = 0;
+    int away_games = 0;
+    int crossroads_batting_last = 0;
+    int crossroads_batting_first = 0;
+    int union_games = 0;             // Against a team of the same union
+    int region_games = 0;            // Against a team of the same region
+};
+
+struct QualityReport {
+    std::vector<TeamQuality> teams;  // Indexed by TeamId
+
+    double travel_miles = 0.0;
+    int short_rests = 0;
+    int overlaps = 0;
+    // Weighted terms; total() is their sum (lower is better).
+    double travel_cost = 0.0;
+    double rest_cost = 0.0;          // Short rests and overlaps
+    double home_away_cost = 0.0;
+    double first_bat_cost = 0.0;
+    double union_mix_cost = 0.0;
+    double region_mix_cost = 0.0;
+
+    double total() const {
+        return travel_cost + rest_cost + home_away_cost + first_bat_cost + union_mix_cost + region_mix_cost;
+    }
+};
+
+// Scores a season's residency blocks on travel, rest, home/away balance,
+// crossroads first-bat fairness and union/region mix.
+//
+// evaluate() scores a whole season in parallel (blocks, then teams, on a
+// work-stealing pool). For optimizers, load() keeps the season as per-team
+// itineraries (each team's blocks sorted by date) with running per-team
+// aggregates. Moving a block in time or swapping two blocks' dates only
+// changes travel and rest, and only for the teams in those blocks, so
+// deltaMove()/deltaSwap() re-cost just the stops around each change
+// (O(log blocks per team) for each of at most six teams); the balance and mix
+// terms depend only on who plays whom and stay as computed by load().
+// Delta queries are const and may run concurrently; apply*() may not.
+//
+//   ScheduleScorer scorer(registry, DistanceMatrix(registry));
+//   scorer.load(season);
+//   if (scorer.deltaSwap(a, b) < 0.0) scorer.applySwap(a, b);
+class ScheduleScorer {
+public:
+    ScheduleScorer(const TeamRegistry& teams, const DistanceMatrix& distances,
+                   const QualityConfig& config = QualityConfig());
+    ~ScheduleScorer();
+
+    const QualityConfig& config() const { return config_; }
+
+    // Full evaluation (`threads == 0` = one per hardware thread). The pool is
+    // created on the first call and kept for later calls with the same
+    // thread count, so this overload must not run concurrently with itself.
+    QualityReport evaluate(const SeasonSchedule& season, unsigned threads = 0) const;
+    // Same, on the caller's pool.
+    QualityReport evaluate(const SeasonSchedule& season, WorkStealingPool& pool) const;
+
+    // --- Incremental scoring over a loaded season ---
+    void load(const SeasonSchedule& season);
+    std::size_t blockCount() const { return blocks_.size(); }
+    CalendarDate blockStart(std::size_t block) const { return CalendarDate(static_cast<std::uint16_t>(blocks_[block].start)); }
+
+    // Current total and report (what evaluate() gives for the season with every
+    // applied move; cost() is kept as a running sum, so only up to rounding).
+    double cost() const { return static_cost_ + dynamic_cost_; }
+    QualityReport report() const;
+
+    // Change in cost if `block` started on `start` (same length).
+    double deltaMove(std::size_t block, CalendarDate start) const;
+    // Change in cost if blocks `a` and `b` traded start dates.
+    double deltaSwap(std::size_t a, std::size_t b) const;
+    void applyMove(std::size_t block, CalendarDate start);
+    void applySwap(std::size_t a, std::size_t b);
+
+private:
+    // One residency block as the scorer sees it: dates, host and its teams
+    // (block_teams_[first_team, first_team + team_count), host first).
+    struct Block {
+        int start = 0;               // CalendarDate day numbers
+        int length = 0;              // end - start
+        TeamId host = kInvalidTeamId;
+        std::uint32_t first_team = 0;
+        std::uint32_t team_count = 0;
+    };
+    // A team's visit to a block, ordered by (start, block).
+    struct Stop {
+        int start;
+        int end;
+        TeamId host;
+        std::uint32_t block;
+    };
+    struct Change {
+        std::uint32_t block;
+        int new_start;
+    };
+
+    static bool stopBefore(const Stop& a, const Stop& b) {
+        return a.start != b.start ? a.start < b.start : a.block < b.block;
+    }
+    static Stop stopOf(const Block& block, std::uint32_t index, int start) {
+        return Stop{start, start + block.length, block.host, index};
+    }
+    void collectBlocks(const SeasonSchedule& season, std::vector<Block>& blocks, std::vector<TeamId>& block_teams) const;
+    // Game counts, home/away, first bat and union/region games of one block, added to `teams`.
+    void countGames(const ResidencyBlock& block, TeamQuality* teams) const;
+    bool inBlock(TeamId team, std::uint32_t block) const;
+    // Weighted travel + rest for the hop from `from` to `to` (null = the team's home).
+    double hopCost(TeamId team, const Stop* from, const Stop* to) const;
+    // Travel miles, rest days and short rests along a sorted itinerary.
+    void walk(TeamId team, const Stop* stops, std::size_t count, TeamQuality& quality) const;
+    double teamCost(const TeamQuality& quality) const;
+    double teamDelta(TeamId team, const Change* changes, int change_count) const;
+    double delta(const Change* changes, int change_count) const;
+    void apply(const Change* changes, int change_count);
+    void addStaticTerms(QualityReport& report) const;
+
+    QualityConfig config_;
+    DistanceMatrix distances_;
+    LeagueTopology topology_;
+    std::size_t team_count_ = 0;
+
+    std::vector<Block> blocks_;
+    std::vector<TeamId> block_teams_;
+    std::vector<std::vector<Stop>> itineraries_;   // [team], sorted by (start, block)
+    std::vector<TeamQuality> team_quality_;        // Running per-team aggregates
+    double static_cost_ = 0.0;                     // Home/away, first-bat and union-mix terms
+    double dynamic_cost_ = 0.0;                    // Travel and rest terms
+
+    mutable std::unique_ptr<WorkStealingPool> pool_;  // evaluate(season, threads)'s pool
+    mutable unsigned pool_threads_ = 0;               // The thread count it was created for
+};
+
+} // namespace LeagueSchedulerNS
+
+#endif // SCHEDULE_QUALITY_H
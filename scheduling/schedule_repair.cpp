@@ -0,0 +1,488 @@
+/**
+ * @file schedule_repair.cpp
+ * @brief Incremental repair of a generated season (postponed games, closed stadiums).
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "schedule_repair.h"
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include "counter_rng.h"
+#include "series_policy.h"
+
+namespace LeagueSchedulerNS {
+
+namespace {
+
+// Stream tag for re-drawn first-bat flips, disjoint from the scheduler's
+// engine (1) and block (2) streams.
+constexpr std::uint64_t kRepairStream = 3;
+
+// Teams that play in `block` (a make-up block's host may not).
+std::vector<TeamId> participants(const ResidencyBlock& block) {
+    std::vector<TeamId> teams;
+    for (const Game& game : block.games) {
+        for (TeamId team : {game.team1, game.team2}) {
+            if (std::find(teams.begin(), teams.end(), team) == teams.end()) {
+                teams.push_back(team);
+            }
+        }
+    }
+    return teams;
+}
+
+} // namespace
+
+ScheduleRepairer::ScheduleRepairer(SeasonSchedule& season, std::size_t team_count, CalendarDate season_start,
+                                   std::uint64_t seed, int season_index)
+    : season_(season), season_start_(season_start), seed_(seed), season_index_(season_index) {
+    // The calendar runs through the travel day after the last block.
+    int season_days = 0;
+    for (const ResidencyBlock& block : season_) {
+        season_days = std::max(season_days, dayOf(block.end_date) + 2);
+    }
+    teams_.reset(team_count, season_days);
+    stadiums_.reset(team_count, season_days);
+    blocks_by_team_.assign(team_count, {});
+    blocks_by_stadium_.assign(team_count, {});
+    for (std::size_t b = 0; b < season_.size(); ++b) {
+        bookBlock(season_[b]);
+        indexBlock(b);
+        series_origin_.push_back(static_cast<std::uint32_t>(b));
+    }
+    makeup_blocks_.resize(season_.size());
+}
+
+RepairReport ScheduleRepairer::apply(const ScheduleDisruption& disruption) {
+    RepairReport report;
+    if (disruption.team >= blocks_by_team_.size()) {
+        ++report.unresolved;
+        return report;
+    }
+    if (disruption.type == ScheduleDisruption::Type::GAME_POSTPONED) {
+        postpone(disruption, report);
+    } else {
+        closeStadium(disruption, report);
+    }
+    return report;
+}
+
+RepairReport ScheduleRepairer::apply(const std::vector<ScheduleDisruption>& disruptions) {
+    RepairReport total;
+    for (const ScheduleDisruption& disruption : disruptions) {
+        RepairReport report = apply(disruption);
+        for (std::size_t block : report.changed_blocks) {
+            if (std::find(total.changed_blocks.begin(), total.changed_blocks.end(), block) == total.changed_blocks.end()) {
+                total.changed_blocks.push_back(block);
+            }
+        }
+        total.games_moved += report.games_moved;
+        total.unresolved += report.unresolved;
+    }
+    return total;
+}
+
+long ScheduleRepairer::findBlock(TeamId team, CalendarDate date) const {
+    // A team's blocks only overlap where a make-up game landed on a day
+    // released inside one of its earlier blocks, so walk back from the last
+    // block starting by `date` over those that started within the longest
+    // block's span.
+    const std::vector<std::uint32_t>& blocks = blocks_by_team_[team];
+    auto it = std::upper_bound(blocks.begin(), blocks.end(), date,
+                               [&](CalendarDate d, std::uint32_t b) { return d < season_[b].start_date; });
+    while (it != blocks.begin()) {
+        const std::uint32_t candidate = *--it;
+        const ResidencyBlock& block = season_[candidate];
+        if (date - block.start_date > max_block_days_) {
+            break;
+        }
+        if (block.end_date < date) {
+            continue;
+        }
+        for (const Game& game : block.games) {
+            if (game.date == date && (game.team1 == team || game.team2 == team)) {
+                return static_cast<long>(candidate);
+            }
+        }
+    }
+    return -1;
+}
+
+void ScheduleRepairer::postpone(const ScheduleDisruption& disruption, RepairReport& report) {
+    const long found = findBlock(disruption.team, disruption.first_date);
+    if (found < 0) {
+        ++report.unresolved;
+        return;
+    }
+    const std::size_t b = static_cast<std::size_t>(found);
+    ResidencyBlock& block = season_[b];
+    auto game_it = std::find_if(block.games.begin(), block.games.end(), [&](const Game& game) {
+        return game.date == disruption.first_date && (game.team1 == disruption.team || game.team2 == disruption.team);
+    });
+    if (game_it == block.games.end()) {
+        ++report.unresolved;
+        return;
+    }
+    const std::size_t g = static_cast<std::size_t>(game_it - block.games.begin());
+    // Taken before anything moves: which team leads off each crossroads series of this block.
+    const std::size_t origin = series_origin_[b];
+    const std::vector<CrossroadsOpener> crossroads_openers = crossroadsOpeners(origin);
+
+    // Preferred: slide the rest of the block one day, into the travel day.
+    const int extra_day = dayOf(block.end_date) + 1;
+    const std::vector<TeamId> teams = participants(block);
+    bool can_extend = extra_day < teams_.seasonDays() && stadiums_.isFree(block.host_team, extra_day, 1);
+    for (TeamId team : teams) {
+        can_extend = can_extend && teams_.isFree(team, extra_day, 1);
+    }
+    if (can_extend) {
+        for (std::size_t k = g; k < block.games.size(); ++k) {
+            block.games[k].date += 1;
+        }
+        block.end_date += 1;
+        max_block_days_ = std::max(max_block_days_, block.end_date - block.start_date);
+        for (TeamId team : teams) {
+            teams_.mark(team, extra_day, 1);
+        }
+        stadiums_.mark(block.host_team, extra_day, 1);
+        report.changed_blocks.push_back(b);
+        report.games_moved += block.games.size() - g;
+        realignCrossroads(origin, crossroads_openers, report);
+        return;
+    }
+
+    // Otherwise: a one-game make-up block on the first day both teams and the stadium are free.
+    const Game postponed = block.games[g];
+    const TeamId playing[2] = {postponed.team1, postponed.team2};
+    int day = extra_day;
+    while (day >= 0) {
+        day = teams_.firstCommonFreeDay(playing, 2, day);
+        if (day < 0) {
+            break;
+        }
+        const int stadium_day = stadiums_.firstFreeDay(postponed.actual_host_stadium, day);
+        if (stadium_day == day) {
+            break;
+        }
+        day = stadium_day;
+    }
+    if (day < 0) {
+        ++report.unresolved;
+        return;
+    }
+
+    ResidencyBlock makeup(season_.get_allocator().resource());
+    makeup.host_team = postponed.actual_host_stadium;
+    for (TeamId team : playing) {
+        if (team != makeup.host_team) {
+            makeup.visiting_residents.push_back(team);
+        }
+    }
+    makeup.start_date = season_start_ + day;
+    makeup.end_date = makeup.start_date;
+    makeup.games.push_back(postponed);
+    makeup.games.back().date = makeup.start_date;
+    block.games.erase(block.games.begin() + static_cast<std::ptrdiff_t>(g));
+
+    // The emptied day is free again for whoever no longer plays on it.
+    const int emptied_day = dayOf(postponed.date);
+    bool stadium_used = false;
+    for (TeamId team : playing) {
+        bool plays = false;
+        for (const Game& game : block.games) {
+            if (game.date == postponed.date) {
+                stadium_used = true;
+                plays = plays || game.team1 == team || game.team2 == team;
+            }
+        }
+        if (!plays) {
+            teams_.release(team, emptied_day, 1);
+        }
+    }
+    if (!stadium_used) {
+        stadiums_.release(block.host_team, emptied_day, 1);
+    }
+
+    report.changed_blocks.push_back(b);
+    const std::size_t makeup_index = appendBlock(std::move(makeup));
+    series_origin_[makeup_index] = static_cast<std::uint32_t>(origin);
+    makeup_blocks_[origin].push_back(static_cast<std::uint32_t>(makeup_index));
+    report.changed_blocks.push_back(makeup_index);
+    report.games_moved += 1;
+    realignCrossroads(origin, crossroads_openers, report);
+}
+
+std::vector<ScheduleRepairer::CrossroadsOpener> ScheduleRepairer::crossroadsOpeners(std::size_t origin) const {
+    std::vector<CrossroadsOpener> openers;
+    std::vector<CalendarDate> opener_dates;
+    forEachSeriesBlock(origin, [&](std::size_t b) {
+        for (const Game& game : season_[b].games) {
+            if (game.game_type != GameType::CROSSROADS_GAME) {
+                continue;
+            }
+            std::size_t k = 0;
+            while (k < openers.size() && !openers[k].pairs(game)) {
+                ++k;
+            }
+            if (k == openers.size()) {
+                openers.push_back(CrossroadsOpener{game.team1, game.team2});
+                opener_dates.push_back(game.date);
+            } else if (game.date < opener_dates[k]) {
+                openers[k] = CrossroadsOpener{game.team1, game.team2};
+                opener_dates[k] = game.date;
+            }
+        }
+    });
+    return openers;
+}
+
+void ScheduleRepairer::realignCrossroads(std::size_t origin, const std::vector<CrossroadsOpener>& openers,
+                                         RepairReport& report) {
+    for (const CrossroadsOpener& opener : openers) {
+        // The series' games in date order, wherever postponements have put them.
+        std::vector<std::pair<Game*, std::size_t>> series;
+        forEachSeriesBlock(origin, [&](std::size_t b) {
+            for (Game& game : season_[b].games) {
+                if (game.game_type == GameType::CROSSROADS_GAME && opener.pairs(game)) {
+                    series.emplace_back(&game, b);
+                }
+            }
+        });
+        std::stable_sort(series.begin(), series.end(),
+                         [](const auto& a, const auto& b) { return a.first->date < b.first->date; });
+
+        for (std::size_t i = 0; i < series.size(); ++i) {
+            Game& game = *series[i].first;
+            const Game aligned = SeriesPolicy<SeriesKind::CROSSROADS>::game(
+                opener.first, opener.second, game.actual_host_stadium, static_cast<int>(i), true);
+            if (aligned.team1 != game.team1) {
+                game.team1 = aligned.team1;
+                game.team2 = aligned.team2;
+                game.designated_home_team_for_batting = aligned.designated_home_team_for_batting;
+                const std::size_t b = series[i].second;
+                if (std::find(report.changed_blocks.begin(), report.changed_blocks.end(), b) ==
+                    report.changed_blocks.end()) {
+                    report.changed_blocks.push_back(b);
+                }
+            }
+        }
+    }
+}
+
+void ScheduleRepairer::closeStadium(const ScheduleDisruption& disruption, RepairReport& report) {
+    const TeamId host = disruption.team;
+    const int first_day = std::max(0, dayOf(disruption.first_date));
+    const int last_day = std::min(stadiums_.seasonDays() - 1, dayOf(disruption.last_date));
+    if (last_day < first_day) {
+        return;
+    }
+
+    // Blocks hosted here that overlap the closure. Collected first: re-hosting
+    // may append blocks to this team's index.
+    std::vector<std::size_t> affected;
+    for (std::uint32_t b : blocks_by_stadium_[host]) {
+        const ResidencyBlock& block = season_[b];
+        if (block.host_team == host && dayOf(block.start_date) <= last_day && dayOf(block.end_date) >= first_day) {
+            affected.push_back(b);
+        }
+    }
+    for (std::size_t b : affected) {
+        const ResidencyBlock& block = season_[b];
+        auto first_game = std::find_if(block.games.begin(), block.games.end(),
+                                       [&](const Game& game) { return dayOf(game.date) >= first_day; });
+        if (first_game != block.games.end() &&
+            !rehost(b, static_cast<std::size_t>(first_game - block.games.begin()), report)) {
+            ++report.unresolved;
+        }
+    }
+    stadiums_.mark(host, first_day, last_day - first_day + 1);
+}
+
+bool ScheduleRepairer::rehost(std::size_t block_index, std::size_t first_game, RepairReport& report) {
+    ResidencyBlock& block = season_[block_index];
+    const TeamId old_host = block.host_team;
+    // A crossroads game that becomes a host game shortens its series; the rest re-alternates.
+    const std::size_t origin = series_origin_[block_index];
+    const std::vector<CrossroadsOpener> crossroads_openers = crossroadsOpeners(origin);
+    const int tail_first = dayOf(block.games[first_game].date);
+    const int tail_length = dayOf(block.end_date) - tail_first + 1;
+
+    TeamId new_host = kInvalidTeamId;
+    for (TeamId visitor : block.visiting_residents) {
+        if (stadiums_.isFree(visitor, tail_first, tail_length)) {
+            new_host = visitor;
+            break;
+        }
+    }
+    if (new_host == kInvalidTeamId) {
+        return false;
+    }
+    TeamId other = kInvalidTeamId;
+    for (TeamId visitor : block.visiting_residents) {
+        if (visitor != new_host) {
+            other = visitor;
+        }
+    }
+
+    // Games before the closure stay at the old stadium in their own block.
+    ResidencyBlock tail(season_.get_allocator().resource());
+    if (first_game > 0) {
+        tail.games.assign(block.games.begin() + static_cast<std::ptrdiff_t>(first_game), block.games.end());
+        tail.end_date = block.end_date;
+        block.games.resize(first_game);
+        block.end_date = block.games.back().date;
+    }
+    stadiums_.release(old_host, tail_first, tail_length);
+    stadiums_.mark(new_host, tail_first, tail_length);
+
+    ResidencyBlock& moved = first_game > 0 ? tail : block;
+    moved.host_team = new_host;
+    if (first_game == 0) {
+        // The whole block changes stadium (a split-off tail is indexed when appended).
+        std::vector<std::uint32_t>& old_list = blocks_by_stadium_[old_host];
+        old_list.erase(std::find(old_list.begin(), old_list.end(), static_cast<std::uint32_t>(block_index)));
+        std::vector<std::uint32_t>& new_list = blocks_by_stadium_[new_host];
+        auto it = std::upper_bound(new_list.begin(), new_list.end(), block.start_date,
+                                   [&](CalendarDate d, std::uint32_t b) { return d < season_[b].start_date; });
+        new_list.insert(it, static_cast<std::uint32_t>(block_index));
+    }
+    moved.visiting_residents.clear();
+    moved.visiting_residents.push_back(old_host);
+    if (other != kInvalidTeamId) {
+        moved.visiting_residents.push_back(other);
+    }
+    moved.start_date = season_start_ + tail_first;
+
+    // New host's series are ordinary host games; old host vs. the other
+    // visitor is now a crossroads series with a fresh first-bat flip.
+    CounterRng rng = CounterRng::forStream(seed_, {kRepairStream, static_cast<std::uint64_t>(season_index_),
+                                                   static_cast<std::uint64_t>(block_index), new_host});
+    const bool old_host_bats_first = rng.bounded(2) == 0;
+    int crossroads_index = 0;
+    for (Game& game : moved.games) {
+        const CalendarDate date = game.date;
+        if (game.team1 == new_host || game.team2 == new_host) {
+            const TeamId visitor = game.team1 == new_host ? game.team2 : game.team1;
+            game = SeriesPolicy<SeriesKind::HOST_VS_VISITOR>::game(visitor, new_host, new_host, 0, false);
+        } else {
+            game = SeriesPolicy<SeriesKind::CROSSROADS>::game(old_host, other, new_host, crossroads_index++,
+                                                              old_host_bats_first);
+        }
+        game.date = date;
+    }
+    report.games_moved += moved.games.size();
+    report.changed_blocks.push_back(block_index);
+    if (first_game > 0) {
+        report.changed_blocks.push_back(appendBlock(std::move(tail)));
+    }
+    realignCrossroads(origin, crossroads_openers, report);
+    return true;
+}
+
+bool ScheduleRepairer::verify() const {
+    auto fail = [](const std::string& what) {
+        std::cerr << "Repair check failed: " << what << std::endl;
+        return false;
+    };
+    TeamAvailability playing(teams_.teamCount(), teams_.seasonDays());
+    // Crossroads games keyed by (series origin block, lower team, higher team, date).
+    std::vector<std::tuple<std::uint32_t, TeamId, TeamId, CalendarDate, TeamId>> crossroads;
+    for (std::size_t b = 0; b < season_.size(); ++b) {
+        const ResidencyBlock& block = season_[b];
+        for (const Game& game : block.games) {
+            const int day = dayOf(game.date);
+            for (TeamId team : {game.team1, game.team2}) {
+                if (findBlock(team, game.date) != static_cast<long>(b)) {
+                    return fail("team " + std::to_string(team) + "'s game on " + game.date.toString() +
+                                " is not found through its block list");
+                }
+                if (!playing.book(team, day, 1)) {
+                    return fail("team " + std::to_string(team) + " plays twice on " + game.date.toString());
+                }
+                if (!teams_.isBooked(team, day)) {
+                    return fail("team " + std::to_string(team) + " is not booked on " + game.date.toString());
+                }
+            }
+            if (!stadiums_.isBooked(game.actual_host_stadium, day)) {
+                return fail("stadium " + std::to_string(game.actual_host_stadium) + " is not booked on " +
+                            game.date.toString());
+            }
+            if (game.game_type == GameType::CROSSROADS_GAME) {
+                crossroads.emplace_back(series_origin_[b], std::min(game.team1, game.team2),
+                                        std::max(game.team1, game.team2), game.date, game.team1);
+            }
+        }
+    }
+    std::sort(crossroads.begin(), crossroads.end());
+    for (std::size_t i = 1; i < crossroads.size(); ++i) {
+        const auto& previous = crossroads[i - 1];
+        const auto& current = crossroads[i];
+        const bool same_series = std::get<0>(previous) == std::get<0>(current) &&
+                                 std::get<1>(previous) == std::get<1>(current) &&
+                                 std::get<2>(previous) == std::get<2>(current);
+        if (same_series && std::get<4>(previous) == std::get<4>(current)) {
+            return fail("crossroads series of teams " + std::to_string(std::get<1>(current)) + " and " +
+                        std::to_string(std::get<2>(current)) + " does not alternate first bat on " +
+                        std::get<3>(current).toString());
+        }
+    }
+    return true;
+}
+
+std::size_t ScheduleRepairer::appendBlock(ResidencyBlock&& block) {
+    season_.push_back(std::move(block));
+    const std::size_t index = season_.size() - 1;
+    series_origin_.push_back(static_cast<std::uint32_t>(index));
+    makeup_blocks_.emplace_back();
+    bookBlock(season_[index]);
+    indexBlock(index);
+    return index;
+}
+
+void ScheduleRepairer::indexBlock(std::size_t block_index) {
+    const ResidencyBlock& block = season_[block_index];
+    max_block_days_ = std::max(max_block_days_, block.end_date - block.start_date);
+    auto insertByDate = [&](std::vector<std::uint32_t>& blocks) {
+        auto it = std::upper_bound(blocks.begin(), blocks.end(), block.start_date,
+                                   [&](CalendarDate d, std::uint32_t b) { return d < season_[b].start_date; });
+        blocks.insert(it, static_cast<std::uint32_t>(block_index));
+    };
+    for (TeamId team : participants(block)) {
+        insertByDate(blocks_by_team_[team]);
+    }
+    // The stadium list also holds make-up blocks its team does not play in,
+    // so closing the stadium finds them; findBlock() never sees those.
+    if (block.host_team < blocks_by_stadium_.size()) {
+        insertByDate(blocks_by_stadium_[block.host_team]);
+    }
+}
+
+void ScheduleRepairer::bookBlock(const ResidencyBlock& block) {
+    const int first = dayOf(block.start_date);
+    const int length = dayOf(block.end_date) - first + 1;
+    for (TeamId team : participants(block)) {
+        teams_.mark(team, first, length);
+    }
+    stadiums_.mark(block.host_team, first, length);
+}
+
+} // namespace LeagueSchedulerNS
@@ -0,0 +1,132 @@
+#ifndef SCHEDULE_REPAIR_H
+#define SCHEDULE_REPAIR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../money_and_players/calendar.h"
+#include "../money_and_players/game_data.h"
+#include "../money_and_players/team_registry.h"
+#include "team_availability.h"
+
+namespace LeagueSchedulerNS {
+
+// Something that invalidates part of a published season.
+struct ScheduleDisruption {
+    enum class Type {
+        GAME_POSTPONED,       // The game `team` plays on `first_date` must be played later
+        STADIUM_UNAVAILABLE   // `team`'s stadium cannot host on [first_date, last_date]
+    };
+
+    Type type = Type::GAME_POSTPONED;
+    TeamId team = kInvalidTeamId;
+    CalendarDate first_date;
+    CalendarDate last_date;  // Inclusive; STADIUM_UNAVAILABLE only
+
+    static ScheduleDisruption gamePostponed(TeamId team, CalendarDate date) {
+        return {Type::GAME_POSTPONED, team, date, date};
+    }
+    static ScheduleDisruption stadiumUnavailable(TeamId host, CalendarDate first, CalendarDate last) {
+        return {Type::STADIUM_UNAVAILABLE, host, first, last};
+    }
+};
+
+struct RepairReport {
+    std::vector<std::size_t> changed_blocks;  // Indices into the season (new blocks are appended)
+    std::size_t games_moved = 0;              // Games whose date or stadium changed
+    std::size_t unresolved = 0;               // Disruptions left as they were (no legal fix found)
+};
+
+// Repairs a season in place, touching only the blocks a disruption hits.
+//
+// Construction indexes the season once (per-team and per-stadium day bitsets,
+// the blocks each team plays in and the blocks each stadium hosts, in date
+// order). After that, every repair costs
+// O(log blocks per team + games in the affected blocks + season days / 64),
+// independent of the number of blocks in the season.
+//
+// GAME_POSTPONED: the game and the rest of its block slide one day later,
+//   taking the travel day after the block if all three teams and the stadium
+//   are free then. Otherwise the game becomes a one-game make-up block on the
+//   first later day both teams and the stadium are free; the emptied day is
+//   released. After either, a crossroads series' games (make-ups included)
+//   are re-ordered to alternate first bat by date.
+// STADIUM_UNAVAILABLE: each block hosted there during the closure is re-hosted
+//   from the first affected game on, at a visiting resident's stadium (the
+//   first one that is free). Games already played before the closure stay
+//   where they were, split off into their own block. The new host's series
+//   become host games; the old host's series with the other visitor becomes a
+//   crossroads series and follows the alternating-first-bat rule.
+class ScheduleRepairer {
+public:
+    // `season` must outlive the repairer; it is modified in place.
+    // `seed`/`season_index` key the random streams for re-drawn first-bat flips.
+    ScheduleRepairer(SeasonSchedule& season, std::size_t team_count, CalendarDate season_start,
+                     std::uint64_t seed, int season_index = 0);
+
+    RepairReport apply(const ScheduleDisruption& disruption);
+    RepairReport apply(const std::vector<ScheduleDisruption>& disruptions);
+
+    const TeamAvailability& teamAvailability() const { return teams_; }
+    const TeamAvailability& stadiumAvailability() const { return stadiums_; }
+
+    // Checks the season against the repairer's indexes: every game is found
+    // through its teams' block lists, no team plays twice on a day, every
+    // game day is booked for both teams and the stadium, and every crossroads
+    // series alternates first bat by date. Reports the first violation to
+    // std::cerr and returns false. O(games log games); for verification runs.
+    bool verify() const;
+
+private:
+    // Block in which `team` plays a game on `date`, or -1.
+    long findBlock(TeamId team, CalendarDate date) const;
+    int dayOf(CalendarDate date) const { return date - season_start_; }
+
+    void postpone(const ScheduleDisruption& disruption, RepairReport& report);
+    void closeStadium(const ScheduleDisruption& disruption, RepairReport& report);
+    // Moves the games of `block_index` from `first_game` on to a visiting
+    // resident's stadium; returns false if none is free.
+    bool rehost(std::size_t block_index, std::size_t first_game, RepairReport& report);
+
+    // A crossroads pair and which of the two bats first in its earliest game.
+    struct CrossroadsOpener {
+        TeamId first;
+        TeamId second;
+        bool pairs(const Game& game) const {
+            return (game.team1 == first && game.team2 == second) || (game.team1 == second && game.team2 == first);
+        }
+    };
+    // One opener per crossroads pair in the series that started in block
+    // `origin` (the block and its make-up blocks).
+    std::vector<CrossroadsOpener> crossroadsOpeners(std::size_t origin) const;
+    // Re-applies the alternating-first-bat rule to each of those pairs' games
+    // by date order, with the given team leading off.
+    void realignCrossroads(std::size_t origin, const std::vector<CrossroadsOpener>& openers, RepairReport& report);
+    template <typename Fn>
+    void forEachSeriesBlock(std::size_t origin, Fn fn) const {
+        fn(origin);
+        for (std::uint32_t b : makeup_blocks_[origin]) {
+            fn(b);
+        }
+    }
+
+    std::size_t appendBlock(ResidencyBlock&& block);
+    void indexBlock(std::size_t block_index);
+    void bookBlock(const ResidencyBlock& block);
+
+    SeasonSchedule& season_;
+    CalendarDate season_start_;
+    std::uint64_t seed_;
+    int season_index_;
+    TeamAvailability teams_;      // Day bitsets: team is in a block
+    TeamAvailability stadiums_;   // Day bitsets: stadium hosts a block or is closed
+    std::vector<std::vector<std::uint32_t>> blocks_by_team_;     // Blocks each team plays in, by start date
+    std::vector<std::vector<std::uint32_t>> blocks_by_stadium_;  // Blocks each stadium hosts, by start date
+    int max_block_days_ = 0;                                     // Longest end_date - start_date indexed
+    std::vector<std::uint32_t> series_origin_;                // Per block: the block its games came from
+    std::vector<std::vector<std::uint32_t>> makeup_blocks_;   // Per origin block: its make-up blocks
+};
+
+} // namespace LeagueSchedulerNS
+
+#endif // SCHEDULE_REPAIR_H
@@ -0,0 +1,59 @@
+#ifndef SCHEDULE_SINK_H
+#define SCHEDULE_SINK_H
+
+#include <utility>
+#include <vector>
+#include "../money_and_players/game_data.h"
+#include "season_engine.h"
+
+namespace LeagueSchedulerNS {
+
+// Consumer of a season as LeagueScheduler2 produces it.
+// Blocks arrive one at a time in plan order (rounds ascending), each with its
+// games already dated, so a printer, archive writer or simulator can process
+// the season without the whole SeasonSchedule ever existing.
+class ScheduleSink {
+public:
+    virtual ~ScheduleSink() = default;
+
+    // Called once before the first block; `plan` stays valid until endSeason().
+    virtual void beginSeason(const SeasonPlan& plan) { (void)plan; }
+    // The sink may keep the block by moving from it; the scheduler refills the
+    // object for a later block after the call returns.
+    virtual void onBlock(ResidencyBlock&& block) = 0;
+    virtual void endSeason() {}
+};
+
+// Collects the season into a SeasonSchedule (the adapter behind
+// generateSeasonSchedule). Blocks are rebuilt in `out`'s memory resource.
+class VectorScheduleSink : public ScheduleSink {
+public:
+    explicit VectorScheduleSink(SeasonSchedule& out) : out_(out) {}
+
+    void beginSeason(const SeasonPlan& plan) override { out_.reserve(out_.size() + plan.blocks.size()); }
+    void onBlock(ResidencyBlock&& block) override { out_.push_back(std::move(block)); }
+
+private:
+    SeasonSchedule& out_;
+};
+
+// Forwards every block to a callable taking `ResidencyBlock&&` (or `const ResidencyBlock&`).
+template <typename Fn>
+class CallbackScheduleSink : public ScheduleSink {
+public:
+    explicit CallbackScheduleSink(Fn fn) : fn_(std::move(fn)) {}
+
+    void onBlock(ResidencyBlock&& block) override { fn_(std::move(block)); }
+
+private:
+    Fn fn_;
+};
+
+template <typename Fn>
+CallbackScheduleSink<Fn> makeScheduleSink(Fn fn) {
+    return CallbackScheduleSink<Fn>(std::move(fn));
+}
+
+} // namespace LeagueSchedulerNS
+
+#endif // SCHEDULE_SINK_H
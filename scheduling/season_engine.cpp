@@ -0,0 +1,592 @@
+/**
+ * @file season_engine.cpp
+ * @brief Constraint-based full-season residency block generator (parallel simulated annealing).
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "season_engine.h"
+#include "counter_rng.h"
+#include "instrumentation.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <utility>
+
+namespace LeagueSchedulerNS {
+
+namespace {
+
+// Objective weights. Falling short of games_per_team dominates so the search
+// never trades games for nicer pairings. Overshooting is cheap because the
+// final trim pass shortens series back down to the quota.
+constexpr double kUnderQuotaWeight = 50.0;
+constexpr double kOverQuotaWeight = 0.5;
+constexpr double kHostBalanceWeight = 4.0;
+constexpr double kVisitBalanceWeight = 4.0;
+constexpr double kCrossroadsRepeatWeight = 3.0;
+constexpr double kHostVisitorRepeatWeight = 1.0;
+constexpr double kBackToBackHostWeight = 1.0;
+
+// Cost per crossroads series, by the visitors' regions.
+using RegionPairWeights = std::array<double, kRegionCount * kRegionCount>;
+
+RegionPairWeights crossroadsWeights(const SeasonEngineConfig& config) {
+    RegionPairWeights weights{};
+    for (std::size_t a = 0; a < kRegionCount; ++a) {
+        for (std::size_t b = 0; b < kRegionCount; ++b) {
+            const bool rivals = (kRegionPairFlags[a][b] & kRivalry) != 0;
+            weights[a * kRegionCount + b] = rivals ? -config.rivalry_crossroads_weight : 0.0;
+        }
+    }
+    return weights;
+}
+
+// Occurrence counts per team pair, for the pairs currently in the schedule.
+//
+// A dense n x n table is 200 MB per restart at 10k teams, yet a schedule only
+// ever holds rounds * blocks_per_round crossroads pairs and twice that many
+// host/visitor pairs. This is an open-addressing table (linear probing,
+// backward-shift deletion, so no tombstones) sized once for that many live
+// pairs at most half full; a pair's entry is removed when its count drops to
+// zero, so the table never grows and lookups stay O(1).
+class PairCounter {
+public:
+    explicit PairCounter(std::size_t max_live_pairs) {
+        std::size_t capacity = 16;
+        while (capacity < 2 * max_live_pairs) {
+            capacity *= 2;
+        }
+        slots_.assign(capacity, Slot{kEmpty, 0});
+        mask_ = capacity - 1;
+    }
+
+    // Adds `sign` (+1 or -1) to the pair's count; returns the count before.
+    int bump(TeamId a, TeamId b, int sign) {
+        const std::uint32_t key = (static_cast<std::uint32_t>(a) << 16) | b;
+        std::size_t i = home(key);
+        while (slots_[i].key != key && slots_[i].key != kEmpty) {
+            i = (i + 1) & mask_;
+        }
+        const int before = slots_[i].key == key ? static_cast<int>(slots_[i].count) : 0;
+        const int after = before + sign;
+        if (after > 0) {
+            slots_[i] = Slot{key, static_cast<std::uint32_t>(after)};
+        } else if (before > 0) {
+            erase(i);
+        }
+        return before;
+    }
+
+private:
+    static constexpr std::uint32_t kEmpty = 0xFFFFFFFFu;   // (kInvalidTeamId, kInvalidTeamId)
+    struct Slot {
+        std::uint32_t key;
+        std::uint32_t count;
+    };
+
+    std::size_t home(std::uint32_t key) const {
+        return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & mask_;
+    }
+
+    // Backward-shift deletion: pulls later entries of the probe run into the hole.
+    void erase(std::size_t hole) {
+        std::size_t j = hole;
+        for (;;) {
+            j = (j + 1) & mask_;
+            if (slots_[j].key == kEmpty) {
+                break;
+            }
+            const std::size_t k = home(slots_[j].key);
+            // Move j back unless its home lies cyclically in (hole, j].
+            const bool stays = hole <= j ? (hole < k && k <= j) : (hole < k || k <= j);
+            if (!stays) {
+                slots_[hole] = slots_[j];
+                hole = j;
+            }
+        }
+        slots_[hole] = Slot{kEmpty, 0};
+    }
+
+    std::vector<Slot> slots_;
+    std::size_t mask_ = 0;
+};
+
+constexpr double kStartTemperature = 10.0;
+constexpr double kEndTemperature = 0.05;
+
+// Everything one annealing run needs. Rounds are stored as permutations of
+// the team ids: in round r, positions 3k, 3k+1, 3k+2 form block k (host first),
+// positions >= 3 * blocks_per_round are byes.
+class AnnealState {
+public:
+    AnnealState(int teams, int rounds, int blocks_per_round, const SeasonEngineConfig& config,
+                const RegionPairWeights& crossroads_weights, const std::uint8_t* regions)
+        : n_(teams), rounds_(rounds), blocks_(blocks_per_round),
+          host_games_(2 * config.host_games_per_visitor),
+          visit_games_(config.host_games_per_visitor + config.crossroads_series_length),
+          quota_(config.games_per_team),
+          host_target_(static_cast<double>(rounds) * blocks_per_round / teams),
+          visit_target_(2.0 * rounds * blocks_per_round / teams),
+          slots_(static_cast<std::size_t>(rounds) * teams),
+          hosted_(teams, 0), visited_(teams, 0),
+          crossroads_pairs_(static_cast<std::size_t>(rounds) * blocks_per_round),
+          host_visitor_pairs_(2 * static_cast<std::size_t>(rounds) * blocks_per_round),
+          host_flag_(static_cast<std::size_t>(rounds) * teams, 0),
+          crossroads_weights_(crossroads_weights), regions_(regions) {}
+
+    void initialize(CounterRng& rng) {
+        for (int r = 0; r < rounds_; ++r) {
+            TeamId* round = &slots_[index(r, 0)];
+            for (int t = 0; t < n_; ++t) {
+                round[t] = static_cast<TeamId>(t);
+            }
+            std::shuffle(round, round + n_, rng);
+            // Greedy host choice: the block member that has hosted least so far.
+            for (int k = 0; k < blocks_; ++k) {
+                int best = 3 * k;
+                for (int p = 3 * k + 1; p < 3 * k + 3; ++p) {
+                    if (hosted_[round[p]] < hosted_[round[best]]) {
+                        best = p;
+                    }
+                }
+                std::swap(round[3 * k], round[best]);
+                ++hosted_[round[3 * k]];
+            }
+        }
+        std::fill(hosted_.begin(), hosted_.end(), 0);
+
+        cost_ = 0.0;
+        for (int t = 0; t < n_; ++t) {
+            cost_ += teamTerm(t);
+        }
+        for (int r = 0; r < rounds_; ++r) {
+            for (int k = 0; k < blocks_; ++k) {
+                cost_ += applyBlock(r, k, +1);
+            }
+        }
+    }
+
+    // Proposes swapping positions i and j of round r; keeps it per Metropolis.
+    void step(CounterRng& rng, double temperature) {
+        const int r = static_cast<int>(rng.bounded(static_cast<std::uint32_t>(rounds_)));
+        const int i = static_cast<int>(rng.bounded(static_cast<std::uint32_t>(n_)));
+        const int j = static_cast<int>(rng.bounded(static_cast<std::uint32_t>(n_)));
+        const int bi = blockOf(i);
+        const int bj = blockOf(j);
+        if (i == j || (bi < 0 && bj < 0)) {
+            return;
+        }
+        if (bi == bj && i % 3 != 0 && j % 3 != 0) {
+            return; // Swapping the two visitors of a block changes nothing
+        }
+
+        const double delta = swapPositions(r, i, j, bi, bj);
+        if (delta <= 0.0 || rng.uniform01() < std::exp(-delta / temperature)) {
+            cost_ += delta;
+        } else {
+            swapPositions(r, i, j, bi, bj);
+        }
+    }
+
+    double cost() const { return cost_; }
+    const std::vector<TeamId>& slots() const { return slots_; }
+
+private:
+    std::size_t index(int r, int t) const { return static_cast<std::size_t>(r) * n_ + t; }
+    int blockOf(int p) const { return p < 3 * blocks_ ? p / 3 : -1; }
+
+    double teamTerm(int t) const {
+        const double games = static_cast<double>(host_games_ * hosted_[t] + visit_games_ * visited_[t]);
+        const double quota_gap = games - quota_;
+        const double host_gap = hosted_[t] - host_target_;
+        const double visit_gap = visited_[t] - visit_target_;
+        const double quota_weight = quota_gap < 0.0 ? kUnderQuotaWeight : kOverQuotaWeight;
+        return quota_weight * quota_gap * quota_gap + kHostBalanceWeight * host_gap * host_gap +
+               kVisitBalanceWeight * visit_gap * visit_gap;
+    }
+
+    static double repeatPenalty(int count) { return 0.5 * count * (count - 1); }
+
+    static double bumpPair(PairCounter& counts, TeamId a, TeamId b, int sign, double weight) {
+        const int before = counts.bump(a, b, sign);
+        return weight * (repeatPenalty(before + sign) - repeatPenalty(before));
+    }
+
+    // Adds (sign = +1) or removes (sign = -1) block k of round r from the
+    // counters and returns the resulting change in cost.
+    double applyBlock(int r, int k, int sign) {
+        const TeamId host = slots_[index(r, 3 * k)];
+        const TeamId a = slots_[index(r, 3 * k + 1)];
+        const TeamId b = slots_[index(r, 3 * k + 2)];
+        double delta = 0.0;
+        for (TeamId t : {host, a, b}) {
+            delta -= teamTerm(t);
+        }
+        hosted_[host] += sign;
+        visited_[a] += sign;
+        visited_[b] += sign;
+        for (TeamId t : {host, a, b}) {
+            delta += teamTerm(t);
+        }
+
+        delta += bumpPair(crossroads_pairs_, std::min(a, b), std::max(a, b), sign, kCrossroadsRepeatWeight);
+        delta += sign * crossroads_weights_[regions_[a] * kRegionCount + regions_[b]];
+        delta += bumpPair(host_visitor_pairs_, host, a, sign, kHostVisitorRepeatWeight);
+        delta += bumpPair(host_visitor_pairs_, host, b, sign, kHostVisitorRepeatWeight);
+
+        int neighbours = 0;
+        if (r > 0) {
+            neighbours += host_flag_[index(r - 1, host)];
+        }
+        if (r + 1 < rounds_) {
+            neighbours += host_flag_[index(r + 1, host)];
+        }
+        host_flag_[index(r, host)] = sign > 0 ? 1 : 0;
+        delta += kBackToBackHostWeight * sign * neighbours;
+        return delta;
+    }
+
+    double swapPositions(int r, int i, int j, int bi, int bj) {
+        double delta = 0.0;
+        if (bi >= 0) {
+            delta += applyBlock(r, bi, -1);
+        }
+        if (bj >= 0 && bj != bi) {
+            delta += applyBlock(r, bj, -1);
+        }
+        TeamId& ti = slots_[index(r, i)];
+        TeamId& tj = slots_[index(r, j)];
+        std::swap(ti, tj);
+        if (bi >= 0) {
+            delta += applyBlock(r, bi, +1);
+        }
+        if (bj >= 0 && bj != bi) {
+            delta += applyBlock(r, bj, +1);
+        }
+        return delta;
+    }
+
+    int n_;
+    int rounds_;
+    int blocks_;
+    int host_games_;
+    int visit_games_;
+    int quota_;
+    double host_target_;
+    double visit_target_;
+
+    std::vector<TeamId> slots_;
+    std::vector<int> hosted_;
+    std::vector<int> visited_;
+    PairCounter crossroads_pairs_;                  // (lo, hi)
+    PairCounter host_visitor_pairs_;                // (host, visitor)
+    std::vector<std::uint8_t> host_flag_;           // [round * n + team]
+    const RegionPairWeights& crossroads_weights_;   // [region(a) * kRegionCount + region(b)]
+    const std::uint8_t* regions_;                   // RegionType per team
+    double cost_ = 0.0;
+};
+
+struct RestartResult {
+    double cost = 0.0;
+    std::vector<TeamId> slots;
+};
+
+RestartResult runRestart(int teams, int rounds, int blocks_per_round, const SeasonEngineConfig& config,
+                         const RegionPairWeights& crossroads_weights, const std::uint8_t* regions,
+                         int restart_index, long long iterations) {
+    APMW_TRACE_SCOPE("engine.restart");
+    // Each restart has its own counter-based stream, independent of which thread runs it.
+    CounterRng rng = CounterRng::forStream(config.seed, {static_cast<std::uint64_t>(restart_index)});
+    AnnealState state(teams, rounds, blocks_per_round, config, crossroads_weights, regions);
+    state.initialize(rng);
+
+    const double cooling = std::pow(kEndTemperature / kStartTemperature, 1.0 / static_cast<double>(iterations));
+    double temperature = kStartTemperature;
+    for (long long it = 0; it < iterations; ++it) {
+        state.step(rng, temperature);
+        temperature *= cooling;
+    }
+    return RestartResult{state.cost(), state.slots()};
+}
+
+// Series of block `b` (0 = crossroads, 1 = host vs visitor1, 2 = host vs visitor2).
+int* seriesGames(PlannedBlock& block, int series) {
+    return series == 0 ? &block.crossroads_games
+                       : series == 1 ? &block.host_games_vs_visitor1 : &block.host_games_vs_visitor2;
+}
+TeamId seriesTeam(const PlannedBlock& block, int series, int side) {
+    if (series == 0) {
+        return side == 0 ? block.visitor1 : block.visitor2;
+    }
+    return side == 0 ? block.host : series == 1 ? block.visitor1 : block.visitor2;
+}
+
+// Re-balances the teams trimToQuota's direct pass could not bring to the
+// quota, along alternating paths of series: shorten a series of an over-quota
+// team, lengthen (back up to its planned length) a series of the team at the
+// other end, shorten again, ... until the path reaches a second team that is
+// over quota (after a shortening) or under it (after a lengthening). Every
+// team inside the path keeps its count. Paths are found by BFS over (team,
+// next operation) states, so each search is O(series in the season).
+void rebalanceAlongPaths(SeasonPlan& plan, std::vector<int>& excess, const std::vector<int>& planned_games) {
+    const std::size_t n = excess.size();
+    // series_of[team]: (block, series) pairs, as flat ids block * 3 + series.
+    std::vector<std::vector<std::uint32_t>> series_of(n);
+    for (std::size_t b = 0; b < plan.blocks.size(); ++b) {
+        for (int series = 0; series < 3; ++series) {
+            const std::uint32_t id = static_cast<std::uint32_t>(b * 3 + series);
+            series_of[seriesTeam(plan.blocks[b], series, 0)].push_back(id);
+            series_of[seriesTeam(plan.blocks[b], series, 1)].push_back(id);
+        }
+    }
+    auto games = [&](std::uint32_t id) { return seriesGames(plan.blocks[id / 3], static_cast<int>(id % 3)); };
+    auto other = [&](std::uint32_t id, std::size_t team) -> std::size_t {
+        const TeamId x = seriesTeam(plan.blocks[id / 3], static_cast<int>(id % 3), 0);
+        return x == team ? seriesTeam(plan.blocks[id / 3], static_cast<int>(id % 3), 1) : x;
+    };
+
+    // State s = team * 2 + op, op 0 = the next step shortens, 1 = it lengthens.
+    constexpr std::uint32_t kUnseen = 0xFFFFFFFFu;
+    std::vector<std::uint32_t> parent_state(2 * n, kUnseen);
+    std::vector<std::uint32_t> parent_series(2 * n, kUnseen);
+    std::vector<std::uint32_t> queue;
+    std::vector<std::uint32_t> touched;
+    std::vector<std::pair<std::uint32_t, int>> path;   // (series, +1 / -1)
+    for (std::size_t start = 0; start < n; ++start) {
+        while (excess[start] != 0) {
+            const std::uint32_t start_state = static_cast<std::uint32_t>(start * 2 + (excess[start] > 0 ? 0 : 1));
+            queue.assign(1, start_state);
+            touched.assign(1, start_state);
+            parent_state[start_state] = start_state;
+            std::uint32_t end_state = kUnseen;
+            for (std::size_t head = 0; head < queue.size() && end_state == kUnseen; ++head) {
+                const std::uint32_t state = queue[head];
+                const std::size_t team = state / 2;
+                const bool shorten = state % 2 == 0;
+                for (std::uint32_t id : series_of[team]) {
+                    const int length = *games(id);
+                    if (shorten ? length <= 1 : length >= planned_games[id]) {
+                        continue;
+                    }
+                    const std::size_t next_team = other(id, team);
+                    // The start team already moved by one; it ends a path only with room for another.
+                    const int slack = next_team == start ? (excess[start] > 0 ? 1 : -1) : 0;
+                    const std::uint32_t next = static_cast<std::uint32_t>(next_team * 2 + (shorten ? 1 : 0));
+                    if (parent_state[next] != kUnseen) {
+                        continue;
+                    }
+                    parent_state[next] = state;
+                    parent_series[next] = id;
+                    touched.push_back(next);
+                    if (shorten ? excess[next_team] - slack > 0 : excess[next_team] - slack < 0) {
+                        end_state = next;
+                        break;
+                    }
+                    queue.push_back(next);
+                }
+            }
+
+            bool applied = false;
+            if (end_state != kUnseen) {
+                // The BFS tree may use a series twice; apply only if every length stays in range.
+                path.clear();
+                for (std::uint32_t state = end_state; state != start_state; state = parent_state[state]) {
+                    path.emplace_back(parent_series[state], parent_state[state] % 2 == 0 ? -1 : +1);
+                }
+                for (const auto& step : path) {
+                    *games(step.first) += step.second;
+                }
+                applied = true;
+                for (const auto& step : path) {
+                    const int length = *games(step.first);
+                    applied = applied && length >= 1 && length <= planned_games[step.first];
+                }
+                if (applied) {
+                    excess[start] += excess[start] > 0 ? -1 : 1;
+                    const std::size_t end_team = end_state / 2;
+                    excess[end_team] += end_state % 2 == 1 ? -1 : 1;
+                } else {
+                    for (const auto& step : path) {
+                        *games(step.first) -= step.second;
+                    }
+                }
+            }
+            for (std::uint32_t state : touched) {
+                parent_state[state] = kUnseen;
+            }
+            if (!applied) {
+                break;   // This team's miss stays (reported by SeasonPlan::teams_off_quota)
+            }
+        }
+    }
+}
+
+// Shortens series so teams above the quota come down to it. A series is
+// shortened directly when both of its teams are over quota, and never below
+// one game; whatever that leaves is re-balanced along alternating paths.
+void trimToQuota(SeasonPlan& plan, int quota) {
+    std::vector<int> excess(plan.games_per_team.size());
+    for (std::size_t t = 0; t < excess.size(); ++t) {
+        excess[t] = plan.games_per_team[t] - quota;
+    }
+    std::vector<int> planned_games(plan.blocks.size() * 3);
+    for (std::size_t b = 0; b < plan.blocks.size(); ++b) {
+        for (int series = 0; series < 3; ++series) {
+            planned_games[b * 3 + series] = *seriesGames(plan.blocks[b], series);
+        }
+    }
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (auto it = plan.blocks.rbegin(); it != plan.blocks.rend(); ++it) {
+            PlannedBlock& block = *it;
+            struct Series { int* games; TeamId x; TeamId y; };
+            Series series[] = {{&block.crossroads_games, block.visitor1, block.visitor2},
+                               {&block.host_games_vs_visitor1, block.host, block.visitor1},
+                               {&block.host_games_vs_visitor2, block.host, block.visitor2}};
+            for (Series& s : series) {
+                if (*s.games > 1 && excess[s.x] > 0 && excess[s.y] > 0) {
+                    --*s.games;
+                    --excess[s.x];
+                    --excess[s.y];
+                    changed = true;
+                }
+            }
+        }
+    }
+    rebalanceAlongPaths(plan, excess, planned_games);
+    plan.teams_off_quota = 0;
+    for (std::size_t t = 0; t < excess.size(); ++t) {
+        plan.games_per_team[t] = quota + excess[t];
+        plan.teams_off_quota += excess[t] != 0 ? 1 : 0;
+    }
+}
+
+} // namespace
+
+SeasonEngine::SeasonEngine(const SeasonEngineConfig& config) : config_(config) {}
+
+SeasonPlan SeasonEngine::plan(std::size_t team_count, const LeagueTopology* topology) const {
+    SeasonPlan plan;
+    const int n = static_cast<int>(team_count);
+    const int blocks_per_round = n / 3;
+    const int h = std::max(1, config_.host_games_per_visitor);
+    const int c = std::max(1, config_.crossroads_series_length);
+    if (blocks_per_round == 0 || config_.games_per_team <= 0) {
+        return plan;
+    }
+
+    // Enough rounds that the league's total games reach every team's quota.
+    const long long team_games_needed = static_cast<long long>(config_.games_per_team) * n;
+    const long long team_games_per_round = static_cast<long long>(blocks_per_round) * (4 * h + 2 * c);
+    plan.rounds = static_cast<int>((team_games_needed + team_games_per_round - 1) / team_games_per_round);
+    plan.round_days = 2 * h + c + std::max(0, config_.rest_days_between_rounds);
+    plan.season_days = plan.rounds * plan.round_days;
+
+    SeasonEngineConfig effective = config_;
+    effective.host_games_per_visitor = h;
+    effective.crossroads_series_length = c;
+
+    long long iterations = config_.iterations_per_restart > 0
+        ? config_.iterations_per_restart
+        : std::max(20000LL, 300LL * plan.rounds * n);
+    if (config_.iterations_per_restart <= 0 && config_.max_iterations_per_restart > 0) {
+        iterations = std::min(iterations, config_.max_iterations_per_restart);
+    }
+    int restarts = config_.restarts;
+    if (restarts <= 0) {
+        restarts = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    const int thread_limit = config_.restart_threads > 0
+        ? config_.restart_threads
+        : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    const int workers = std::min(restarts, thread_limit);
+
+    // Without a topology every team counts as RegionType::UNKNOWN, which no rule applies to.
+    const RegionPairWeights crossroads_weights = crossroadsWeights(config_);
+    std::vector<std::uint8_t> unknown_regions;
+    const std::uint8_t* regions = nullptr;
+    if (topology != nullptr && topology->teamCount() == team_count) {
+        regions = topology->regionIndices();
+    } else {
+        unknown_regions.assign(team_count, static_cast<std::uint8_t>(RegionType::UNKNOWN));
+        regions = unknown_regions.data();
+    }
+
+    std::vector<RestartResult> results(restarts);
+    std::atomic<int> next_restart(0);
+    auto worker = [&]() {
+        for (int r = next_restart++; r < restarts; r = next_restart++) {
+            results[r] = runRestart(n, plan.rounds, blocks_per_round, effective, crossroads_weights, regions, r,
+                                    iterations);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int w = 1; w < workers; ++w) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    int best = 0;
+    for (int r = 1; r < restarts; ++r) {
+        if (results[r].cost < results[best].cost) {
+            best = r;
+        }
+    }
+    plan.cost = results[best].cost;
+    plan.restart = best;
+
+    const std::vector<TeamId>& slots = results[best].slots;
+    plan.blocks.reserve(static_cast<std::size_t>(plan.rounds) * blocks_per_round);
+    plan.games_per_team.assign(n, 0);
+    plan.blocks_hosted.assign(n, 0);
+    plan.blocks_visited.assign(n, 0);
+    for (int r = 0; r < plan.rounds; ++r) {
+        for (int k = 0; k < blocks_per_round; ++k) {
+            PlannedBlock block;
+            block.host = slots[static_cast<std::size_t>(r) * n + 3 * k];
+            block.visitor1 = slots[static_cast<std::size_t>(r) * n + 3 * k + 1];
+            block.visitor2 = slots[static_cast<std::size_t>(r) * n + 3 * k + 2];
+            block.round = r;
+            block.start_day = r * plan.round_days;
+            block.host_games_vs_visitor1 = h;
+            block.host_games_vs_visitor2 = h;
+            block.crossroads_games = c;
+            plan.games_per_team[block.host] += 2 * h;
+            plan.games_per_team[block.visitor1] += h + c;
+            plan.games_per_team[block.visitor2] += h + c;
+            ++plan.blocks_hosted[block.host];
+            ++plan.blocks_visited[block.visitor1];
+            ++plan.blocks_visited[block.visitor2];
+            plan.blocks.push_back(block);
+        }
+    }
+    {
+        APMW_TRACE_SCOPE("engine.trim_to_quota");
+        trimToQuota(plan, config_.games_per_team);
+    }
+    return plan;
+}
+
+} // namespace LeagueSchedulerNS
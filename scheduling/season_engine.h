@@ -0,0 +1,103 @@
+#ifndef SEASON_ENGINE_H
+#define SEASON_ENGINE_H
+
+#include <cstdint>
+#include <vector>
+#include "../money_and_players/calendar.h"
+#include "../money_and_players/league_topology.h"
+#include "../money_and_players/team_registry.h"
+#include "series_policy.h"
+
+namespace LeagueSchedulerNS {
+
+// Tuning knobs for the full-season engine.
+struct SeasonEngineConfig {
+    int games_per_team = 110;
+    int host_games_per_visitor = SeriesPolicy<SeriesKind::HOST_VS_VISITOR>::kDefaultGames;
+    int crossroads_series_length = SeriesPolicy<SeriesKind::CROSSROADS>::kDefaultGames;
+    int rest_days_between_rounds = 1;   // Travel day after every round of blocks
+    // Reward per crossroads series between teams of rival regions
+    // (kRegionRivalries, e.g. Heartland-Confluence). Needs the league's
+    // topology (see SeasonEngine::plan); 0 = rivalries play no part.
+    double rivalry_crossroads_weight = 0.0;
+    CalendarDate season_start = CalendarDate::fromCivil(2025, 3, 27);
+
+    // Local search: independent annealing restarts run in parallel, best one wins.
+    // Keep `restarts` fixed for reproducibility across machines: the restart
+    // count (not the thread count) determines the result.
+    int restarts = 4;                   // 0 = one per hardware thread
+    int restart_threads = 0;            // Threads running restarts (0 = one per hardware thread);
+                                        // batch drivers that already use every core set 1
+    long long iterations_per_restart = 0; // 0 = scaled to league size
+    long long max_iterations_per_restart = 0; // Caps the scaled default for huge leagues (0 = no cap)
+    std::uint64_t seed = 0x41504D57u;   // "APMW"
+};
+
+// One residency block as planned by the engine (before games are materialized).
+struct PlannedBlock {
+    TeamId host = kInvalidTeamId;
+    TeamId visitor1 = kInvalidTeamId;
+    TeamId visitor2 = kInvalidTeamId;
+    int round = 0;
+    int start_day = 0;                   // Day offset from the season start (first game day)
+    int host_games_vs_visitor1 = 0;
+    int host_games_vs_visitor2 = 0;
+    int crossroads_games = 0;
+
+    int totalGames() const { return host_games_vs_visitor1 + host_games_vs_visitor2 + crossroads_games; }
+};
+
+// The engine's output: dated blocks plus per-team bookkeeping.
+struct SeasonPlan {
+    int rounds = 0;
+    int round_days = 0;                  // Calendar days per round, including the rest day
+    int season_days = 0;                 // rounds * round_days: length of the season calendar
+    std::vector<PlannedBlock> blocks;    // Ordered by round
+    std::vector<int> games_per_team;     // Indexed by TeamId
+    std::vector<int> blocks_hosted;      // Indexed by TeamId
+    std::vector<int> blocks_visited;     // Indexed by TeamId
+    int teams_off_quota = 0;             // Teams not on exactly games_per_team (see trimToQuota)
+    double cost = 0.0;                   // Final objective value (lower is better)
+    int restart = -1;                    // Which restart produced this plan
+};
+
+// Constraint-based season generator.
+//
+// The season is a sequence of rounds. In each round the league is partitioned
+// into residency blocks of three teams (one host, two visiting residents);
+// leftover teams have a bye. Because a team appears at most once per round and
+// rounds never overlap in time, no team is ever double-booked.
+//
+// Simulated annealing over "swap two teams within a round" moves minimizes:
+//   - deviation from games_per_team (dominant term),
+//   - home (hosted blocks) and crossroads (visited blocks) imbalance,
+//   - repeated crossroads pairings and repeated host/visitor pairings,
+//   - hosting in back-to-back rounds,
+//   - minus rivalry_crossroads_weight per crossroads series between rival regions.
+// Every move is scored incrementally in O(1); topology rules are a lookup in a
+// region-by-region weight table built from kRegionPairFlags. Restarts are independent and run
+// on separate threads; the lowest-cost plan wins (ties go to the lowest restart
+// index), so results do not depend on the thread count.
+//
+// After the search, series lengths are trimmed so that teams land exactly on
+// games_per_team whenever the block structure allows it: directly where both
+// teams of a series are over, else along alternating shorten/lengthen paths
+// of series. Teams still off (e.g., an odd total excess, or teams short of
+// games) are counted in SeasonPlan::teams_off_quota.
+class SeasonEngine {
+public:
+    explicit SeasonEngine(const SeasonEngineConfig& config = SeasonEngineConfig());
+
+    // `topology` (one entry per team, or null) supplies the teams' regions for
+    // the rivalry term.
+    SeasonPlan plan(std::size_t team_count, const LeagueTopology* topology = nullptr) const;
+
+    const SeasonEngineConfig& config() const { return config_; }
+
+private:
+    SeasonEngineConfig config_;
+};
+
+} // namespace LeagueSchedulerNS
+
+#endif // SEASON_ENGINE_H
@@ -0,0 +1,60 @@
+#ifndef SERIES_POLICY_H
+#define SERIES_POLICY_H
+
+#include "../money_and_players/game_data.h"
+#include "../money_and_players/team_registry.h"
+
+namespace LeagueSchedulerNS {
+
+// The series a residency block is made of.
+enum class SeriesKind {
+    HOST_VS_VISITOR,   // The host against one visiting resident, at home
+    CROSSROADS         // The two visiting residents, at the host's neutral stadium
+};
+
+// Compile-time rules per series kind: default length, game type and who bats
+// last in game `game_index`. Block builders instantiate the policy for each
+// of their series, so the per-game rule is resolved at compile time instead
+// of being switched on inside the game loop.
+template <SeriesKind Kind>
+struct SeriesPolicy;
+
+template <>
+struct SeriesPolicy<SeriesKind::HOST_VS_VISITOR> {
+    static constexpr int kDefaultGames = 3;
+    static constexpr GameType kGameType = GameType::REGULAR_SEASON;
+
+    // The host bats last in every game. `home` is the host, `away` the visitor.
+    static Game game(TeamId away, TeamId home, TeamId stadium, int /*game_index*/, bool /*away_bats_first*/) {
+        Game game;
+        game.team1 = away;
+        game.team2 = home;
+        game.designated_home_team_for_batting = home;
+        game.actual_host_stadium = stadium;
+        game.game_type = kGameType;
+        return game;
+    }
+};
+
+template <>
+struct SeriesPolicy<SeriesKind::CROSSROADS> {
+    static constexpr int kDefaultGames = 5;
+    static constexpr GameType kGameType = GameType::CROSSROADS_GAME;
+
+    // The "alternating first bat" rule: `first` bats first in the opener when
+    // `first_bats_first` (one coin flip per series), then the teams alternate.
+    static Game game(TeamId first, TeamId second, TeamId stadium, int game_index, bool first_bats_first) {
+        const bool first_leads = (game_index % 2 == 0) == first_bats_first;
+        Game game;
+        game.team1 = first_leads ? first : second;
+        game.team2 = first_leads ? second : first;
+        game.designated_home_team_for_batting = game.team2;
+        game.actual_host_stadium = stadium;
+        game.game_type = kGameType;
+        return game;
+    }
+};
+
+} // namespace LeagueSchedulerNS
+
+#endif // SERIES_POLICY_H
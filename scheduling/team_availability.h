@@ -0,0 +1,184 @@
+#ifndef TEAM_AVAILABILITY_H
+#define TEAM_AVAILABILITY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../money_and_players/team_registry.h"
+
+namespace LeagueSchedulerNS {
+
+// Per-team season availability as one bit per (team, season day).
+// A set bit means the team is booked that day. Range queries and updates
+// touch ceil(length / 64) + 1 words per team, so "is team X free on days
+// d..d+k" costs a few word operations instead of a scan over games.
+class TeamAvailability {
+public:
+    TeamAvailability() = default;
+    TeamAvailability(std::size_t team_count, int season_days) { reset(team_count, season_days); }
+
+    void reset(std::size_t team_count, int season_days) {
+        team_count_ = team_count;
+        season_days_ = season_days < 0 ? 0 : season_days;
+        words_per_team_ = (static_cast<std::size_t>(season_days_) + 63) / 64;
+        bits_.assign(team_count_ * words_per_team_, 0);
+    }
+
+    std::size_t teamCount() const { return team_count_; }
+    int seasonDays() const { return season_days_; }
+
+    // True if `team` has no bookings on days [first_day, first_day + length).
+    // Days outside the season count as unavailable.
+    bool isFree(TeamId team, int first_day, int length) const {
+        if (!inSeason(first_day, length)) {
+            return false;
+        }
+        bool free = true;
+        forEachWord(first_day, length, [&](std::size_t word, std::uint64_t mask) {
+            free = free && (row(team)[word] & mask) == 0;
+        });
+        return free;
+    }
+
+    // Books the range. Returns false without changing anything if any day in
+    // it was already booked (a double-booking) or lies outside the season.
+    bool book(TeamId team, int first_day, int length) {
+        if (!isFree(team, first_day, length)) {
+            return false;
+        }
+        forEachWord(first_day, length, [&](std::size_t word, std::uint64_t mask) { row(team)[word] |= mask; });
+        return true;
+    }
+
+    // Sets the range without checking it (e.g., a stadium closure that overlaps
+    // existing bookings). Days outside the season are ignored.
+    void mark(TeamId team, int first_day, int length) {
+        clampToSeason(first_day, length);
+        if (length > 0) {
+            forEachWord(first_day, length, [&](std::size_t word, std::uint64_t mask) { row(team)[word] |= mask; });
+        }
+    }
+
+    // Clears the range (e.g., when a block is cancelled or moved).
+    void release(TeamId team, int first_day, int length) {
+        if (!inSeason(first_day, length)) {
+            return;
+        }
+        forEachWord(first_day, length, [&](std::size_t word, std::uint64_t mask) { row(team)[word] &= ~mask; });
+    }
+
+    bool isBooked(TeamId team, int day) const {
+        return day >= 0 && day < season_days_ &&
+               (row(team)[static_cast<std::size_t>(day) / 64] >> (static_cast<unsigned>(day) % 64)) & 1u;
+    }
+
+    // First unbooked day >= from_day, or -1 if the team is booked through the
+    // end of the season. Scans a word (64 days) at a time.
+    int firstFreeDay(TeamId team, int from_day) const {
+        if (from_day < 0) {
+            from_day = 0;
+        }
+        if (from_day >= season_days_) {
+            return -1;
+        }
+        const std::uint64_t* bits = row(team);
+        std::size_t word = static_cast<std::size_t>(from_day) / 64;
+        std::uint64_t free_bits = ~bits[word] & (~0ull << (static_cast<unsigned>(from_day) % 64));
+        while (free_bits == 0) {
+            if (++word == words_per_team_) {
+                return -1;
+            }
+            free_bits = ~bits[word];
+        }
+        const int day = static_cast<int>(word * 64 + static_cast<std::size_t>(countTrailingZeros(free_bits)));
+        return day < season_days_ ? day : -1;
+    }
+
+    // First day >= from_day on which every team in [teams, teams + count) is
+    // free, or -1. Each team's scan resumes where the previous candidate failed.
+    int firstCommonFreeDay(const TeamId* teams, std::size_t count, int from_day) const {
+        int day = from_day;
+        for (std::size_t agreed = 0; agreed < count;) {
+            agreed = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                const int free_day = firstFreeDay(teams[i], day);
+                if (free_day < 0) {
+                    return -1;
+                }
+                if (free_day == day) {
+                    ++agreed;
+                } else {
+                    day = free_day;
+                    break;
+                }
+            }
+        }
+        return day;
+    }
+
+    // True if every team in [teams, teams + count) is free for the whole range.
+    bool allFree(const TeamId* teams, std::size_t count, int first_day, int length) const {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (!isFree(teams[i], first_day, length)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    static int countTrailingZeros(std::uint64_t value) { // value != 0
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(value);
+#else
+        int count = 0;
+        while ((value & 1u) == 0) {
+            value >>= 1;
+            ++count;
+        }
+        return count;
+#endif
+    }
+
+    void clampToSeason(int& first_day, int& length) const {
+        if (first_day < 0) {
+            length += first_day;
+            first_day = 0;
+        }
+        if (first_day + length > season_days_) {
+            length = season_days_ - first_day;
+        }
+    }
+
+    bool inSeason(int first_day, int length) const {
+        return length > 0 && first_day >= 0 && first_day + length <= season_days_;
+    }
+
+    std::uint64_t* row(TeamId team) { return &bits_[static_cast<std::size_t>(team) * words_per_team_]; }
+    const std::uint64_t* row(TeamId team) const { return &bits_[static_cast<std::size_t>(team) * words_per_team_]; }
+
+    // Calls fn(word_index, mask) for every word overlapping [first_day, first_day + length).
+    template <typename Fn>
+    static void forEachWord(int first_day, int length, Fn fn) {
+        const std::size_t first = static_cast<std::size_t>(first_day);
+        const std::size_t last = first + static_cast<std::size_t>(length); // exclusive
+        std::size_t word = first / 64;
+        const std::size_t last_word = (last - 1) / 64;
+        for (; word <= last_word; ++word) {
+            const std::size_t lo = word == first / 64 ? first % 64 : 0;
+            const std::size_t hi = word == last_word ? (last - 1) % 64 + 1 : 64; // exclusive
+            const std::uint64_t upper = hi == 64 ? ~0ull : ((1ull << hi) - 1);
+            const std::uint64_t mask = upper & ~((1ull << lo) - 1);
+            fn(word, mask);
+        }
+    }
+
+    std::size_t team_count_ = 0;
+    int season_days_ = 0;
+    std::size_t words_per_team_ = 0;
+    std::vector<std::uint64_t> bits_;
+};
+
+} // namespace LeagueSchedulerNS
+
+#endif // TEAM_AVAILABILITY_H
@@ -0,0 +1,115 @@
+/**
+ * @file fatigue_model.cpp
+ * @brief Time-stepped player fatigue and workload over a season.
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "fatigue_model.h"
+#include <algorithm>
+
+namespace LeagueSchedulerNS {
+
+FatigueModel::FatigueModel(const TeamRegistry& teams, const SeasonSchedule& season, const FatigueConfig& config)
+    : config_(config), team_count_(teams.size()) {
+    rosters_.reserve(team_count_);
+    for (std::size_t t = 0; t < team_count_; ++t) {
+        const Team& team = teams[static_cast<TeamId>(t)];
+        rosters_.emplace_back(team.players.firstRow(), team.players.endRow());
+    }
+
+    bool any = false;
+    CalendarDate last_date;
+    for (const ResidencyBlock& block : season) {
+        for (const Game& game : block.games) {
+            if (!any || game.date < first_date_) {
+                first_date_ = game.date;
+            }
+            if (!any || game.date > last_date) {
+                last_date = game.date;
+            }
+            any = true;
+        }
+    }
+    day_count_ = any ? (last_date - first_date_) + 1 : 0;
+    loads_.assign(static_cast<std::size_t>(day_count_) * team_count_, 0.0);
+
+    // Base load per (day, team); a team normally plays at most once a day.
+    for (const ResidencyBlock& block : season) {
+        for (const Game& game : block.games) {
+            const double base = game.game_type == GameType::CROSSROADS_GAME ? config_.crossroads_load : config_.game_load;
+            const std::size_t day = static_cast<std::size_t>(game.date - first_date_);
+            for (TeamId team : {game.team1, game.team2}) {
+                if (team < team_count_) {
+                    loads_[day * team_count_ + team] += base;
+                }
+            }
+        }
+    }
+
+    // Long stretches without a day off weigh more.
+    for (std::size_t team = 0; team < team_count_; ++team) {
+        int streak = 0;
+        for (int day = 0; day < day_count_; ++day) {
+            double& load = loads_[static_cast<std::size_t>(day) * team_count_ + team];
+            if (load > 0.0) {
+                load *= 1.0 + config_.streak_penalty * std::min(streak, config_.max_streak);
+                ++streak;
+            } else {
+                streak = 0;
+            }
+        }
+    }
+}
+
+void FatigueModel::applyDay(int day, double* fatigue, int* games_played) const {
+    const double* loads = loads_.data() + static_cast<std::size_t>(day) * team_count_;
+    for (std::size_t team = 0; team < team_count_; ++team) {
+        const double load = loads[team];
+        const bool played = load > 0.0;
+        const double keep = played ? config_.game_day_carryover : config_.off_day_recovery;
+        const PlayerRow first = rosters_[team].first;
+        const PlayerRow last = rosters_[team].second;
+        for (PlayerRow r = first; r < last; ++r) {
+            fatigue[r] = std::min(1.0, fatigue[r] * keep + load);
+        }
+        if (played && games_played != nullptr) {
+            for (PlayerRow r = first; r < last; ++r) {
+                ++games_played[r];
+            }
+        }
+    }
+}
+
+void FatigueModel::applyDays(int first_day, int last_day, double* fatigue, int* games_played) const {
+    first_day = std::max(0, first_day);
+    last_day = std::min(day_count_, last_day);
+    for (int day = first_day; day < last_day; ++day) {
+        applyDay(day, fatigue, games_played);
+    }
+}
+
+std::size_t FatigueModel::availablePlayers(const PlayerTable& table, TeamId team, std::vector<PlayerRow>& out) const {
+    if (team >= rosters_.size()) {
+        out.clear();
+        return 0;
+    }
+    return filterByFatigue(table, config_.unavailable_fatigue, rosters_[team].first, rosters_[team].second, out);
+}
+
+} // namespace LeagueSchedulerNS
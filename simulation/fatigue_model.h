@@ -0,0 +1,93 @@
+#ifndef FATIGUE_MODEL_H
+#define FATIGUE_MODEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "../money_and_players/calendar.h"
+#include "../money_and_players/game_data.h"
+#include "../money_and_players/team_registry.h"
+
+namespace LeagueSchedulerNS {
+
+// Daily workload and recovery for rostered players.
+//
+// On a day its team plays, a player's fatigue becomes
+//   min(1, fatigue * game_day_carryover + load)
+// where load = game_load (crossroads_load for a crossroads game) scaled by
+// 1 + streak_penalty * (consecutive game days before today, capped at
+// max_streak). On an off day it becomes fatigue * off_day_recovery.
+struct FatigueConfig {
+    double game_load = 0.06;
+    double crossroads_load = 0.08;     // Neutral-site games in the middle of a residency stretch
+    double streak_penalty = 0.05;
+    int max_streak = 10;
+    double game_day_carryover = 0.92;  // Share of yesterday's fatigue still there after a game day
+    double off_day_recovery = 0.55;    // Share left after a full rest day
+    double unavailable_fatigue = 0.8;  // Players at or above this are unavailable (see isAvailable)
+};
+
+// Time-stepped fatigue over a season.
+//
+// Construction compiles the season into one load value per (day, team), so
+// stepping a day is a single pass over the player columns: each roster is a
+// contiguous row range with one load and one multiplier, which the compiler
+// vectorizes. The model is immutable after construction and steps any
+// fatigue/games-played arrays laid out like the registry's PlayerTable, so
+// Monte Carlo workers can each step their own copy.
+//
+// SeasonSimulator reads fatigue once, when it computes team strengths, so
+// stepping the registry afterwards does not change its results. main does
+// not use the model; callers that want fatigue to count step it before
+// building the simulator.
+//
+//   FatigueModel fatigue(registry, season);
+//   fatigue.applySeason(registry.players());          // whole season
+//   for (int day = 0; day < fatigue.dayCount(); ++day) // or day by day
+//       fatigue.applyDay(day, registry.players());
+class FatigueModel {
+public:
+    FatigueModel(const TeamRegistry& teams, const SeasonSchedule& season,
+                 const FatigueConfig& config = FatigueConfig());
+
+    const FatigueConfig& config() const { return config_; }
+
+    // Days from the first to the last game date, inclusive.
+    int dayCount() const { return day_count_; }
+    CalendarDate firstDate() const { return first_date_; }
+    CalendarDate dateOf(int day) const { return first_date_ + day; }
+
+    // Load on `team` on `day` (0 on an off day).
+    double load(int day, TeamId team) const { return loads_[static_cast<std::size_t>(day) * team_count_ + team]; }
+
+    // Advances one day: updates fatigue and, for teams that played, games played.
+    void applyDay(int day, PlayerTable& table) const {
+        applyDay(day, table.fatigueLevels(), table.gamesPlayedSeason());
+    }
+    // Same over raw columns indexed by PlayerRow (`games_played` may be null).
+    void applyDay(int day, double* fatigue, int* games_played) const;
+
+    // Applies days [first_day, last_day) in order (default: the whole season).
+    void applySeason(PlayerTable& table) const { applyDays(0, day_count_, table.fatigueLevels(), table.gamesPlayedSeason()); }
+    void applyDays(int first_day, int last_day, double* fatigue, int* games_played) const;
+
+    // Availability under this model's threshold.
+    bool isAvailable(const PlayerTable& table, PlayerRow row) const {
+        return table.fatigueLevels()[row] < config_.unavailable_fatigue;
+    }
+    // Rows of `team`'s roster fit to play, written to `out`; returns how many.
+    std::size_t availablePlayers(const PlayerTable& table, TeamId team, std::vector<PlayerRow>& out) const;
+
+private:
+    FatigueConfig config_;
+    std::size_t team_count_ = 0;
+    int day_count_ = 0;
+    CalendarDate first_date_;
+    std::vector<std::pair<PlayerRow, PlayerRow>> rosters_;  // [team] -> rows [first, last)
+    std::vector<double> loads_;                             // [day * team_count + team]
+};
+
+} // namespace LeagueSchedulerNS
+
+#endif // FATIGUE_MODEL_H
@@ -0,0 +1,152 @@
+/**
+ * @file play_by_play.cpp
+ * @brief Plate-appearance season simulation into the columnar event log.
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "play_by_play.h"
+#include <algorithm>
+#include <cmath>
+#include "counter_rng.h"
+#include "instrumentation.h"
+
+namespace LeagueSchedulerNS {
+
+namespace {
+
+// Stream tag for play-by-play draws, distinct from the replay streams.
+constexpr std::uint64_t kPlayByPlayStream = 0x50425950u; // "PBYP"
+
+// A half inning ends after three outs; the cap only guards degenerate models.
+constexpr int kMaxPlateAppearancesPerHalf = 40;
+
+} // namespace
+
+PlayByPlaySimulator::PlayByPlaySimulator(const TeamRegistry& teams, const SeasonSchedule& schedule,
+                                         const PlateAppearanceModel& model)
+    : model_(model) {
+    lineup_offsets_.assign(teams.size() + 1, 0);
+    lineup_skill_.assign(teams.size(), 0.0);
+    for (std::size_t t = 0; t < teams.size(); ++t) {
+        const Team& team = teams[static_cast<TeamId>(t)];
+        const PlayerTable* table = team.players.table();
+        double total = 0.0;
+        if (table != nullptr) {
+            const PlayerRow end = std::min<PlayerRow>(team.players.endRow(),
+                                                      team.players.firstRow() + static_cast<PlayerRow>(std::max(0, model.lineup_size)));
+            for (PlayerRow r = team.players.firstRow(); r < end; ++r) {
+                lineup_.push_back(Batter{table->ids()[r], table->skillRatings()[r]});
+                total += table->skillRatings()[r];
+            }
+        }
+        lineup_offsets_[t + 1] = static_cast<std::uint32_t>(lineup_.size());
+        const std::uint32_t size = lineup_offsets_[t + 1] - lineup_offsets_[t];
+        lineup_skill_[t] = size == 0 ? 0.0 : total / size;
+    }
+
+    for (const ResidencyBlock& block : schedule) {
+        for (const Game& game : block.games) {
+            EventGameInfo info;
+            info.date = game.date;
+            info.team1 = game.team1;
+            info.team2 = game.team2;
+            info.game_type = game.game_type;
+            games_.push_back(info);
+        }
+    }
+}
+
+void PlayByPlaySimulator::thresholds(const Batter& batter, double opponent_skill, std::uint32_t* out) const {
+    const double factor = std::max(0.0, 1.0 + model_.skill_scale * (batter.skill - opponent_skill));
+    double weights[kPlayEventCount];
+    double total = 0.0;
+    for (std::size_t e = 0; e < kPlayEventCount; ++e) {
+        const bool scaled = ((kOutEvents >> e) & 1u) == 0;
+        weights[e] = std::max(0.0, model_.rates[e]) * (scaled ? factor : 1.0);
+        total += weights[e];
+    }
+    double cumulative = 0.0;
+    for (std::size_t e = 0; e < kPlayEventCount; ++e) {
+        cumulative += total > 0.0 ? weights[e] / total : (e == 0 ? 1.0 : 0.0);
+        out[e] = static_cast<std::uint32_t>(std::min(4294967295.0, std::floor(cumulative * 4294967296.0)));
+    }
+    out[kPlayEventCount - 1] = 0xFFFFFFFFu;  // The last outcome takes whatever rounding left over
+}
+
+std::uint64_t PlayByPlaySimulator::record(EventLog& log, std::uint64_t seed) const {
+    APMW_TRACE_SCOPE("simulation.play_by_play");
+    const std::uint32_t first_game = static_cast<std::uint32_t>(log.gameCount());
+    log.reserveGames(log.gameCount() + games_.size());
+    for (const EventGameInfo& game : games_) {
+        log.addGame(game);
+    }
+
+    std::vector<std::uint32_t> cdf;
+    std::uint64_t appended = 0;
+    for (std::size_t g = 0; g < games_.size(); ++g) {
+        const EventGameInfo& game = games_[g];
+        const std::uint32_t log_game = first_game + static_cast<std::uint32_t>(g);
+        CounterRng stream = CounterRng::forStream(seed, {kPlayByPlayStream, static_cast<std::uint64_t>(g)});
+
+        // Thresholds for both lineups: team1 bats first against team2, then the reverse.
+        const TeamId sides[2] = {game.team1, game.team2};
+        std::uint32_t side_offset[2];
+        std::uint32_t side_size[2];
+        cdf.clear();
+        for (int s = 0; s < 2; ++s) {
+            const TeamId batting = sides[s];
+            const TeamId fielding = sides[1 - s];
+            side_offset[s] = static_cast<std::uint32_t>(cdf.size() / kPlayEventCount);
+            side_size[s] = lineup_offsets_[batting + 1] - lineup_offsets_[batting];
+            cdf.resize(cdf.size() + side_size[s] * kPlayEventCount);
+            for (std::uint32_t b = 0; b < side_size[s]; ++b) {
+                thresholds(lineup_[lineup_offsets_[batting] + b], lineup_skill_[fielding],
+                           cdf.data() + (side_offset[s] + b) * kPlayEventCount);
+            }
+        }
+
+        std::uint32_t next_batter[2] = {0, 0};
+        for (int inning = 1; inning <= model_.innings; ++inning) {
+            for (int s = 0; s < 2; ++s) {
+                if (side_size[s] == 0) {
+                    continue;
+                }
+                const Batter* lineup = lineup_.data() + lineup_offsets_[sides[s]];
+                int outs = 0;
+                for (int pa = 0; outs < 3 && pa < kMaxPlateAppearancesPerHalf; ++pa) {
+                    const std::uint32_t batter = next_batter[s];
+                    next_batter[s] = batter + 1 == side_size[s] ? 0 : batter + 1;
+                    const std::uint32_t* thresholds_for = cdf.data() + (side_offset[s] + batter) * kPlayEventCount;
+                    const std::uint32_t draw = static_cast<std::uint32_t>(stream() >> 32);
+                    std::size_t event = 0;
+                    while (draw > thresholds_for[event]) {
+                        ++event;
+                    }
+                    outs += static_cast<int>((kOutEvents >> event) & 1u);
+                    log.append(log_game, lineup[batter].player_id, static_cast<std::uint8_t>(inning),
+                               static_cast<PlayEvent>(event));
+                    ++appended;
+                }
+            }
+        }
+    }
+    return appended;
+}
+
+} // namespace LeagueSchedulerNS
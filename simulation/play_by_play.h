@@ -0,0 +1,72 @@
+#ifndef PLAY_BY_PLAY_H
+#define PLAY_BY_PLAY_H
+
+#include <cstdint>
+#include <vector>
+#include "../money_and_players/game_data.h"
+#include "../money_and_players/team_registry.h"
+#include "../storage/event_log.h"
+
+namespace LeagueSchedulerNS {
+
+// Plate-appearance outcome model.
+// `rates` is the outcome distribution for a batter as good as the opposing
+// lineup (indexed by PlayEvent). For a batter `d` skill points better, the
+// walk and hit rates are scaled by (1 + skill_scale * d) before renormalizing;
+// the opposing lineup's mean skill stands in for its pitching.
+struct PlateAppearanceModel {
+    double rates[kPlayEventCount] = {
+        0.22,   // STRIKEOUT
+        0.22,   // GROUND_OUT
+        0.23,   // FLY_OUT
+        0.01,   // SACRIFICE
+        0.08,   // WALK
+        0.01,   // HIT_BY_PITCH
+        0.15,   // SINGLE
+        0.045,  // DOUBLE
+        0.005,  // TRIPLE
+        0.03,   // HOME_RUN
+    };
+    double skill_scale = 0.02;
+    int innings = 9;
+    int lineup_size = 9;             // The first N rostered players bat, in roster order
+};
+
+// Plays a season plate appearance by plate appearance into an EventLog.
+//
+// Every game draws from its own counter-based stream keyed by (seed, game
+// index), so a game's events do not depend on which other games were played.
+// Outcome distributions are quantized to 32-bit thresholds per batter and
+// game, making each plate appearance one draw and a short compare chain. The
+// model is independent of SeasonSimulator's win/loss draw: it produces
+// batting lines, not game results.
+class PlayByPlaySimulator {
+public:
+    PlayByPlaySimulator(const TeamRegistry& teams, const SeasonSchedule& schedule,
+                        const PlateAppearanceModel& model = PlateAppearanceModel());
+
+    std::size_t gameCount() const { return games_.size(); }
+
+    // Adds every game of the schedule to `log` (in schedule order) and appends
+    // its plate appearances. Returns the number of events appended.
+    std::uint64_t record(EventLog& log, std::uint64_t seed) const;
+
+private:
+    struct Batter {
+        std::int32_t player_id;
+        double skill;
+    };
+
+    // Cumulative outcome thresholds for one batter against one lineup.
+    void thresholds(const Batter& batter, double opponent_skill, std::uint32_t* out) const;
+
+    PlateAppearanceModel model_;
+    std::vector<EventGameInfo> games_;
+    std::vector<std::uint32_t> lineup_offsets_;  // Team t bats lineup_[offsets[t], offsets[t + 1])
+    std::vector<Batter> lineup_;
+    std::vector<double> lineup_skill_;           // Mean skill per team lineup
+};
+
+} // namespace LeagueSchedulerNS
+
+#endif // PLAY_BY_PLAY_H
@@ -0,0 +1,235 @@
+/**
+ * @file season_simulator.cpp
+ * @brief Game outcome model and parallel Monte Carlo replays of a generated season.
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "season_simulator.h"
+#include <algorithm>
+#include <cmath>
+#include "counter_rng.h"
+#include "instrumentation.h"
+#include "work_stealing_pool.h"
+
+namespace LeagueSchedulerNS {
+
+namespace {
+
+// Every replay gets its own counter-based stream keyed by (seed, replay).
+CounterRng replayStream(std::uint64_t seed, std::size_t replay) {
+    return CounterRng::forStream(seed, {static_cast<std::uint64_t>(replay)});
+}
+
+// Integer accumulators for one worker. Integer sums are order-independent,
+// so merging the workers' tallies gives the same totals for any thread count.
+struct Tally {
+    std::vector<std::uint64_t> wins_total;
+    std::vector<std::uint32_t> playoffs;
+    std::vector<std::uint32_t> finish;     // [team * max_group_size + rank]
+    std::vector<std::uint32_t> histogram;  // [team * (max_games + 1) + wins]
+
+    Tally(std::size_t n, std::size_t max_group_size, int max_games)
+        : wins_total(n, 0), playoffs(n, 0), finish(n * max_group_size, 0),
+          histogram(n * static_cast<std::size_t>(max_games + 1), 0) {}
+};
+
+} // namespace
+
+SeasonSimulator::SeasonSimulator(const TeamRegistry& teams, const SeasonSchedule& schedule,
+                                 const GameOutcomeModel& model)
+    : topology_(teams) {
+    std::vector<double> strength(teams.size());
+    for (std::size_t t = 0; t < teams.size(); ++t) {
+        strength[t] = teamStrength(teams[static_cast<TeamId>(t)], model);
+    }
+
+    std::vector<int> games_per_team(teams.size(), 0);
+    for (const ResidencyBlock& block : schedule) {
+        for (const Game& game : block.games) {
+            const bool team2_is_host = game.team2 == game.actual_host_stadium;
+            const double p = winProbability(strength[game.team1], strength[game.team2], team2_is_host, model);
+            const double scaled = std::min(4294967295.0, std::max(0.0, std::floor(p * 4294967296.0)));
+            games_.push_back(SimGame{game.team1, game.team2, static_cast<std::uint32_t>(scaled)});
+            ++games_per_team[game.team1];
+            ++games_per_team[game.team2];
+        }
+    }
+    for (int games : games_per_team) {
+        max_games_per_team_ = std::max(max_games_per_team_, games);
+    }
+}
+
+double SeasonSimulator::winProbability(double team1_strength, double team2_strength, bool team2_is_stadium_host,
+                                       const GameOutcomeModel& model) {
+    double edge = team2_strength - team1_strength + model.last_bat_advantage;
+    if (team2_is_stadium_host) {
+        edge += model.home_stadium_advantage;
+    }
+    return 1.0 / (1.0 + std::exp(edge / model.logistic_scale));
+}
+
+double SeasonSimulator::teamStrength(const Team& team, const GameOutcomeModel& model) {
+    const PlayerTable* table = team.players.table();
+    if (team.players.empty() || table == nullptr) {
+        return 50.0;
+    }
+    const double* skill = table->skillRatings();
+    const double* fatigue = table->fatigueLevels();
+    double total = 0.0;
+    for (PlayerRow r = team.players.firstRow(); r < team.players.endRow(); ++r) {
+        total += skill[r] * (1.0 - model.fatigue_penalty * fatigue[r]);
+    }
+    return total / static_cast<double>(team.players.size());
+}
+
+template <typename Fn>
+void SeasonSimulator::playGames(std::uint64_t seed, Fn fn) const {
+    CounterRng stream = replayStream(seed, 0);
+    for (const SimGame& game : games_) {
+        const bool team1_wins = static_cast<std::uint32_t>(stream() >> 32) < game.team1_wins_below;
+        fn(team1_wins ? game.team1 : game.team2, team1_wins ? game.team2 : game.team1);
+    }
+}
+
+void SeasonSimulator::playSeason(TeamRegistry& teams, std::uint64_t seed) const {
+    std::vector<int> wins(teams.size(), 0);
+    std::vector<int> played(teams.size(), 0);
+    playGames(seed, [&](TeamId winner, TeamId loser) {
+        ++wins[winner];
+        ++played[winner];
+        ++played[loser];
+    });
+
+    int* games_played = teams.players().gamesPlayedSeason();
+    for (std::size_t t = 0; t < teams.size(); ++t) {
+        Team& team = teams[static_cast<TeamId>(t)];
+        team.wins += wins[t];
+        team.losses += played[t] - wins[t];
+        for (PlayerRow r = team.players.firstRow(); r < team.players.endRow(); ++r) {
+            games_played[r] += played[t];
+        }
+    }
+}
+
+void SeasonSimulator::playSeason(StandingsService::Writer& standings, std::uint64_t seed) const {
+    playGames(seed, [&](TeamId winner, TeamId loser) { standings.record(winner, loser); });
+    standings.flush();
+}
+
+MonteCarloResult SeasonSimulator::runMonteCarlo(const MonteCarloConfig& config) const {
+    APMW_TRACE_SCOPE("simulation.monte_carlo");
+    const std::size_t n = topology_.teamCount();
+    MonteCarloResult result;
+    result.replays = std::max(0, config.replays);
+    result.teams.resize(n);
+    if (n == 0 || result.replays == 0) {
+        return result;
+    }
+
+    // Teams grouped by union for playoff qualification and finish ranks.
+    std::vector<std::vector<TeamId>> groups;
+    for (std::size_t u = 0; u < kUnionCount; ++u) {
+        const TeamIdRange members = topology_.unionMembers(static_cast<UnionType>(u));
+        if (!members.empty()) {
+            groups.emplace_back(members.begin(), members.end());
+        }
+    }
+    // Ranks only run up to a union's size, so the finish tally is sized by the largest union.
+    std::size_t max_group_size = 0;
+    for (const auto& group : groups) {
+        max_group_size = std::max(max_group_size, group.size());
+    }
+
+    WorkStealingPool pool(config.threads);
+    std::vector<Tally> tallies(pool.size(), Tally(n, max_group_size, max_games_per_team_));
+
+    pool.parallelFor(static_cast<std::size_t>(result.replays), static_cast<std::size_t>(std::max(1, config.replays_per_task)),
+        [&](std::size_t begin, std::size_t end, unsigned worker) {
+            APMW_TRACE_SCOPE("simulation.replays");
+            Tally& tally = tallies[worker];
+            std::vector<int> wins(n);
+            std::vector<std::uint64_t> tiebreak(n);
+            std::vector<TeamId> order;
+            for (std::size_t replay = begin; replay < end; ++replay) {
+                CounterRng stream = replayStream(config.seed, replay);
+                std::fill(wins.begin(), wins.end(), 0);
+                for (const SimGame& game : games_) {
+                    const bool team1_wins = static_cast<std::uint32_t>(stream() >> 32) < game.team1_wins_below;
+                    ++wins[team1_wins ? game.team1 : game.team2];
+                }
+                for (std::size_t t = 0; t < n; ++t) {
+                    tiebreak[t] = stream();
+                    tally.wins_total[t] += static_cast<std::uint64_t>(wins[t]);
+                    ++tally.histogram[t * static_cast<std::size_t>(max_games_per_team_ + 1) + wins[t]];
+                }
+                for (const auto& group : groups) {
+                    order = group;
+                    std::sort(order.begin(), order.end(), [&](TeamId a, TeamId b) {
+                        if (wins[a] != wins[b]) {
+                            return wins[a] > wins[b];
+                        }
+                        return tiebreak[a] > tiebreak[b];
+                    });
+                    for (std::size_t rank = 0; rank < order.size(); ++rank) {
+                        ++tally.finish[static_cast<std::size_t>(order[rank]) * max_group_size + rank];
+                        if (rank < static_cast<std::size_t>(config.playoff_spots_per_union)) {
+                            ++tally.playoffs[order[rank]];
+                        }
+                    }
+                }
+            }
+        });
+
+    Tally total(n, max_group_size, max_games_per_team_);
+    for (const Tally& tally : tallies) {
+        for (std::size_t i = 0; i < n; ++i) {
+            total.wins_total[i] += tally.wins_total[i];
+            total.playoffs[i] += tally.playoffs[i];
+        }
+        for (std::size_t i = 0; i < total.finish.size(); ++i) {
+            total.finish[i] += tally.finish[i];
+        }
+        for (std::size_t i = 0; i < total.histogram.size(); ++i) {
+            total.histogram[i] += tally.histogram[i];
+        }
+    }
+
+    const double replays = static_cast<double>(result.replays);
+    const std::size_t bins = static_cast<std::size_t>(max_games_per_team_ + 1);
+    for (std::size_t t = 0; t < n; ++t) {
+        TeamSeasonOdds& odds = result.teams[t];
+        odds.mean_wins = static_cast<double>(total.wins_total[t]) / replays;
+        odds.playoff_probability = total.playoffs[t] / replays;
+        std::size_t group_size = 0;
+        for (const auto& group : groups) {
+            if (std::find(group.begin(), group.end(), static_cast<TeamId>(t)) != group.end()) {
+                group_size = group.size();
+            }
+        }
+        odds.union_finish_probability.resize(group_size);
+        for (std::size_t rank = 0; rank < group_size; ++rank) {
+            odds.union_finish_probability[rank] = total.finish[t * max_group_size + rank] / replays;
+        }
+        odds.win_histogram.assign(total.histogram.begin() + static_cast<std::ptrdiff_t>(t * bins),
+                                  total.histogram.begin() + static_cast<std::ptrdiff_t>((t + 1) * bins));
+    }
+    return result;
+}
+
+} // namespace LeagueSchedulerNS
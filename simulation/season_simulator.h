@@ -0,0 +1,99 @@
+#ifndef SEASON_SIMULATOR_H
+#define SEASON_SIMULATOR_H
+
+#include <cstdint>
+#include <vector>
+#include "../money_and_players/game_data.h"
+#include "../money_and_players/league_topology.h"
+#include "../money_and_players/team_registry.h"
+#include "standings.h"
+
+namespace LeagueSchedulerNS {
+
+// Parameters of the single-game outcome model.
+// A team's strength is the mean of skill_rating * (1 - fatigue_penalty * fatigue_level)
+// over its roster. The win probability is logistic in the strength gap (in
+// skill points), with small edges for batting last and for playing in the
+// team's own stadium.
+struct GameOutcomeModel {
+    double logistic_scale = 10.0;         // Skill points per unit of log-odds
+    double last_bat_advantage = 0.5;      // Edge for the designated home team (bats second)
+    double home_stadium_advantage = 1.0;  // Extra edge when that team is also the stadium host
+    double fatigue_penalty = 0.3;         // Fraction of skill lost at fatigue_level 1.0
+};
+
+// Settings for a batch of replays of the same schedule.
+struct MonteCarloConfig {
+    int replays = 1000;
+    std::uint64_t seed = 0x41504D57u;
+    unsigned threads = 0;                 // 0 = one per hardware thread
+    int replays_per_task = 32;            // Work-stealing grain size
+    int playoff_spots_per_union = 3;      // Top N by wins in each UnionType qualify
+};
+
+// Distribution of one team's results over all replays.
+struct TeamSeasonOdds {
+    double mean_wins = 0.0;
+    double playoff_probability = 0.0;
+    std::vector<double> union_finish_probability; // [rank] within the team's union, 0 = first
+    std::vector<std::uint32_t> win_histogram;     // [wins] -> number of replays
+};
+
+struct MonteCarloResult {
+    int replays = 0;
+    std::vector<TeamSeasonOdds> teams;            // Indexed by TeamId
+};
+
+// Simulates seasons over a generated schedule.
+//
+// Construction compiles the schedule into a flat list of games with each
+// game's win probability pre-quantized to a 32-bit threshold, so a simulated
+// game is one random draw and one integer compare.
+//
+// Every replay draws from its own random stream derived from (seed, replay
+// index), and replay results are accumulated into integer counters. The
+// output therefore depends only on the seed, never on the thread count or on
+// which worker ran which replay.
+class SeasonSimulator {
+public:
+    SeasonSimulator(const TeamRegistry& teams, const SeasonSchedule& schedule,
+                    const GameOutcomeModel& model = GameOutcomeModel());
+
+    // Plays the schedule once and records the results in the registry:
+    // Team::wins/losses and each rostered player's games_played_season.
+    void playSeason(TeamRegistry& teams, std::uint64_t seed) const;
+    // Plays the same season (same seed, same results) into a standings writer,
+    // one result per game in schedule order.
+    void playSeason(StandingsService::Writer& standings, std::uint64_t seed) const;
+
+    // Replays the schedule `config.replays` times across a work-stealing pool.
+    MonteCarloResult runMonteCarlo(const MonteCarloConfig& config) const;
+
+    std::size_t gameCount() const { return games_.size(); }
+
+    // Probability that `team1` (bats first) beats `team2` under the model.
+    static double winProbability(double team1_strength, double team2_strength, bool team2_is_stadium_host,
+                                 const GameOutcomeModel& model);
+
+    // Roster strength used by the model (mean fatigue-adjusted skill).
+    static double teamStrength(const Team& team, const GameOutcomeModel& model);
+
+private:
+    // Plays every game once from the (seed, 0) stream, calling fn(winner, loser).
+    template <typename Fn>
+    void playGames(std::uint64_t seed, Fn fn) const;
+
+    struct SimGame {
+        TeamId team1;               // Bats first
+        TeamId team2;               // Bats second
+        std::uint32_t team1_wins_below; // team1 wins if the 32-bit draw is below this
+    };
+
+    std::vector<SimGame> games_;
+    LeagueTopology topology_;       // Playoff groups are the unions
+    int max_games_per_team_ = 0;
+};
+
+} // namespace LeagueSchedulerNS
+
+#endif // SEASON_SIMULATOR_H
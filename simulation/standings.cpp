@@ -0,0 +1,143 @@
+/**
+ * @file standings.cpp
+ * @brief Streaming league standings with RCU-published snapshots.
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "standings.h"
+#include <algorithm>
+
+namespace LeagueSchedulerNS {
+
+namespace {
+
+// Sign of a.wins / a.games - b.wins / b.games, exactly (no floating point).
+// A team without games counts as .000.
+int comparePercentage(std::uint32_t a_wins, std::uint32_t a_games, std::uint32_t b_wins, std::uint32_t b_games) {
+    const std::uint64_t lhs = static_cast<std::uint64_t>(a_wins) * (b_games == 0 ? 1 : b_games);
+    const std::uint64_t rhs = static_cast<std::uint64_t>(b_wins) * (a_games == 0 ? 1 : a_games);
+    return lhs < rhs ? -1 : (lhs > rhs ? 1 : 0);
+}
+
+bool ranksAhead(const StandingsEntry& a, const StandingsEntry& b) {
+    const TeamRecord& x = a.record;
+    const TeamRecord& y = b.record;
+    if (int c = comparePercentage(x.wins, x.games(), y.wins, y.games())) {
+        return c > 0;
+    }
+    if (int c = comparePercentage(x.union_wins, x.union_wins + x.union_losses, y.union_wins,
+                                  y.union_wins + y.union_losses)) {
+        return c > 0;
+    }
+    if (int c = comparePercentage(x.region_wins, x.region_wins + x.region_losses, y.region_wins,
+                                  y.region_wins + y.region_losses)) {
+        return c > 0;
+    }
+    return a.team < b.team;
+}
+
+} // namespace
+
+StandingsService::StandingsService(const TeamRegistry& teams)
+    : topology_(teams), totals_(teams.size()) {
+    all_teams_.reserve(teams.size());
+    for (std::size_t t = 0; t < teams.size(); ++t) {
+        all_teams_.push_back(static_cast<TeamId>(t));
+    }
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    publishLocked();
+}
+
+void StandingsService::apply(const GameResult* results, std::size_t count) {
+    Writer batch(*this, count + 1);
+    for (std::size_t i = 0; i < count; ++i) {
+        batch.record(results[i]);
+    }
+    batch.flush();
+}
+
+StandingsService::Writer::Writer(StandingsService& service, std::size_t publish_every)
+    : service_(&service), publish_every_(publish_every == 0 ? 1 : publish_every),
+      delta_(service.teamCount()), touched_flag_(service.teamCount(), 0) {}
+
+void StandingsService::Writer::flush() {
+    if (pending_ == 0) {
+        return;
+    }
+    service_->merge(delta_, touched_, pending_);
+    for (TeamId team : touched_) {
+        touched_flag_[team] = 0;
+    }
+    touched_.clear();
+    pending_ = 0;
+}
+
+void StandingsService::merge(std::vector<TeamRecord>& delta, const std::vector<TeamId>& touched, std::size_t results) {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    for (TeamId team : touched) {
+        TeamRecord& total = totals_[team];
+        TeamRecord& d = delta[team];
+        total.wins += d.wins;
+        total.losses += d.losses;
+        total.union_wins += d.union_wins;
+        total.union_losses += d.union_losses;
+        total.region_wins += d.region_wins;
+        total.region_losses += d.region_losses;
+        d = TeamRecord();
+    }
+    results_ += results;
+    publishLocked();
+}
+
+void StandingsService::publishLocked() {
+    auto next = std::make_shared<StandingsSnapshot>();
+    next->version_ = ++version_;
+    next->results_ = results_;
+    next->records_ = totals_;
+    next->league_ = buildTable(TeamIdRange(all_teams_.data(), all_teams_.data() + all_teams_.size()));
+    next->unions_.reserve(kUnionCount);
+    for (std::size_t u = 0; u < kUnionCount; ++u) {
+        next->unions_.push_back(buildTable(topology_.unionMembers(static_cast<UnionType>(u))));
+    }
+    next->regions_.reserve(kRegionCount);
+    for (std::size_t r = 0; r < kRegionCount; ++r) {
+        next->regions_.push_back(buildTable(topology_.regionMembers(static_cast<RegionType>(r))));
+    }
+    // Readers holding the previous snapshot keep it alive until they drop it.
+    std::atomic_store(&current_, std::shared_ptr<const StandingsSnapshot>(std::move(next)));
+}
+
+std::vector<StandingsEntry> StandingsService::buildTable(TeamIdRange members) const {
+    std::vector<StandingsEntry> table;
+    table.reserve(members.size());
+    for (TeamId team : members) {
+        table.push_back(StandingsEntry{team, totals_[team], 0.0});
+    }
+    std::sort(table.begin(), table.end(), ranksAhead);
+    if (!table.empty()) {
+        const TeamRecord& leader = table.front().record;
+        for (StandingsEntry& entry : table) {
+            entry.games_behind = ((static_cast<double>(leader.wins) - entry.record.wins) +
+                                  (static_cast<double>(entry.record.losses) - leader.losses)) / 2.0;
+        }
+    }
+    return table;
+}
+
+} // namespace LeagueSchedulerNS
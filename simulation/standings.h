@@ -0,0 +1,186 @@
+#ifndef STANDINGS_H
+#define STANDINGS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "../money_and_players/league_topology.h"
+#include "../money_and_players/team_registry.h"
+
+namespace LeagueSchedulerNS {
+
+struct GameResult {
+    TeamId winner = kInvalidTeamId;
+    TeamId loser = kInvalidTeamId;
+};
+
+// A team's record. Games against teams of the same UnionType / RegionType
+// also count toward the union / region record (the tiebreakers); UNKNOWN
+// matches no one.
+struct TeamRecord {
+    std::uint32_t wins = 0;
+    std::uint32_t losses = 0;
+    std::uint32_t union_wins = 0;
+    std::uint32_t union_losses = 0;
+    std::uint32_t region_wins = 0;
+    std::uint32_t region_losses = 0;
+
+    std::uint32_t games() const { return wins + losses; }
+    double winPercentage() const { return games() == 0 ? 0.0 : static_cast<double>(wins) / games(); }
+};
+
+struct StandingsEntry {
+    TeamId team = kInvalidTeamId;
+    TeamRecord record;
+    double games_behind = 0.0;  // Behind the first team of the same table
+};
+
+// Immutable standings as of one publication. Tables are ordered by win
+// percentage, then union record, then region record, then TeamId.
+class StandingsSnapshot {
+public:
+    // Increases by one with every publication.
+    std::uint64_t version() const { return version_; }
+    // Results applied so far.
+    std::uint64_t results() const { return results_; }
+
+    std::size_t teamCount() const { return records_.size(); }
+    const TeamRecord& record(TeamId team) const { return records_[team]; }
+
+    const std::vector<StandingsEntry>& league() const { return league_; }
+    // Empty for a union or region without teams.
+    const std::vector<StandingsEntry>& unionTable(UnionType type) const {
+        return unions_[static_cast<std::size_t>(type)];
+    }
+    const std::vector<StandingsEntry>& regionTable(RegionType type) const {
+        return regions_[static_cast<std::size_t>(type)];
+    }
+
+private:
+    friend class StandingsService;
+
+    std::uint64_t version_ = 0;
+    std::uint64_t results_ = 0;
+    std::vector<TeamRecord> records_;                  // Indexed by TeamId
+    std::vector<StandingsEntry> league_;
+    std::vector<std::vector<StandingsEntry>> unions_;  // Indexed by UnionType
+    std::vector<std::vector<StandingsEntry>> regions_; // Indexed by RegionType
+};
+
+// League standings keyed by TeamId, fed by streaming game results.
+//
+// Writers accumulate results in a private Writer (plain integer increments,
+// nothing shared) and periodically merge them into the league totals, which
+// publishes a new immutable StandingsSnapshot. Publication is RCU-style: the
+// current snapshot is a shared_ptr swapped atomically, so readers (dashboards,
+// playoff odds) take a consistent view with one atomic load and never wait on
+// writers; writers only serialize with each other, once per merge.
+//
+//   StandingsService standings(registry);
+//   StandingsService::Writer writer = standings.writer();
+//   writer.record(winner, loser);              // hot path, any number of writers
+//   ...
+//   auto view = standings.snapshot();          // any thread, any time
+//   for (const StandingsEntry& e : view->unionTable(UnionType::ATLANTIC)) ...
+class StandingsService {
+public:
+    // Results merged per publication by default; larger batches make each
+    // result cheaper, smaller ones make snapshots fresher.
+    static constexpr std::size_t kDefaultPublishEvery = 4096;
+
+    // Team unions and regions are read once; later registry changes are not seen.
+    explicit StandingsService(const TeamRegistry& teams);
+
+    StandingsService(const StandingsService&) = delete;
+    StandingsService& operator=(const StandingsService&) = delete;
+
+    std::size_t teamCount() const { return topology_.teamCount(); }
+
+    // Latest published standings. Safe from any thread.
+    std::shared_ptr<const StandingsSnapshot> snapshot() const { return std::atomic_load(&current_); }
+
+    // Applies a batch of results and publishes once.
+    void apply(const GameResult* results, std::size_t count);
+    void apply(const std::vector<GameResult>& results) { apply(results.data(), results.size()); }
+
+    // Single-threaded result buffer. Use one per writing thread.
+    class Writer {
+    public:
+        Writer(StandingsService& service, std::size_t publish_every);
+        ~Writer() { flush(); }
+
+        Writer(Writer&& other) noexcept
+            : service_(other.service_), publish_every_(other.publish_every_), pending_(other.pending_),
+              delta_(std::move(other.delta_)), touched_(std::move(other.touched_)),
+              touched_flag_(std::move(other.touched_flag_)) {
+            other.pending_ = 0;
+        }
+        Writer(const Writer&) = delete;
+        Writer& operator=(const Writer&) = delete;
+
+        void record(TeamId winner, TeamId loser) {
+            if (winner >= delta_.size() || loser >= delta_.size()) {
+                return;
+            }
+            touch(winner);
+            touch(loser);
+            // Union and region games from one topology lookup, added without branches.
+            const unsigned flags = service_->topology_.pairFlags(winner, loser);
+            const std::uint32_t same_union = flags & kSameUnion;
+            const std::uint32_t same_region = (flags & kSameRegion) >> 1;
+            ++delta_[winner].wins;
+            ++delta_[loser].losses;
+            delta_[winner].union_wins += same_union;
+            delta_[loser].union_losses += same_union;
+            delta_[winner].region_wins += same_region;
+            delta_[loser].region_losses += same_region;
+            if (++pending_ >= publish_every_) {
+                flush();
+            }
+        }
+        void record(const GameResult& result) { record(result.winner, result.loser); }
+
+        // Merges the buffered results and publishes a snapshot (no-op when empty).
+        void flush();
+
+    private:
+        void touch(TeamId team) {
+            if (!touched_flag_[team]) {
+                touched_flag_[team] = 1;
+                touched_.push_back(team);
+            }
+        }
+
+        StandingsService* service_;
+        std::size_t publish_every_;
+        std::size_t pending_ = 0;
+        std::vector<TeamRecord> delta_;
+        std::vector<TeamId> touched_;
+        std::vector<std::uint8_t> touched_flag_;
+    };
+
+    Writer writer(std::size_t publish_every = kDefaultPublishEvery) { return Writer(*this, publish_every); }
+
+private:
+    // Adds `delta` rows for `touched` teams to the totals and publishes. Clears the delta.
+    void merge(std::vector<TeamRecord>& delta, const std::vector<TeamId>& touched, std::size_t results);
+    void publishLocked();
+    std::vector<StandingsEntry> buildTable(TeamIdRange members) const;
+
+    LeagueTopology topology_;                         // Unions, regions and their members
+    std::vector<TeamId> all_teams_;
+
+    std::mutex write_mutex_;                          // Serializes merges (writers only)
+    std::vector<TeamRecord> totals_;
+    std::uint64_t results_ = 0;
+    std::uint64_t version_ = 0;
+
+    std::shared_ptr<const StandingsSnapshot> current_;
+};
+
+} // namespace LeagueSchedulerNS
+
+#endif // STANDINGS_H
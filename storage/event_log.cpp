@@ -0,0 +1,531 @@
+/**
+ * @file event_log.cpp
+ * @brief Columnar, compressed play-by-play event log with zone-mapped queries.
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "event_log.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+#include "mapped_file.h"
+
+namespace LeagueSchedulerNS {
+
+namespace {
+
+constexpr std::uint64_t alignUp8(std::uint64_t value) { return (value + 7) & ~std::uint64_t(7); }
+
+// Same check as the season archive: the section lies inside the file and is aligned.
+bool sectionFits(std::uint64_t offset, std::uint64_t count, std::size_t size, std::size_t align,
+                 std::uint64_t file_size) {
+    if (offset % align != 0 || offset > file_size) {
+        return false;
+    }
+    return count <= (file_size - offset) / size;
+}
+
+std::uint8_t widthFor(std::uint32_t max_value) {
+    return max_value <= 0xFFu ? 1 : (max_value <= 0xFFFFu ? 2 : 4);
+}
+
+void putUnsigned(unsigned char* out, std::uint8_t width, std::uint32_t value) {
+    if (width == 1) {
+        *out = static_cast<unsigned char>(value);
+    } else if (width == 2) {
+        const std::uint16_t narrow = static_cast<std::uint16_t>(value);
+        std::memcpy(out, &narrow, sizeof(narrow));
+    } else {
+        std::memcpy(out, &value, sizeof(value));
+    }
+}
+
+std::uint32_t getUnsigned(const unsigned char* in, std::uint8_t width, std::size_t i) {
+    if (width == 1) {
+        return in[i];
+    }
+    if (width == 2) {
+        std::uint16_t value;
+        std::memcpy(&value, in + 2 * i, sizeof(value));
+        return value;
+    }
+    std::uint32_t value;
+    std::memcpy(&value, in + 4 * i, sizeof(value));
+    return value;
+}
+
+std::uint64_t blockBytes(const EventBlockIndex& block) {
+    const std::uint64_t game_values = block.game_encoding == EventLog::kRunGames ? block.run_count : block.count;
+    return std::uint64_t(block.dictionary_size) * sizeof(std::int32_t) + std::uint64_t(block.run_count) * sizeof(std::uint16_t) +
+           std::uint64_t(block.count) * (block.player_width + 2u) + game_values * block.game_width;
+}
+
+} // namespace
+
+// Pointers to one sealed block's columns inside data_.
+//
+//   int32 dictionary[dictionary_size]   sorted player ids
+//   uint16 run_ends[run_count]          exclusive end of each game run
+//   codes[count]                        player_width bytes each
+//   games[run_count or count]           game - min_game, game_width bytes each
+//   uint8 innings[count], uint8 events[count]
+struct EventLog::BlockColumns {
+    const std::int32_t* dictionary;
+    const std::uint16_t* run_ends;
+    const unsigned char* codes;
+    const unsigned char* games;
+    const std::uint8_t* innings;
+    const std::uint8_t* events;
+};
+
+EventLog::EventLog()
+    : tail_game_(kBlockEvents), tail_player_(kBlockEvents), tail_inning_(kBlockEvents), tail_event_(kBlockEvents) {}
+
+std::uint32_t EventLog::addGame(const EventGameInfo& game) {
+    games_.push_back(game);
+    game_type_bits_.push_back(gameTypeBit(game.game_type));
+    return static_cast<std::uint32_t>(games_.size() - 1);
+}
+
+void EventLog::clear() {
+    games_.clear();
+    game_type_bits_.clear();
+    blocks_.clear();
+    data_.clear();
+    sealed_events_ = 0;
+    tail_count_ = 0;
+}
+
+EventLog::BlockColumns EventLog::columns(const EventBlockIndex& block) const {
+    const unsigned char* base = data_.data() + block.offset;
+    BlockColumns columns;
+    columns.dictionary = reinterpret_cast<const std::int32_t*>(base);
+    columns.run_ends = reinterpret_cast<const std::uint16_t*>(base + std::size_t(block.dictionary_size) * sizeof(std::int32_t));
+    columns.codes = reinterpret_cast<const unsigned char*>(columns.run_ends + block.run_count);
+    columns.games = columns.codes + std::size_t(block.count) * block.player_width;
+    const std::size_t game_values = block.game_encoding == kRunGames ? block.run_count : block.count;
+    columns.innings = columns.games + game_values * block.game_width;
+    columns.events = columns.innings + block.count;
+    return columns;
+}
+
+void EventLog::seal() {
+    const std::size_t n = tail_count_;
+    if (n == 0) {
+        return;
+    }
+    EventBlockIndex block{};
+    block.count = static_cast<std::uint32_t>(n);
+    block.min_game = block.max_game = tail_game_[0];
+    block.min_player = block.max_player = tail_player_[0];
+    block.min_inning = block.max_inning = tail_inning_[0];
+    bool ascending = true;
+    for (std::size_t i = 0; i < n; ++i) {
+        block.min_game = std::min(block.min_game, tail_game_[i]);
+        block.max_game = std::max(block.max_game, tail_game_[i]);
+        block.min_player = std::min(block.min_player, tail_player_[i]);
+        block.max_player = std::max(block.max_player, tail_player_[i]);
+        block.min_inning = std::min(block.min_inning, tail_inning_[i]);
+        block.max_inning = std::max(block.max_inning, tail_inning_[i]);
+        block.event_mask |= 1u << tail_event_[i];
+        block.game_types |= game_type_bits_[tail_game_[i]];
+        ascending = ascending && (i == 0 || tail_game_[i] >= tail_game_[i - 1]);
+    }
+
+    std::vector<std::int32_t> dictionary(tail_player_.begin(), tail_player_.begin() + static_cast<std::ptrdiff_t>(n));
+    std::sort(dictionary.begin(), dictionary.end());
+    dictionary.erase(std::unique(dictionary.begin(), dictionary.end()), dictionary.end());
+    block.dictionary_size = static_cast<std::uint16_t>(dictionary.size());
+    block.player_width = dictionary.size() <= 256 ? 1 : 2;
+
+    // Run-length encode game indexes that arrive in order; otherwise store offsets from the minimum.
+    std::vector<std::uint32_t> run_games;
+    std::vector<std::uint16_t> run_ends;
+    if (ascending) {
+        for (std::size_t i = 0; i < n; ++i) {
+            if (i == 0 || tail_game_[i] != tail_game_[i - 1]) {
+                run_games.push_back(tail_game_[i] - block.min_game);
+                run_ends.push_back(0);
+            }
+            run_ends.back() = static_cast<std::uint16_t>(i + 1);
+        }
+    }
+    block.game_encoding = ascending ? kRunGames : kFrameGames;
+    block.run_count = static_cast<std::uint16_t>(run_ends.size());
+    block.game_width = widthFor(block.max_game - block.min_game);
+
+    block.offset = alignUp8(data_.size());
+    data_.resize(static_cast<std::size_t>(alignUp8(block.offset + blockBytes(block))), 0);
+    unsigned char* out = data_.data() + block.offset;
+    std::memcpy(out, dictionary.data(), dictionary.size() * sizeof(std::int32_t));
+    out += dictionary.size() * sizeof(std::int32_t);
+    std::memcpy(out, run_ends.data(), run_ends.size() * sizeof(std::uint16_t));
+    unsigned char* codes = out + run_ends.size() * sizeof(std::uint16_t);
+    unsigned char* games = codes + n * block.player_width;
+    unsigned char* innings = games + (ascending ? run_games.size() : n) * block.game_width;
+    unsigned char* events = innings + n;
+    for (std::size_t r = 0; r < run_games.size(); ++r) {
+        putUnsigned(games + r * block.game_width, block.game_width, run_games[r]);
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto code = std::lower_bound(dictionary.begin(), dictionary.end(), tail_player_[i]) - dictionary.begin();
+        putUnsigned(codes + i * block.player_width, block.player_width, static_cast<std::uint32_t>(code));
+        if (!ascending) {
+            putUnsigned(games + i * block.game_width, block.game_width, tail_game_[i] - block.min_game);
+        }
+        innings[i] = static_cast<std::uint8_t>(tail_inning_[i] - block.min_inning);
+        events[i] = tail_event_[i];
+    }
+
+    blocks_.push_back(block);
+    sealed_events_ += n;
+    tail_count_ = 0;
+}
+
+bool EventLog::blockMayMatch(const EventBlockIndex& block, const EventQuery& query) const {
+    if ((block.event_mask & query.events) == 0 || (block.game_types & query.game_types) == 0) {
+        return false;
+    }
+    if (block.max_game < query.first_game || block.min_game > query.last_game ||
+        block.max_inning < query.first_inning || block.min_inning > query.last_inning) {
+        return false;
+    }
+    return query.player == EventQuery::kAnyPlayer ||
+           (query.player >= block.min_player && query.player <= block.max_player);
+}
+
+// Calls run(block, columns, game, begin, end, wanted_code, check_inning) for
+// every stretch [begin, end) of a sealed block whose events share a game that
+// passes the query's game filters. Blocks are pruned by their zone maps first;
+// `wanted_code` is the queried player's dictionary code (-1 = any player) and
+// `check_inning` is set when the block's innings are not all inside the query.
+template <typename RunFn>
+void EventLog::scanRuns(const EventQuery& query, RunFn&& run) const {
+    const bool any_player = query.player == EventQuery::kAnyPlayer;
+    for (const EventBlockIndex& block : blocks_) {
+        if (!blockMayMatch(block, query)) {
+            continue;
+        }
+        const BlockColumns column = columns(block);
+        int wanted_code = -1;
+        if (!any_player) {
+            const std::int32_t* found =
+                std::lower_bound(column.dictionary, column.dictionary + block.dictionary_size, query.player);
+            if (found == column.dictionary + block.dictionary_size || *found != query.player) {
+                continue;
+            }
+            wanted_code = static_cast<int>(found - column.dictionary);
+        }
+        const bool check_inning = query.first_inning > block.min_inning || query.last_inning < block.max_inning;
+        auto gameMatches = [&](std::uint32_t game) {
+            return game >= query.first_game && game <= query.last_game && (game_type_bits_[game] & query.game_types) != 0;
+        };
+
+        if (block.game_encoding == kRunGames) {
+            std::uint32_t begin = 0;
+            for (std::uint32_t r = 0; r < block.run_count; ++r) {
+                const std::uint32_t end = column.run_ends[r];
+                const std::uint32_t game = block.min_game + getUnsigned(column.games, block.game_width, r);
+                if (gameMatches(game)) {
+                    run(block, column, game, begin, end, wanted_code, check_inning);
+                }
+                begin = end;
+            }
+        } else {
+            for (std::uint32_t i = 0; i < block.count; ++i) {
+                const std::uint32_t game = block.min_game + getUnsigned(column.games, block.game_width, i);
+                if (gameMatches(game)) {
+                    run(block, column, game, i, i + 1, wanted_code, check_inning);
+                }
+            }
+        }
+    }
+}
+
+// Calls visit(game, player, inning, event) for every matching event in log order.
+template <typename Visit>
+void EventLog::scan(const EventQuery& query, Visit&& visit) const {
+    scanRuns(query, [&](const EventBlockIndex& block, const BlockColumns& column, std::uint32_t game, std::uint32_t begin,
+                        std::uint32_t end, int wanted_code, bool check_inning) {
+        for (std::uint32_t i = begin; i < end; ++i) {
+            const std::uint8_t event = column.events[i];
+            const std::uint32_t code = getUnsigned(column.codes, block.player_width, i);
+            const std::uint8_t inning = static_cast<std::uint8_t>(block.min_inning + column.innings[i]);
+            if (((query.events >> event) & 1u) == 0 || (wanted_code >= 0 && code != static_cast<std::uint32_t>(wanted_code)) ||
+                (check_inning && (inning < query.first_inning || inning > query.last_inning))) {
+                continue;
+            }
+            visit(game, column.dictionary[code], inning, event);
+        }
+    });
+
+    const bool any_player = query.player == EventQuery::kAnyPlayer;
+    for (std::size_t i = 0; i < tail_count_; ++i) {
+        const std::uint32_t game = tail_game_[i];
+        const std::uint8_t inning = tail_inning_[i];
+        const std::uint8_t event = tail_event_[i];
+        if (((query.events >> event) & 1u) == 0 || (!any_player && tail_player_[i] != query.player) ||
+            inning < query.first_inning || inning > query.last_inning ||
+            game < query.first_game || game > query.last_game || (game_type_bits_[game] & query.game_types) == 0) {
+            continue;
+        }
+        visit(game, tail_player_[i], inning, event);
+    }
+}
+
+EventCounts EventLog::counts(const EventQuery& query) const {
+    // Sealed runs without an inning filter are histogrammed straight off the
+    // code and event bytes; the query's event mask is applied at the end.
+    std::uint64_t histogram[256] = {};
+    EventCounts counts;
+    scanRuns(query, [&](const EventBlockIndex& block, const BlockColumns& column, std::uint32_t, std::uint32_t begin,
+                        std::uint32_t end, int wanted_code, bool check_inning) {
+        const std::uint8_t* events = column.events;
+        if (check_inning) {
+            for (std::uint32_t i = begin; i < end; ++i) {
+                const std::uint8_t inning = static_cast<std::uint8_t>(block.min_inning + column.innings[i]);
+                const bool player_ok =
+                    wanted_code < 0 || getUnsigned(column.codes, block.player_width, i) == static_cast<std::uint32_t>(wanted_code);
+                histogram[events[i]] += player_ok && inning >= query.first_inning && inning <= query.last_inning;
+            }
+        } else if (wanted_code < 0) {
+            for (std::uint32_t i = begin; i < end; ++i) ++histogram[events[i]];
+        } else if (block.player_width == 1) {
+            // One player is a small share of a block: jump between its codes.
+            const unsigned char* codes = column.codes;
+            const unsigned char* at = codes + begin;
+            const unsigned char* stop = codes + end;
+            while ((at = static_cast<const unsigned char*>(std::memchr(at, wanted_code, static_cast<std::size_t>(stop - at)))) != nullptr) {
+                ++histogram[events[at - codes]];
+                ++at;
+            }
+        } else {
+            for (std::uint32_t i = begin; i < end; ++i) {
+                histogram[events[i]] += getUnsigned(column.codes, 2, i) == static_cast<std::uint32_t>(wanted_code);
+            }
+        }
+    });
+    for (std::size_t e = 0; e < kPlayEventCount; ++e) {
+        counts.by_event[e] = ((query.events >> e) & 1u) ? histogram[e] : 0;
+    }
+
+    const bool any_player = query.player == EventQuery::kAnyPlayer;
+    for (std::size_t i = 0; i < tail_count_; ++i) {
+        const std::uint32_t game = tail_game_[i];
+        const std::uint8_t inning = tail_inning_[i];
+        const std::uint8_t event = tail_event_[i];
+        counts.by_event[event] += ((query.events >> event) & 1u) && (any_player || tail_player_[i] == query.player) &&
+                                  inning >= query.first_inning && inning <= query.last_inning &&
+                                  game >= query.first_game && game <= query.last_game &&
+                                  (game_type_bits_[game] & query.game_types) != 0;
+    }
+    return counts;
+}
+
+void EventLog::forEach(const EventQuery& query, const std::function<void(const PlayEventRecord&)>& visit) const {
+    scan(query, [&](std::uint32_t game, std::int32_t player, std::uint8_t inning, std::uint8_t event) {
+        PlayEventRecord record;
+        record.game = game;
+        record.player = player;
+        record.inning = inning;
+        record.event = static_cast<PlayEvent>(event);
+        visit(record);
+    });
+}
+
+std::vector<std::pair<std::int32_t, EventCounts>> EventLog::countsByPlayer(const EventQuery& query) const {
+    std::vector<std::pair<std::int32_t, EventCounts>> lines;
+    std::unordered_map<std::int32_t, std::size_t> slot;
+    scan(query, [&](std::uint32_t, std::int32_t player, std::uint8_t, std::uint8_t event) {
+        auto inserted = slot.emplace(player, lines.size());
+        if (inserted.second) {
+            lines.emplace_back(player, EventCounts());
+        }
+        ++lines[inserted.first->second].second.by_event[event];
+    });
+    return lines;
+}
+
+std::size_t EventLog::applyBattingAverages(PlayerTable& players) const {
+    std::size_t updated = 0;
+    for (const auto& line : countsByPlayer()) {
+        const PlayerRow row = players.rowOf(line.first);
+        if (row >= players.size() || line.second.atBats() == 0) {
+            continue;
+        }
+        players.metrics().set(row, Metrics::BATTING_AVERAGE, line.second.battingAverage());
+        ++updated;
+    }
+    return updated;
+}
+
+bool EventLog::save(const std::string& path) {
+    seal();
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        std::cerr << "Error: cannot create " << path << std::endl;
+        return false;
+    }
+
+    EventLogHeader header{};
+    std::memcpy(header.magic, kEventLogMagic, sizeof(header.magic));
+    header.version = kEventLogVersion;
+    header.byte_order = kEventLogByteOrder;
+    header.game_count = games_.size();
+    header.event_count = sealed_events_;
+    header.block_count = blocks_.size();
+    header.data_size = data_.size();
+    header.games_offset = alignUp8(sizeof(EventLogHeader));
+    header.blocks_offset = alignUp8(header.games_offset + header.game_count * sizeof(EventGameRecord));
+    header.data_offset = alignUp8(header.blocks_offset + header.block_count * sizeof(EventBlockIndex));
+
+    std::vector<EventGameRecord> records(games_.size());
+    for (std::size_t g = 0; g < games_.size(); ++g) {
+        records[g] = EventGameRecord{};
+        records[g].date = games_[g].date.dayNumber();
+        records[g].team1 = games_[g].team1;
+        records[g].team2 = games_[g].team2;
+        records[g].game_type = static_cast<std::uint8_t>(games_[g].game_type);
+    }
+
+    std::uint64_t position = 0;
+    bool ok = true;
+    auto write = [&](std::uint64_t offset, const void* data, std::size_t size) {
+        static const char zeros[8] = {};
+        while (ok && position < offset) {
+            const std::size_t pad = static_cast<std::size_t>(std::min<std::uint64_t>(offset - position, sizeof(zeros)));
+            ok = std::fwrite(zeros, 1, pad, file) == pad;
+            position += pad;
+        }
+        if (ok && size != 0) {
+            ok = std::fwrite(data, 1, size, file) == size;
+            position += size;
+        }
+    };
+    write(0, &header, sizeof(header));
+    write(header.games_offset, records.data(), records.size() * sizeof(EventGameRecord));
+    write(header.blocks_offset, blocks_.data(), blocks_.size() * sizeof(EventBlockIndex));
+    write(header.data_offset, data_.data(), data_.size());
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok) {
+        std::cerr << "Error: write failed for " << path << std::endl;
+    }
+    return ok;
+}
+
+bool EventLog::load(const std::string& path) {
+    MappedFile file;
+    if (!file.open(path)) {
+        return false;
+    }
+    const unsigned char* base = file.data();
+    const std::uint64_t size = file.size();
+    auto fail = [&](const char* what) {
+        std::cerr << "Error: " << path << " is not a usable event log (" << what << ")" << std::endl;
+        clear();
+        return false;
+    };
+
+    if (size < sizeof(EventLogHeader)) {
+        return fail("truncated header");
+    }
+    EventLogHeader header;
+    std::memcpy(&header, base, sizeof(header));
+    if (std::memcmp(header.magic, kEventLogMagic, sizeof(header.magic)) != 0) {
+        return fail("bad magic");
+    }
+    if (header.byte_order != kEventLogByteOrder) {
+        return fail("foreign byte order");
+    }
+    if (header.version != kEventLogVersion) {
+        return fail("unsupported version");
+    }
+    if (!sectionFits(header.games_offset, header.game_count, sizeof(EventGameRecord), alignof(EventGameRecord), size) ||
+        !sectionFits(header.blocks_offset, header.block_count, sizeof(EventBlockIndex), alignof(EventBlockIndex), size) ||
+        !sectionFits(header.data_offset, header.data_size, 1, 8, size)) {
+        return fail("section out of bounds");
+    }
+
+    clear();
+    const auto* records = reinterpret_cast<const EventGameRecord*>(base + header.games_offset);
+    games_.reserve(static_cast<std::size_t>(header.game_count));
+    for (std::uint64_t g = 0; g < header.game_count; ++g) {
+        if (records[g].game_type >= kGameTypeCount) {
+            return fail("unknown game type");
+        }
+        EventGameInfo game;
+        game.date = CalendarDate(records[g].date);
+        game.team1 = records[g].team1;
+        game.team2 = records[g].team2;
+        game.game_type = static_cast<GameType>(records[g].game_type);
+        addGame(game);
+    }
+    const auto* blocks = reinterpret_cast<const EventBlockIndex*>(base + header.blocks_offset);
+    blocks_.assign(blocks, blocks + header.block_count);
+    data_.assign(base + header.data_offset, base + header.data_offset + header.data_size);
+
+    // Validate every block so scans can index dictionaries, histograms and game types unchecked.
+    std::uint64_t events = 0;
+    for (const EventBlockIndex& block : blocks_) {
+        if (block.count == 0 || block.count > kBlockEvents || block.dictionary_size == 0 ||
+            block.dictionary_size > block.count || block.offset % 8 != 0 ||
+            (block.player_width != 1 && block.player_width != 2) ||
+            (block.game_width != 1 && block.game_width != 2 && block.game_width != 4) ||
+            block.game_encoding > kFrameGames || (block.game_encoding == kRunGames) != (block.run_count != 0) ||
+            block.min_game > block.max_game || block.max_game >= header.game_count ||
+            block.offset > header.data_size || blockBytes(block) > header.data_size - block.offset) {
+            return fail("bad block index");
+        }
+        const BlockColumns column = columns(block);
+        const std::uint32_t game_span = block.max_game - block.min_game;
+        const std::size_t game_values = block.game_encoding == kRunGames ? block.run_count : block.count;
+        std::uint32_t previous_end = 0;
+        for (std::size_t r = 0; r < block.run_count; ++r) {
+            if (column.run_ends[r] <= previous_end || column.run_ends[r] > block.count) {
+                return fail("bad game runs");
+            }
+            previous_end = column.run_ends[r];
+        }
+        if (block.run_count != 0 && previous_end != block.count) {
+            return fail("bad game runs");
+        }
+        for (std::size_t i = 0; i < game_values; ++i) {
+            if (getUnsigned(column.games, block.game_width, i) > game_span) {
+                return fail("block data out of range");
+            }
+        }
+        for (std::uint32_t i = 0; i < block.count; ++i) {
+            if (getUnsigned(column.codes, block.player_width, i) >= block.dictionary_size ||
+                column.events[i] >= kPlayEventCount) {
+                return fail("block data out of range");
+            }
+        }
+        events += block.count;
+    }
+    if (events != header.event_count) {
+        return fail("event count mismatch");
+    }
+    sealed_events_ = events;
+    return true;
+}
+
+} // namespace LeagueSchedulerNS
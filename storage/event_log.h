@@ -0,0 +1,260 @@
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../money_and_players/calendar.h"
+#include "../money_and_players/game_data.h"
+#include "../money_and_players/player_table.h"
+#include "../money_and_players/team_registry.h"
+
+namespace LeagueSchedulerNS {
+
+// Outcome of one plate appearance.
+enum class PlayEvent : std::uint8_t {
+    STRIKEOUT,
+    GROUND_OUT,
+    FLY_OUT,
+    SACRIFICE,
+    WALK,
+    HIT_BY_PITCH,
+    SINGLE,
+    DOUBLE,
+    TRIPLE,
+    HOME_RUN
+};
+
+// Display names indexed by PlayEvent (keep in enum order).
+constexpr const char* kPlayEventNames[] = {"STRIKEOUT", "GROUND_OUT", "FLY_OUT", "SACRIFICE", "WALK",
+                                           "HIT_BY_PITCH", "SINGLE", "DOUBLE", "TRIPLE", "HOME_RUN"};
+constexpr std::size_t kPlayEventCount = sizeof(kPlayEventNames) / sizeof(kPlayEventNames[0]);
+static_assert(kPlayEventCount == static_cast<std::size_t>(PlayEvent::HOME_RUN) + 1,
+              "kPlayEventNames must cover every PlayEvent");
+
+inline const char* playEventName(PlayEvent event) { return kPlayEventNames[static_cast<std::size_t>(event)]; }
+
+// PlayEvent sets as bit masks (bit e = PlayEvent e).
+constexpr std::uint32_t eventBit(PlayEvent event) { return 1u << static_cast<unsigned>(event); }
+constexpr std::uint32_t kAllPlayEvents = (1u << kPlayEventCount) - 1;
+constexpr std::uint32_t kHitEvents =
+    eventBit(PlayEvent::SINGLE) | eventBit(PlayEvent::DOUBLE) | eventBit(PlayEvent::TRIPLE) | eventBit(PlayEvent::HOME_RUN);
+// Plate appearances that count as at bats (not walks, hit-by-pitch or sacrifices).
+constexpr std::uint32_t kAtBatEvents =
+    kAllPlayEvents & ~(eventBit(PlayEvent::WALK) | eventBit(PlayEvent::HIT_BY_PITCH) | eventBit(PlayEvent::SACRIFICE));
+constexpr std::uint32_t kOutEvents = eventBit(PlayEvent::STRIKEOUT) | eventBit(PlayEvent::GROUND_OUT) |
+                                     eventBit(PlayEvent::FLY_OUT) | eventBit(PlayEvent::SACRIFICE);
+
+// GameType sets as bit masks.
+constexpr std::uint8_t gameTypeBit(GameType type) { return static_cast<std::uint8_t>(1u << static_cast<unsigned>(type)); }
+constexpr std::uint8_t kAllGameTypes = static_cast<std::uint8_t>((1u << kGameTypeCount) - 1);
+
+// One event in row form (what append() takes and forEach() hands out).
+struct PlayEventRecord {
+    std::uint32_t game = 0;          // EventLog game index
+    std::int32_t player = 0;         // Player::id of the batter
+    std::uint8_t inning = 0;
+    PlayEvent event = PlayEvent::STRIKEOUT;
+};
+
+// The game an event belongs to (one row of the log's game table).
+struct EventGameInfo {
+    CalendarDate date;
+    TeamId team1 = kInvalidTeamId;
+    TeamId team2 = kInvalidTeamId;
+    GameType game_type = GameType::REGULAR_SEASON;
+};
+
+// Filter for EventLog scans. Every field narrows the result; the defaults match everything.
+struct EventQuery {
+    static constexpr std::int32_t kAnyPlayer = std::numeric_limits<std::int32_t>::min();
+
+    std::int32_t player = kAnyPlayer;
+    std::uint32_t events = kAllPlayEvents;   // PlayEvent mask
+    std::uint8_t game_types = kAllGameTypes; // GameType mask
+    std::uint32_t first_game = 0;            // Inclusive game index range
+    std::uint32_t last_game = std::numeric_limits<std::uint32_t>::max();
+    std::uint8_t first_inning = 0;           // Inclusive
+    std::uint8_t last_inning = 255;
+};
+
+// Per-event counts for a query, with the usual batting line on top.
+struct EventCounts {
+    std::uint64_t by_event[kPlayEventCount] = {};
+
+    std::uint64_t count(std::uint32_t event_mask) const {
+        std::uint64_t total = 0;
+        for (std::size_t e = 0; e < kPlayEventCount; ++e) {
+            total += ((event_mask >> e) & 1u) ? by_event[e] : 0;
+        }
+        return total;
+    }
+    std::uint64_t plateAppearances() const { return count(kAllPlayEvents); }
+    std::uint64_t atBats() const { return count(kAtBatEvents); }
+    std::uint64_t hits() const { return count(kHitEvents); }
+    std::uint64_t homeRuns() const { return by_event[static_cast<std::size_t>(PlayEvent::HOME_RUN)]; }
+    double battingAverage() const { return atBats() == 0 ? 0.0 : static_cast<double>(hits()) / atBats(); }
+};
+
+// Per-block zone map and encoding of a sealed block (also the on-disk index record).
+struct EventBlockIndex {
+    std::uint64_t offset;            // Into the column data, 8-byte aligned
+    std::uint32_t count;             // Events in the block
+    std::uint32_t min_game;
+    std::uint32_t max_game;
+    std::int32_t min_player;
+    std::int32_t max_player;
+    std::uint32_t event_mask;        // PlayEvents present
+    std::uint16_t dictionary_size;   // Distinct players in the block
+    std::uint16_t run_count;         // Game runs (kRunGames only)
+    std::uint8_t game_encoding;      // EventLog::kRunGames or kFrameGames
+    std::uint8_t game_width;         // Bytes per encoded game value (1, 2 or 4)
+    std::uint8_t player_width;       // Bytes per player dictionary code (1 or 2)
+    std::uint8_t min_inning;
+    std::uint8_t max_inning;
+    std::uint8_t game_types;         // GameTypes present
+    std::uint16_t reserved[3];
+};
+
+// Event log file (".apmwevents"): fixed-layout, versioned, native byte order.
+//
+//   EventLogHeader
+//   EventGameRecord games[game_count]
+//   EventBlockIndex blocks[block_count]
+//   unsigned char data[data_size]      the sealed blocks' columns, as in memory
+constexpr char kEventLogMagic[8] = {'A', 'P', 'M', 'W', 'E', 'V', 'T', '\0'};
+constexpr std::uint32_t kEventLogVersion = 1;
+constexpr std::uint32_t kEventLogByteOrder = 0x01020304u;
+
+struct EventLogHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint64_t game_count;
+    std::uint64_t event_count;
+    std::uint64_t block_count;
+    std::uint64_t data_size;
+    std::uint64_t games_offset;
+    std::uint64_t blocks_offset;
+    std::uint64_t data_offset;
+};
+
+struct EventGameRecord {
+    std::uint16_t date;              // CalendarDate day number
+    TeamId team1;
+    TeamId team2;
+    std::uint8_t game_type;
+    std::uint8_t reserved;
+};
+
+static_assert(sizeof(EventLogHeader) == 72, "EventLogHeader layout changed; bump kEventLogVersion");
+static_assert(sizeof(EventGameRecord) == 8, "EventGameRecord layout changed; bump kEventLogVersion");
+static_assert(sizeof(EventBlockIndex) == 48, "EventBlockIndex layout changed; bump kEventLogVersion");
+
+// Append-only, columnar play-by-play log for one season.
+//
+// Events are appended to an uncompressed tail of kBlockEvents rows (four flat
+// column arrays). A full tail is sealed into a compressed block:
+//   - players: a sorted per-block dictionary of ids plus 1- or 2-byte codes,
+//   - games: run-length encoded (game, end of run) pairs when the events
+//     arrive in game order, as a simulator writes them; otherwise 1-, 2- or
+//     4-byte offsets from the block minimum,
+//   - innings: offsets from the block minimum, one byte,
+//   - events: one byte.
+// Each block keeps a zone map (game, player and inning ranges, the PlayEvents
+// and GameTypes present), so a query skips blocks without touching their
+// data, finds a player's dictionary code once per block, checks game filters
+// once per run, and counts over the code and event bytes in place. Queries
+// cover the tail as well.
+//
+//   EventLog log;
+//   const std::uint32_t game = log.addGame(info);
+//   log.append(game, player_id, inning, PlayEvent::HOME_RUN);
+//   EventQuery query;
+//   query.player = player_id;
+//   double average = log.counts(query).battingAverage();
+class EventLog {
+public:
+    static constexpr std::size_t kBlockEvents = 4096;
+    static constexpr std::uint8_t kRunGames = 0;
+    static constexpr std::uint8_t kFrameGames = 1;
+
+    EventLog();
+
+    // Registers a game; events refer to it by the returned index.
+    std::uint32_t addGame(const EventGameInfo& game);
+    void reserveGames(std::size_t games) { games_.reserve(games); }
+
+    // `game` must be an index returned by addGame().
+    void append(std::uint32_t game, std::int32_t player, std::uint8_t inning, PlayEvent event) {
+        tail_game_[tail_count_] = game;
+        tail_player_[tail_count_] = player;
+        tail_inning_[tail_count_] = inning;
+        tail_event_[tail_count_] = static_cast<std::uint8_t>(event);
+        if (++tail_count_ == kBlockEvents) {
+            seal();
+        }
+    }
+    void append(const PlayEventRecord& record) { append(record.game, record.player, record.inning, record.event); }
+
+    // Compresses the tail into a block (done automatically when it fills up).
+    void seal();
+    void clear();
+
+    std::size_t gameCount() const { return games_.size(); }
+    const EventGameInfo& game(std::uint32_t index) const { return games_[index]; }
+    std::uint64_t size() const { return sealed_events_ + tail_count_; }
+    std::size_t blockCount() const { return blocks_.size(); }
+    const EventBlockIndex& blockIndex(std::size_t block) const { return blocks_[block]; }
+    // Bytes held by sealed blocks (columns plus index), vs. sizeof(PlayEventRecord) per event.
+    std::size_t compressedBytes() const { return data_.size() + blocks_.size() * sizeof(EventBlockIndex); }
+
+    // --- Queries ---
+    EventCounts counts(const EventQuery& query) const;
+    std::uint64_t count(const EventQuery& query) const { return counts(query).count(query.events); }
+    // Visits matching events in log order.
+    void forEach(const EventQuery& query, const std::function<void(const PlayEventRecord&)>& visit) const;
+    // Season batting line of every batter (one scan); unsorted.
+    std::vector<std::pair<std::int32_t, EventCounts>> countsByPlayer(const EventQuery& query = EventQuery()) const;
+    // Writes Metrics::BATTING_AVERAGE for every player in `players` with at
+    // least one at bat in the log; returns how many were updated.
+    std::size_t applyBattingAverages(PlayerTable& players) const;
+
+    // --- Files ---
+    // Seals the tail, then writes the log. Returns false (and reports to std::cerr) on failure.
+    bool save(const std::string& path);
+    // Replaces the log with a saved one. Returns false (and reports to
+    // std::cerr) if the file is missing, truncated, from another version or
+    // byte order, or refers outside itself.
+    bool load(const std::string& path);
+
+private:
+    struct BlockColumns;
+    BlockColumns columns(const EventBlockIndex& block) const;
+    bool blockMayMatch(const EventBlockIndex& block, const EventQuery& query) const;
+    template <typename RunFn>
+    void scanRuns(const EventQuery& query, RunFn&& run) const;
+    template <typename Visit>
+    void scan(const EventQuery& query, Visit&& visit) const;
+
+    std::vector<EventGameInfo> games_;
+    std::vector<std::uint8_t> game_type_bits_;   // gameTypeBit() per game, for per-event game type checks
+
+    std::vector<EventBlockIndex> blocks_;
+    std::vector<unsigned char> data_;
+    std::uint64_t sealed_events_ = 0;
+
+    std::size_t tail_count_ = 0;
+    std::vector<std::uint32_t> tail_game_;       // kBlockEvents each
+    std::vector<std::int32_t> tail_player_;
+    std::vector<std::uint8_t> tail_inning_;
+    std::vector<std::uint8_t> tail_event_;
+};
+
+} // namespace LeagueSchedulerNS
+
+#endif // EVENT_LOG_H
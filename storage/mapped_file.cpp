@@ -0,0 +1,122 @@
+/**
+ * @file mapped_file.cpp
+ * @brief Read-only memory mapping of a file (mmap on POSIX, buffered read elsewhere).
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mapped_file.h"
+#include <fstream>
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define APMW_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define APMW_HAVE_MMAP 0
+#endif
+
+namespace LeagueSchedulerNS {
+
+namespace {
+// Stand-in address for an empty file, so isOpen() stays true.
+const unsigned char kEmptyFile = 0;
+} // namespace
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        data_ = other.data_;
+        size_ = other.size_;
+        mapped_ = other.mapped_;
+        fallback_ = std::move(other.fallback_);
+        if (!mapped_ && !fallback_.empty()) {
+            data_ = fallback_.data();
+        }
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.mapped_ = false;
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+#if APMW_HAVE_MMAP
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Error: cannot open " << path << std::endl;
+        return false;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        std::cerr << "Error: cannot stat " << path << std::endl;
+        ::close(fd);
+        return false;
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+    if (size_ == 0) {
+        ::close(fd);
+        data_ = &kEmptyFile;
+        return true;
+    }
+    void* address = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // The mapping keeps its own reference to the file
+    if (address == MAP_FAILED) {
+        std::cerr << "Error: cannot map " << path << std::endl;
+        size_ = 0;
+        return false;
+    }
+    data_ = static_cast<const unsigned char*>(address);
+    mapped_ = true;
+    return true;
+#else
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        std::cerr << "Error: cannot open " << path << std::endl;
+        return false;
+    }
+    fallback_.resize(static_cast<std::size_t>(in.tellg()));
+    in.seekg(0);
+    if (!fallback_.empty() && !in.read(reinterpret_cast<char*>(fallback_.data()), fallback_.size())) {
+        std::cerr << "Error: cannot read " << path << std::endl;
+        fallback_.clear();
+        return false;
+    }
+    size_ = fallback_.size();
+    data_ = fallback_.empty() ? &kEmptyFile : fallback_.data();
+    return true;
+#endif
+}
+
+void MappedFile::close() {
+#if APMW_HAVE_MMAP
+    if (mapped_) {
+        ::munmap(const_cast<unsigned char*>(data_), size_);
+    }
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+    fallback_.clear();
+}
+
+} // namespace LeagueSchedulerNS
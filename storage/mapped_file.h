@@ -0,0 +1,43 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace LeagueSchedulerNS {
+
+// Read-only view of a whole file.
+// On POSIX systems the file is mmap'ed, so opening costs a system call and the
+// pages are shared with the OS page cache (and with every other process that
+// maps the same file); nothing is copied until it is touched. Elsewhere the
+// file is read into a private buffer.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // Maps `path`. Returns false (and reports to std::cerr) if the file cannot be opened.
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return data_ != nullptr; }
+    const unsigned char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+private:
+    const unsigned char* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool mapped_ = false;                  // true: data_ came from mmap and must be unmapped
+    std::vector<unsigned char> fallback_;  // Owns the bytes when mmap is unavailable
+};
+
+} // namespace LeagueSchedulerNS
+
+#endif // MAPPED_FILE_H
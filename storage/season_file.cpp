@@ -0,0 +1,294 @@
+/**
+ * @file season_file.cpp
+ * @brief Binary season archive: streaming writer and mmap-backed zero-copy reader.
+ *
+ * @copyright Copyright (C) 2025 Eeshvar Das (Erik Douglas Ward)
+ *
+ * @license SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "season_file.h"
+#include <cstring>
+#include <iostream>
+
+namespace LeagueSchedulerNS {
+
+namespace {
+
+constexpr std::uint64_t alignUp8(std::uint64_t value) { return (value + 7) & ~std::uint64_t(7); }
+
+// True if [offset, offset + count * size) lies inside a file of `file_size`
+// bytes and starts on a boundary suitable for the record type.
+bool sectionFits(std::uint64_t offset, std::uint64_t count, std::size_t size, std::size_t align,
+                 std::uint64_t file_size) {
+    if (offset % align != 0 || offset > file_size) {
+        return false;
+    }
+    return count <= (file_size - offset) / size;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------- writer
+
+SeasonFileWriter::~SeasonFileWriter() {
+    if (file_ != nullptr) {
+        std::fclose(file_);
+    }
+}
+
+bool SeasonFileWriter::writeBytes(const void* data, std::size_t size) {
+    if (size != 0 && std::fwrite(data, 1, size, file_) != size) {
+        std::cerr << "Error: write failed for " << path_ << std::endl;
+        return false;
+    }
+    position_ += size;
+    return true;
+}
+
+bool SeasonFileWriter::padTo8() {
+    static const char zeros[8] = {};
+    return writeBytes(zeros, static_cast<std::size_t>(alignUp8(position_) - position_));
+}
+
+bool SeasonFileWriter::open(const std::string& path, const TeamRegistry& teams, const SeasonFileInfo& info) {
+    if (file_ != nullptr) {
+        std::fclose(file_);
+    }
+    path_ = path;
+    position_ = 0;
+    blocks_.clear();
+    visitors_.clear();
+    file_ = std::fopen(path.c_str(), "wb");
+    if (file_ == nullptr) {
+        std::cerr << "Error: cannot create " << path << std::endl;
+        return false;
+    }
+
+    header_ = SeasonFileHeader{};
+    std::memcpy(header_.magic, kSeasonFileMagic, sizeof(header_.magic));
+    header_.version = kSeasonFileVersion;
+    header_.byte_order = kSeasonFileByteOrder;
+    header_.seed = info.seed;
+    header_.season_index = info.season_index;
+    header_.season_start = info.season_start.dayNumber();
+    header_.team_count = static_cast<std::uint32_t>(teams.size());
+
+    // Team records and their string pool are known up front.
+    std::vector<SeasonTeamRecord> records(teams.size());
+    std::string strings;
+    for (std::size_t i = 0; i < teams.size(); ++i) {
+        const Team& team = teams[static_cast<TeamId>(i)];
+        SeasonTeamRecord& record = records[i];
+        record = SeasonTeamRecord{};
+        record.team_number = team.id;
+        record.city_offset = static_cast<std::uint32_t>(strings.size());
+        record.city_length = static_cast<std::uint16_t>(team.city.size());
+        strings += team.city;
+        record.mascot_offset = static_cast<std::uint32_t>(strings.size());
+        record.mascot_length = static_cast<std::uint16_t>(team.mascot_theme.size());
+        strings += team.mascot_theme;
+        record.union_type = static_cast<std::uint8_t>(team.union_type);
+        record.region_type = static_cast<std::uint8_t>(team.region_type);
+    }
+    header_.strings_size = strings.size();
+
+    // Placeholder header; finish() rewrites it with the final counts and offsets.
+    if (!writeBytes(&header_, sizeof(header_)) || !padTo8()) {
+        return false;
+    }
+    header_.teams_offset = position_;
+    if (!writeBytes(records.data(), records.size() * sizeof(SeasonTeamRecord)) || !padTo8()) {
+        return false;
+    }
+    header_.strings_offset = position_;
+    if (!writeBytes(strings.data(), strings.size()) || !padTo8()) {
+        return false;
+    }
+    header_.games_offset = position_;
+    return true;
+}
+
+bool SeasonFileWriter::append(const ResidencyBlock& block) {
+    if (file_ == nullptr) {
+        return false;
+    }
+    SeasonBlockRecord record{};
+    record.first_game = header_.game_count;
+    record.game_count = static_cast<std::uint32_t>(block.games.size());
+    record.first_visitor = static_cast<std::uint32_t>(visitors_.size());
+    record.host_team = block.host_team;
+    record.start_date = block.start_date.dayNumber();
+    record.end_date = block.end_date.dayNumber();
+    record.visitor_count = static_cast<std::uint8_t>(block.visiting_residents.size());
+    record.is_apex_residency = block.is_apex_residency ? 1 : 0;
+
+    if (!writeBytes(block.games.data(), block.games.size() * sizeof(Game))) {
+        return false;
+    }
+    header_.game_count += block.games.size();
+    visitors_.insert(visitors_.end(), block.visiting_residents.begin(), block.visiting_residents.end());
+    blocks_.push_back(record);
+    return true;
+}
+
+bool SeasonFileWriter::finish() {
+    if (file_ == nullptr) {
+        return false;
+    }
+    bool ok = padTo8();
+    header_.blocks_offset = position_;
+    header_.block_count = static_cast<std::uint32_t>(blocks_.size());
+    ok = ok && writeBytes(blocks_.data(), blocks_.size() * sizeof(SeasonBlockRecord)) && padTo8();
+    header_.visitors_offset = position_;
+    header_.visitor_count = visitors_.size();
+    ok = ok && writeBytes(visitors_.data(), visitors_.size() * sizeof(TeamId));
+
+    // The header goes last so a truncated file never carries a valid one.
+    ok = ok && std::fseek(file_, 0, SEEK_SET) == 0 && std::fwrite(&header_, sizeof(header_), 1, file_) == 1;
+    if (std::fclose(file_) != 0) {
+        ok = false;
+    }
+    file_ = nullptr;
+    if (!ok) {
+        std::cerr << "Error: failed to finish season file " << path_ << std::endl;
+    }
+    return ok;
+}
+
+bool SeasonFileWriter::write(const std::string& path, const TeamRegistry& teams,
+                             const SeasonSchedule& schedule, const SeasonFileInfo& info) {
+    SeasonFileWriter writer;
+    if (!writer.open(path, teams, info)) {
+        return false;
+    }
+    for (const ResidencyBlock& block : schedule) {
+        if (!writer.append(block)) {
+            return false;
+        }
+    }
+    return writer.finish();
+}
+
+// ---------------------------------------------------------------- reader
+
+ResidencyBlock SeasonBlockView::toResidencyBlock() const {
+    ResidencyBlock block;
+    block.host_team = hostTeam();
+    const ArrayView<TeamId> visitors = visitingResidents();
+    block.visiting_residents.assign(visitors.begin(), visitors.end());
+    const ArrayView<Game> block_games = games();
+    block.games.assign(block_games.begin(), block_games.end());
+    block.start_date = startDate();
+    block.end_date = endDate();
+    block.is_apex_residency = isApexResidency();
+    return block;
+}
+
+bool SeasonFileReader::open(const std::string& path) {
+    close();
+    if (!file_.open(path)) {
+        return false;
+    }
+    const unsigned char* base = file_.data();
+    const std::uint64_t size = file_.size();
+    auto fail = [&](const char* what) {
+        std::cerr << "Error: " << path << " is not a usable season file (" << what << ")" << std::endl;
+        close();
+        return false;
+    };
+
+    if (size < sizeof(SeasonFileHeader)) {
+        return fail("truncated header");
+    }
+    const auto* header = reinterpret_cast<const SeasonFileHeader*>(base);
+    if (std::memcmp(header->magic, kSeasonFileMagic, sizeof(header->magic)) != 0) {
+        return fail("bad magic");
+    }
+    if (header->byte_order != kSeasonFileByteOrder) {
+        return fail("foreign byte order");
+    }
+    if (header->version != kSeasonFileVersion) {
+        return fail("unsupported version");
+    }
+    if (!sectionFits(header->teams_offset, header->team_count, sizeof(SeasonTeamRecord), alignof(SeasonTeamRecord), size) ||
+        !sectionFits(header->strings_offset, header->strings_size, 1, 1, size) ||
+        !sectionFits(header->games_offset, header->game_count, sizeof(Game), alignof(Game), size) ||
+        !sectionFits(header->blocks_offset, header->block_count, sizeof(SeasonBlockRecord), alignof(SeasonBlockRecord), size) ||
+        !sectionFits(header->visitors_offset, header->visitor_count, sizeof(TeamId), alignof(TeamId), size)) {
+        return fail("section out of bounds");
+    }
+
+    teams_ = reinterpret_cast<const SeasonTeamRecord*>(base + header->teams_offset);
+    strings_ = reinterpret_cast<const char*>(base + header->strings_offset);
+    games_ = reinterpret_cast<const Game*>(base + header->games_offset);
+    blocks_ = reinterpret_cast<const SeasonBlockRecord*>(base + header->blocks_offset);
+    visitors_ = reinterpret_cast<const TeamId*>(base + header->visitors_offset);
+
+    // Validate every reference a view (or a caller indexing by TeamId) can follow.
+    for (std::uint32_t i = 0; i < header->team_count; ++i) {
+        const SeasonTeamRecord& team = teams_[i];
+        if (std::uint64_t(team.city_offset) + team.city_length > header->strings_size ||
+            std::uint64_t(team.mascot_offset) + team.mascot_length > header->strings_size) {
+            return fail("team name out of bounds");
+        }
+    }
+    for (std::uint32_t i = 0; i < header->block_count; ++i) {
+        const SeasonBlockRecord& block = blocks_[i];
+        if (block.host_team >= header->team_count ||
+            block.first_game > header->game_count || block.game_count > header->game_count - block.first_game ||
+            std::uint64_t(block.first_visitor) + block.visitor_count > header->visitor_count) {
+            return fail("block reference out of bounds");
+        }
+    }
+    for (std::uint64_t i = 0; i < header->visitor_count; ++i) {
+        if (visitors_[i] >= header->team_count) {
+            return fail("visitor team out of bounds");
+        }
+    }
+    for (std::uint64_t i = 0; i < header->game_count; ++i) {
+        const Game& game = games_[i];
+        if (game.team1 >= header->team_count || game.team2 >= header->team_count ||
+            game.designated_home_team_for_batting >= header->team_count ||
+            game.actual_host_stadium >= header->team_count) {
+            return fail("game team out of bounds");
+        }
+    }
+
+    header_ = header;
+    return true;
+}
+
+void SeasonFileReader::close() {
+    file_.close();
+    header_ = nullptr;
+    teams_ = nullptr;
+    strings_ = nullptr;
+    games_ = nullptr;
+    blocks_ = nullptr;
+    visitors_ = nullptr;
+}
+
+SeasonSchedule SeasonFileReader::toSchedule(std::pmr::memory_resource* resource) const {
+    SeasonSchedule schedule(resource);
+    schedule.reserve(blockCount());
+    for (SeasonBlockView block : *this) {
+        schedule.push_back(block.toResidencyBlock());
+    }
+    return schedule;
+}
+
+} // namespace LeagueSchedulerNS
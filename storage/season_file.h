@@ -0,0 +1,256 @@
+#ifndef SEASON_FILE_H
+#define SEASON_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "../money_and_players/calendar.h"
+#include "../money_and_players/game_data.h"
+#include "../money_and_players/team_registry.h"
+#include "mapped_file.h"
+
+namespace LeagueSchedulerNS {
+
+// Binary season archive (".apmwseason").
+//
+// Fixed-layout, versioned, native byte order. Every section is a flat array
+// starting on an 8-byte boundary, located through offsets in the header:
+//
+//   SeasonFileHeader
+//   SeasonTeamRecord[team_count]
+//   char strings[strings_size]        team cities and mascot themes (not NUL-terminated)
+//   Game games[game_count]            the in-memory Game layout, pinned below
+//   SeasonBlockRecord[block_count]    each refers to a range of games and visitors
+//   TeamId visitors[visitor_count]
+//
+// Games are written in block order, so a block's games are contiguous. The
+// reader maps the file and hands out views straight into the mapping, with no
+// copy or allocation. Opening validates the header, the block table and every
+// TeamId in the visitor and game arrays (so callers can index per-team arrays
+// by them). That is one sequential O(games) pass that reads every page of the
+// mapping once; nothing is deserialized.
+constexpr char kSeasonFileMagic[8] = {'A', 'P', 'M', 'W', 'S', 'S', 'N', '\0'};
+constexpr std::uint32_t kSeasonFileVersion = 1;
+constexpr std::uint32_t kSeasonFileByteOrder = 0x01020304u; // Reads back swapped on a foreign-endian host
+
+struct SeasonFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint64_t seed;
+    std::int32_t season_index;
+    std::uint16_t season_start;   // CalendarDate day number
+    std::uint16_t reserved;
+    std::uint32_t team_count;
+    std::uint32_t block_count;
+    std::uint64_t game_count;
+    std::uint64_t visitor_count;
+    std::uint64_t strings_size;
+    std::uint64_t teams_offset;
+    std::uint64_t strings_offset;
+    std::uint64_t games_offset;
+    std::uint64_t blocks_offset;
+    std::uint64_t visitors_offset;
+};
+
+struct SeasonTeamRecord {
+    std::int32_t team_number;      // Team::id
+    std::uint32_t city_offset;     // Into the strings section
+    std::uint32_t mascot_offset;
+    std::uint16_t city_length;
+    std::uint16_t mascot_length;
+    std::uint8_t union_type;
+    std::uint8_t region_type;
+    std::uint16_t reserved;
+};
+
+struct SeasonBlockRecord {
+    std::uint64_t first_game;
+    std::uint32_t game_count;
+    std::uint32_t first_visitor;
+    TeamId host_team;
+    std::uint16_t start_date;      // CalendarDate day numbers
+    std::uint16_t end_date;
+    std::uint8_t visitor_count;
+    std::uint8_t is_apex_residency;
+};
+
+static_assert(sizeof(SeasonFileHeader) == 104, "SeasonFileHeader layout changed; bump kSeasonFileVersion");
+static_assert(sizeof(SeasonTeamRecord) == 20, "SeasonTeamRecord layout changed; bump kSeasonFileVersion");
+static_assert(sizeof(SeasonBlockRecord) == 24, "SeasonBlockRecord layout changed; bump kSeasonFileVersion");
+// Games are stored exactly as they sit in memory so the reader can hand out
+// `const Game&` into the mapping.
+static_assert(std::is_trivially_copyable<Game>::value && std::is_standard_layout<Game>::value,
+              "Game must stay a plain record to be mapped from disk");
+static_assert(sizeof(Game) == 12 && alignof(Game) == 2, "Game layout changed; bump kSeasonFileVersion");
+
+// Read-only contiguous range (a minimal span).
+template <typename T>
+class ArrayView {
+public:
+    ArrayView() = default;
+    ArrayView(const T* data, std::size_t size) : data_(data), size_(size) {}
+
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + size_; }
+    const T* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    const T& operator[](std::size_t i) const { return data_[i]; }
+
+private:
+    const T* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+// Season metadata stored in the header.
+struct SeasonFileInfo {
+    std::uint64_t seed = 0;
+    int season_index = 0;
+    CalendarDate season_start;
+};
+
+// Writes a season archive. Games go to disk as each block is appended; only
+// the small block and visitor tables are held until finish(), so a season can
+// be streamed out without materializing it.
+//
+//   SeasonFileWriter writer;
+//   if (writer.open(path, registry, info)) {
+//       for (const ResidencyBlock& block : schedule) writer.append(block);
+//       writer.finish();
+//   }
+class SeasonFileWriter {
+public:
+    SeasonFileWriter() = default;
+    ~SeasonFileWriter();
+
+    SeasonFileWriter(const SeasonFileWriter&) = delete;
+    SeasonFileWriter& operator=(const SeasonFileWriter&) = delete;
+
+    // Creates `path` and writes the team table. Returns false (and reports to
+    // std::cerr) if the file cannot be created.
+    bool open(const std::string& path, const TeamRegistry& teams, const SeasonFileInfo& info);
+    bool append(const ResidencyBlock& block);
+    // Writes the block table and the final header, then closes the file.
+    bool finish();
+
+    bool isOpen() const { return file_ != nullptr; }
+
+    // One-shot convenience over open/append/finish.
+    static bool write(const std::string& path, const TeamRegistry& teams,
+                      const SeasonSchedule& schedule, const SeasonFileInfo& info);
+
+private:
+    bool writeBytes(const void* data, std::size_t size);
+    bool padTo8();
+
+    std::FILE* file_ = nullptr;
+    std::string path_;
+    std::uint64_t position_ = 0;
+    SeasonFileHeader header_{};
+    std::vector<SeasonBlockRecord> blocks_;
+    std::vector<TeamId> visitors_;
+};
+
+class SeasonFileReader;
+
+// A team as stored in the archive.
+class SeasonTeamView {
+public:
+    SeasonTeamView(const SeasonTeamRecord* record, const char* strings) : record_(record), strings_(strings) {}
+
+    int teamNumber() const { return record_->team_number; }
+    std::string_view city() const { return {strings_ + record_->city_offset, record_->city_length}; }
+    std::string_view mascotTheme() const { return {strings_ + record_->mascot_offset, record_->mascot_length}; }
+    UnionType unionType() const { return static_cast<UnionType>(record_->union_type); }
+    RegionType regionType() const { return static_cast<RegionType>(record_->region_type); }
+
+private:
+    const SeasonTeamRecord* record_;
+    const char* strings_;
+};
+
+// A residency block as stored in the archive; games and visitors point into the mapping.
+class SeasonBlockView {
+public:
+    SeasonBlockView(const SeasonBlockRecord* record, const Game* games, const TeamId* visitors)
+        : record_(record), games_(games), visitors_(visitors) {}
+
+    TeamId hostTeam() const { return record_->host_team; }
+    ArrayView<TeamId> visitingResidents() const {
+        return {visitors_ + record_->first_visitor, record_->visitor_count};
+    }
+    ArrayView<Game> games() const { return {games_ + record_->first_game, record_->game_count}; }
+    CalendarDate startDate() const { return CalendarDate(record_->start_date); }
+    CalendarDate endDate() const { return CalendarDate(record_->end_date); }
+    bool isApexResidency() const { return record_->is_apex_residency != 0; }
+
+    // Copies the block out of the mapping.
+    ResidencyBlock toResidencyBlock() const;
+
+private:
+    const SeasonBlockRecord* record_;
+    const Game* games_;
+    const TeamId* visitors_;
+};
+
+// Maps a season archive and exposes it without deserializing.
+// Views stay valid until the reader is closed or destroyed.
+class SeasonFileReader {
+public:
+    // Maps and validates `path`. Returns false (and reports to std::cerr) if
+    // the file is missing, truncated, from another format version or byte
+    // order, or has block, visitor or game team ids out of range. O(games):
+    // the team ids of every game are checked.
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return header_ != nullptr; }
+
+    std::uint64_t seed() const { return header_->seed; }
+    int seasonIndex() const { return header_->season_index; }
+    CalendarDate seasonStart() const { return CalendarDate(header_->season_start); }
+
+    std::size_t teamCount() const { return header_->team_count; }
+    std::size_t blockCount() const { return header_->block_count; }
+    std::size_t gameCount() const { return static_cast<std::size_t>(header_->game_count); }
+
+    SeasonTeamView team(TeamId id) const { return {teams_ + id, strings_}; }
+    SeasonBlockView block(std::size_t index) const { return {blocks_ + index, games_, visitors_}; }
+    // Every game of the season, in block order.
+    ArrayView<Game> games() const { return {games_, gameCount()}; }
+
+    class BlockIterator {
+    public:
+        BlockIterator(const SeasonFileReader* reader, std::size_t index) : reader_(reader), index_(index) {}
+        SeasonBlockView operator*() const { return reader_->block(index_); }
+        BlockIterator& operator++() { ++index_; return *this; }
+        bool operator!=(const BlockIterator& other) const { return index_ != other.index_; }
+        bool operator==(const BlockIterator& other) const { return index_ == other.index_; }
+
+    private:
+        const SeasonFileReader* reader_;
+        std::size_t index_;
+    };
+    BlockIterator begin() const { return {this, 0}; }
+    BlockIterator end() const { return {this, blockCount()}; }
+
+    // Copies the whole season out of the mapping, allocating from `resource`.
+    SeasonSchedule toSchedule(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
+
+private:
+    MappedFile file_;
+    const SeasonFileHeader* header_ = nullptr;
+    const SeasonTeamRecord* teams_ = nullptr;
+    const char* strings_ = nullptr;
+    const Game* games_ = nullptr;
+    const SeasonBlockRecord* blocks_ = nullptr;
+    const TeamId* visitors_ = nullptr;
+};
+
+} // namespace LeagueSchedulerNS
+
+#endif // SEASON_FILE_H